@@ -0,0 +1,27 @@
+#pragma once
+#include <chrono>
+
+// Timing shared by the benchmarks.
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+inline double secondsSince(Clock::time_point t0) { return std::chrono::duration<double>(Clock::now() - t0).count(); }
+inline double msSince(Clock::time_point t0) { return secondsSince(t0) * 1e3; }
+inline double usSince(Clock::time_point t0) { return secondsSince(t0) * 1e6; }
+
+// Mean milliseconds per call of body() over reps calls, after one untimed warm-up call.
+template <typename F>
+double timeMs(int reps, F&& body) {
+    body();
+    auto t0 = Clock::now();
+    for (int r = 0; r < reps; ++r) body();
+    return msSince(t0) / reps;
+}
+
+template <typename F>
+double timeUs(int reps, F&& body) {
+    return timeMs(reps, body) * 1e3;
+}
+
+} // namespace bench
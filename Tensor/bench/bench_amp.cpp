@@ -0,0 +1,71 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/amp/MixedPrecisionSGD.hpp"
+#include "../include/utils/MemoryTracker.hpp"
+#include "BenchUtil.hpp"
+
+// Training-step memory and throughput of a tanh MLP (MSE loss) in float64, bfloat16 and float16.
+// 16-bit runs keep float64 master weights in MixedPrecisionSGD; float16 uses dynamic loss scaling.
+//   bench_amp [batch] [in] [hidden] [out] [steps]
+
+int main(int argc, char** argv) {
+    int batch = argc > 1 ? std::atoi(argv[1]) : 256;
+    int in = argc > 2 ? std::atoi(argv[2]) : 256;
+    int hidden = argc > 3 ? std::atoi(argv[3]) : 512;
+    int outd = argc > 4 ? std::atoi(argv[4]) : 16;
+    int steps = argc > 5 ? std::atoi(argv[5]) : 20;
+
+    Tensor X = Tensor::randn({batch, in});
+    Tensor Y = ops::tanh(ops::matmul(X, Tensor::randn({in, outd}, 0.0, 0.1)));
+    Tensor W1_init = Tensor::randn({in, hidden}, 0.0, 0.05);
+    Tensor W2_init = Tensor::randn({hidden, hidden}, 0.0, 0.05);
+    Tensor W3_init = Tensor::randn({hidden, outd}, 0.0, 0.05);
+
+    std::cout << "MLP " << in << "-" << hidden << "-" << hidden << "-" << outd << ", batch " << batch << ", "
+              << steps << " SGD steps\n";
+    std::cout << std::left << std::setw(10) << "dtype" << std::right << std::setw(12) << "ms/step" << std::setw(14)
+              << "act data KiB" << std::setw(14) << "act grad KiB" << std::setw(12) << "first loss" << std::setw(12)
+              << "last loss" << std::setw(10) << "skipped" << "\n";
+
+    for (DType d : {DType::Float64, DType::BFloat16, DType::Float16}) {
+        std::vector<Tensor> masters = {W1_init.reshape(W1_init.getShape()), W2_init.reshape(W2_init.getShape()),
+                                       W3_init.reshape(W3_init.getShape())};
+        amp::MixedPrecisionSGD opt(masters, d, 0.05);
+        const auto& p = opt.params();
+        Tensor x = X.to(d);
+
+        double first = 0.0, last = 0.0, total_ms = 0.0;
+        size_t peak_data = 0, peak_grad = 0;
+        for (int s = 0; s < steps; ++s) {
+            memory::Stats base = memory::stats();
+            memory::resetPeak();
+            auto t0 = bench::Clock::now();
+
+            Tensor h1 = ops::tanh(ops::matmul(x, p[0]));
+            Tensor h2 = ops::tanh(ops::matmul(h1, p[1]));
+            Tensor logits = ops::matmul(h2, p[2]).to(DType::Float64);
+            Tensor diff = logits - Y;
+            Tensor loss = ops::mean(diff * diff);
+            memory::Stats fwd = memory::stats();
+            opt.backward(loss);
+            opt.step();
+
+            total_ms += bench::msSince(t0);
+            peak_data = std::max(peak_data, fwd.live[memory::Data] - base.live[memory::Data]);
+            peak_grad = std::max(peak_grad, fwd.live[memory::Grad] - base.live[memory::Grad]);
+            if (s == 0) first = loss.at({0});
+            last = loss.at({0});
+        }
+        std::cout << std::left << std::setw(10) << dtypeName(d) << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << total_ms / steps << std::setw(14) << peak_data / 1024 << std::setw(14)
+                  << peak_grad / 1024 << std::setprecision(5) << std::setw(12) << first << std::setw(12) << last
+                  << std::setw(10) << opt.gradScaler().skippedSteps() << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+    std::cout << "act = tensors created by the forward pass (activations kept for backward); grads are float64.\n";
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <atomic>
+#include <future>
+#include <new>
+#include <thread>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/utils/Arena.hpp"
+#include "BenchUtil.hpp"
+
+// Heap allocations per training step of a small tanh MLP, with graph bookkeeping
+// (parents, backward closures, backward() scratch) in the arena vs on the heap.
+// Then graphs recorded on short-lived threads are freed by another thread while their
+// recording thread exits (build with -fsanitize=address or thread to check the handoff).
+//   bench_arena [steps] [batch] [hidden]
+
+static std::atomic<size_t> g_allocs{0};
+
+void* operator new(size_t n) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    int steps = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int batch = argc > 2 ? std::atoi(argv[2]) : 8;
+    int hidden = argc > 3 ? std::atoi(argv[3]) : 16;
+
+    Tensor X = Tensor::randn({batch, 4});
+    Tensor Y = Tensor::randn({batch, 1});
+    Tensor W1 = Tensor::randn({4, hidden}, 0.0, 0.5, true);
+    Tensor W2 = Tensor::randn({hidden, 1}, 0.0, 0.5, true);
+
+    auto step = [&] {
+        Tensor h = ops::tanh(ops::matmul(X, W1));
+        Tensor d = ops::matmul(h, W2) - Y;
+        Tensor loss = ops::mean(d * d) + ops::sum(W1 * W1) * 1e-4;
+        loss.backward();
+        for (Tensor* w : {&W1, &W2}) {
+            auto& v = w->getMutableData();
+            const auto& g = w->getGrad();
+            for (size_t i = 0; i < v.size(); ++i) v[i] -= 0.05 * g[i];
+            w->zero_grad();
+        }
+        return loss.at({0});
+    };
+
+    std::cout << "MLP 4-" << hidden << "-1, batch " << batch << ", " << steps << " SGD steps\n";
+    std::cout << std::left << std::setw(10) << "graph" << std::right << std::setw(14) << "heap/step"
+              << std::setw(18) << "bookkeeping/step" << std::setw(16) << "of which heap" << std::setw(12)
+              << "us/step" << std::setw(10) << "chunks" << "\n";
+
+    for (bool use_arena : {false, true}) {
+        arena::setEnabled(use_arena);
+        for (int i = 0; i < 10; ++i) step();  // warm-up: chunks and vectors reach steady-state size
+
+        arena::Stats a0 = arena::stats();
+        size_t h0 = g_allocs.load();
+        auto t0 = bench::Clock::now();
+        for (int i = 0; i < steps; ++i) step();
+        double us = bench::usSince(t0) / steps;
+        arena::Stats a1 = arena::stats();
+
+        std::cout << std::left << std::setw(10) << (use_arena ? "arena" : "heap") << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(14) << static_cast<double>(g_allocs.load() - h0) / steps
+                  << std::setw(18) << static_cast<double>(a1.allocations - a0.allocations) / steps
+                  << std::setw(16) << static_cast<double>(a1.heap_allocations - a0.heap_allocations) / steps
+                  << std::setw(12) << us << std::setw(10) << a1.chunks << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+    std::cout << "heap/step counts every operator new; with the arena only tensor storage remains\n"
+                 "(one block per TensorImpl with its control block, plus the data and grad buffers).\n";
+
+    const int rounds = 200;
+    auto t0 = bench::Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        std::promise<std::vector<Tensor>> handoff;
+        std::thread owner([&] {
+            std::vector<Tensor> graphs;
+            for (int i = 0; i < 8; ++i) graphs.push_back(ops::sum(ops::tanh(ops::matmul(X, W1))));
+            handoff.set_value(std::move(graphs));
+        });
+        std::thread consumer([&] { handoff.get_future().get().clear(); });
+        owner.join();
+        consumer.join();
+    }
+    std::cout << "handoff: " << rounds << " threads exited while another thread freed their graphs ("
+              << std::fixed << std::setprecision(1) << bench::usSince(t0) / rounds << " us/round)\n";
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/utils/MemoryTracker.hpp"
+#include "BenchUtil.hpp"
+
+// Single-head attention, d = 64: ops::scaled_dot_product_attention vs
+// matmul(softmax(matmul(q, transpose(k)) / sqrt(d)), v). Time for forward and
+// forward + backward, and peak tensor bytes during forward + backward. The unfused
+// version is skipped above `max_unfused` (its L x L score matrices no longer fit).
+//   bench_attention [max_unfused] [lengths...]
+
+// Mean time over reps; peak tensor bytes above what was live before.
+template <typename F>
+double timePeakMs(int reps, F&& body, size_t* peak) {
+    size_t base = memory::stats().live_total;
+    memory::resetPeak();
+    double ms = bench::timeMs(reps, body);
+    *peak = memory::stats().peak_total - base;
+    return ms;
+}
+
+int main(int argc, char** argv) {
+    int max_unfused = argc > 1 ? std::atoi(argv[1]) : 2048;
+    std::vector<int> lengths;
+    for (int i = 2; i < argc; ++i) lengths.push_back(std::atoi(argv[i]));
+    if (lengths.empty()) lengths = {256, 1024, 2048, 4096, 16384};
+    const int d = 64;
+
+    std::cout << "attention, 1 head, d = " << d << "; times in ms, memory in MiB\n";
+    std::cout << std::setw(8) << "L" << std::setw(12) << "fused fwd" << std::setw(12) << "fused f+b" << std::setw(12)
+              << "fused MiB" << std::setw(12) << "split fwd" << std::setw(12) << "split f+b" << std::setw(12)
+              << "split MiB" << "\n";
+
+    for (int L : lengths) {
+        Tensor q = Tensor::randn({L, d}, 0.0, 1.0, true);
+        Tensor k = Tensor::randn({L, d}, 0.0, 1.0, true);
+        Tensor v = Tensor::randn({L, d}, 0.0, 1.0, true);
+        int reps = L <= 1024 ? 5 : 1;
+        auto fused = [&] { return ops::scaled_dot_product_attention(q, k, v); };
+        auto split = [&] { return ops::matmul(ops::softmax(ops::matmul(q, ops::transpose(k)) * 0.125), v); };
+        auto mib = [](size_t b) { return static_cast<double>(b) / (1024.0 * 1024.0); };
+
+        size_t peak = 0;
+        std::cout << std::setw(8) << L << std::fixed << std::setprecision(1);
+        std::cout << std::setw(12) << bench::timeMs(reps, [&] { fused(); });
+        std::cout << std::setw(12) << timePeakMs(reps, [&] { ops::sum(fused()).backward(); }, &peak) << std::setw(12)
+                  << mib(peak) << std::flush;
+        if (L <= max_unfused) {
+            std::cout << std::setw(12) << bench::timeMs(reps, [&] { split(); });
+            std::cout << std::setw(12) << timePeakMs(reps, [&] { ops::sum(split()).backward(); }, &peak) << std::setw(12)
+                      << mib(peak);
+        } else {
+            std::cout << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(12) << "-";
+        }
+        std::cout << "\n";
+        std::cout.unsetf(std::ios::fixed);
+        q.zero_grad(); k.zero_grad(); v.zero_grad();
+    }
+    std::cout << "MiB = peak tensor bytes (data, grad, graph) above the inputs; the fused kernel's\n"
+                 "own scratch is one 64 x 64 score tile per thread plus one double per query row.\n";
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/autograd/Checkpoint.hpp"
+#include "../include/utils/MemoryTracker.hpp"
+#include "BenchUtil.hpp"
+
+// Peak memory vs step time of a deep tanh MLP with autograd::checkpoint over
+// segments of k layers (k = 0: no checkpointing).
+//   bench_checkpoint [layers] [width] [batch] [reps]
+
+int main(int argc, char** argv) {
+    int layers = argc > 1 ? std::atoi(argv[1]) : 50;
+    int width = argc > 2 ? std::atoi(argv[2]) : 256;
+    int batch = argc > 3 ? std::atoi(argv[3]) : 64;
+    int reps = argc > 4 ? std::atoi(argv[4]) : 3;
+
+    Tensor X = Tensor::randn({batch, width});
+    std::vector<Tensor> W;
+    for (int l = 0; l < layers; ++l) W.push_back(Tensor::randn({width, width}, 0.0, 1.0 / std::sqrt(width), true));
+
+    std::cout << layers << "-layer tanh MLP, width " << width << ", batch " << batch << "\n";
+    std::cout << std::left << std::setw(14) << "segment" << std::right << std::setw(16) << "peak MiB"
+              << std::setw(14) << "ms/step" << std::setw(14) << "loss" << "\n";
+
+    double base_ms = 0.0;
+    for (int seg : {0, 1, 2, 5, 7, 10, 25}) {
+        double ms = 0.0, loss_val = 0.0;
+        size_t peak = 0;
+        for (int r = 0; r < reps; ++r) {
+            for (auto& w : W) w.zero_grad();
+            size_t live_before = memory::stats().live_total;
+            memory::resetPeak();
+            auto t0 = bench::Clock::now();
+
+            Tensor h = X;
+            for (int l = 0; l < layers;) {
+                int end = seg > 0 ? std::min(layers, l + seg) : layers;
+                if (seg > 0) {
+                    std::vector<Tensor> in = {h};
+                    in.insert(in.end(), W.begin() + l, W.begin() + end);
+                    h = autograd::checkpoint([](const std::vector<Tensor>& in) {
+                        Tensor y = in[0];
+                        for (size_t i = 1; i < in.size(); ++i) y = ops::tanh(ops::matmul(y, in[i]));
+                        return y;
+                    }, in);
+                } else {
+                    for (int i = l; i < end; ++i) h = ops::tanh(ops::matmul(h, W[i]));
+                }
+                l = end;
+            }
+            Tensor loss = ops::mean(h * h);
+            loss.backward();
+
+            ms += bench::msSince(t0);
+            peak = std::max(peak, memory::stats().peak_total - live_before);
+            loss_val = loss.at({0});
+        }
+        ms /= reps;
+        if (seg == 0) base_ms = ms;
+        std::cout << std::left << std::setw(14) << (seg == 0 ? std::string("none") : "every " + std::to_string(seg))
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(16) << peak / (1024.0 * 1024.0)
+                  << std::setw(14) << ms << std::setprecision(6) << std::setw(14) << loss_val;
+        if (seg > 0) std::cout << "   (" << std::setprecision(2) << ms / base_ms << "x time)";
+        std::cout << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+    return 0;
+}
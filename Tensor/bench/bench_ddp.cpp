@@ -0,0 +1,117 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/dist/DataParallel.hpp"
+#include "../include/utils/Random.hpp"
+#include "BenchUtil.hpp"
+
+// Strong scaling of data-parallel training on one host: a fixed global batch is split over
+// 1, 2, 4, ... up to max_procs processes (this executable re-launched per rank), gradients
+// are averaged with dist::DataParallel. Reports time per step, the time of a bare all-reduce
+// of all gradients, and how far rank 0's final weights are from the single-process run.
+//   bench_ddp [max_procs [global_batch [hidden [steps]]]]
+
+using bench::Clock;
+
+struct Result {
+    double step_ms;
+    double allreduce_ms;
+    std::vector<double> weights;
+};
+
+Result run(int global_batch, int hidden, int steps) {
+    dist::ProcessGroup group(dist::launchInfo());
+    int rank = group.rank(), world = group.size();
+    const int in = 256, out = 64;
+    if (global_batch % world != 0) throw std::invalid_argument("global_batch must divide by the process count");
+    int local = global_batch / world;
+
+    rng::Generator init(1);
+    Tensor W1 = Tensor::normal({in, hidden}, 0.0, 0.05, true, &init), b1 = Tensor::zeros({1, hidden}, true);
+    Tensor W2 = Tensor::normal({hidden, out}, 0.0, 0.05, true, &init), b2 = Tensor::zeros({1, out}, true);
+    std::vector<Tensor> params = {W1, b1, W2, b2};
+    dist::DataParallel ddp(group, params);
+
+    auto step = [&](int s) {
+        // Every rank draws the same global batch and keeps its rows.
+        rng::Generator data(100 + s);
+        Tensor x = Tensor::normal({global_batch, in}, 0.0, 1.0, false, &data);
+        Tensor y = Tensor::normal({global_batch, out}, 0.0, 1.0, false, &data);
+        Tensor xs({local, in}), ys({local, out});
+        std::copy_n(x.getData().begin() + static_cast<size_t>(rank) * local * in, local * in, xs.getMutableData().begin());
+        std::copy_n(y.getData().begin() + static_cast<size_t>(rank) * local * out, local * out, ys.getMutableData().begin());
+
+        Tensor h = ops::linear(xs, W1, b1, ops::Activation::Tanh);
+        Tensor d = ops::linear(h, W2, b2) - ys;
+        ddp.backward(ops::mean(d * d));
+        for (Tensor& p : params) {
+            auto& w = p.getMutableData();
+            const auto& g = p.getGrad();
+            for (size_t i = 0; i < w.size(); ++i) w[i] -= 0.05 * g[i];
+            p.zero_grad();
+        }
+    };
+
+    step(0);
+    group.barrier();
+    auto t0 = Clock::now();
+    for (int s = 1; s <= steps; ++s) step(s);
+    group.barrier();
+    Result r;
+    r.step_ms = bench::msSince(t0) / steps;
+
+    size_t total = 0;
+    for (const Tensor& p : params) total += p.getData().size();
+    std::vector<double> buf(total, 1.0);
+    group.barrier();
+    t0 = Clock::now();
+    for (int k = 0; k < 5; ++k) group.allReduce(buf.data(), buf.size());
+    r.allreduce_ms = bench::msSince(t0) / 5;
+
+    for (const Tensor& p : params) r.weights.insert(r.weights.end(), p.getData().begin(), p.getData().end());
+    return r;
+}
+
+int main(int argc, char** argv) {
+    int max_procs = argc > 1 ? std::atoi(argv[1]) : 4;
+    int global_batch = argc > 2 ? std::atoi(argv[2]) : 512;
+    int hidden = argc > 3 ? std::atoi(argv[3]) : 512;
+    int steps = argc > 4 ? std::atoi(argv[4]) : 10;
+
+    dist::LaunchInfo info = dist::launchInfo();
+    if (info.rank != 0) {
+        run(global_batch, hidden, steps);
+        return 0;
+    }
+
+    std::cout << "global batch " << global_batch << ", hidden " << hidden << ", " << steps << " steps\n";
+    std::cout << std::setw(6) << "procs" << std::setw(12) << "ms/step" << std::setw(12) << "samples/s" << std::setw(10)
+              << "speedup" << std::setw(16) << "allreduce ms" << std::setw(14) << "max |dW|" << "\n";
+    std::vector<double> reference;
+    double base_ms = 0.0;
+    for (int world = 1; world <= max_procs; world *= 2) {
+        std::vector<int> workers = world > 1 ? dist::spawnWorkers(world, argv) : std::vector<int>();
+        Result r = run(global_batch, hidden, steps);
+        if (!dist::waitWorkers(workers)) {
+            std::cerr << "a worker failed\n";
+            return 1;
+        }
+        if (world == 1) {
+            reference = r.weights;
+            base_ms = r.step_ms;
+        }
+        double diff = 0.0;
+        for (size_t i = 0; i < reference.size(); ++i) diff = std::max(diff, std::abs(reference[i] - r.weights[i]));
+        std::cout << std::setw(6) << world << std::fixed << std::setprecision(2) << std::setw(12) << r.step_ms
+                  << std::setw(12) << global_batch * 1000.0 / r.step_ms << std::setw(9) << base_ms / r.step_ms << "x"
+                  << std::setw(16) << r.allreduce_ms << std::scientific << std::setprecision(1) << std::setw(14) << diff
+                  << "\n";
+        std::cout.unsetf(std::ios::fixed | std::ios::scientific);
+    }
+    return 0;
+}
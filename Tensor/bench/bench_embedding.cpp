@@ -0,0 +1,88 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "BenchUtil.hpp"
+
+// One SGD step on an embedding table (forward, backward, update, clear) three ways:
+// one-hot x matmul with a dense table grad, ops::embedding with a dense table grad,
+// and ops::embedding with an ops::RowSparseGrad applied row-wise. Also reports the bytes
+// held by the table gradient. One-hot is skipped once the [tokens, vocab] matrix is large.
+//   bench_embedding [vocab dim tokens]...
+
+// table -= lr * table.grad over the whole table, then zero the grad.
+void denseStep(Tensor& table, double lr) {
+    auto& w = table.getMutableData();
+    const auto& g = table.getGrad();
+    for (size_t i = 0; i < w.size(); ++i) w[i] -= lr * g[i];
+    table.zero_grad();
+}
+
+int main(int argc, char** argv) {
+    struct Shape { int vocab, dim, tokens; };
+    std::vector<Shape> shapes;
+    for (int i = 1; i + 2 < argc; i += 3) shapes.push_back({std::atoi(argv[i]), std::atoi(argv[i + 1]), std::atoi(argv[i + 2])});
+    if (shapes.empty()) shapes = {{10000, 64, 1024}, {100000, 64, 4096}, {1000000, 32, 4096}};
+
+    std::cout << std::left << std::setw(22) << "vocab x dim, tokens" << std::right << std::setw(12) << "one-hot us"
+              << std::setw(12) << "dense us" << std::setw(12) << "sparse us" << std::setw(16) << "dense grad B"
+              << std::setw(16) << "sparse grad B" << "\n";
+
+    std::mt19937 rng(0);
+    for (auto [V, D, n] : shapes) {
+        std::uniform_int_distribution<int> pick(0, V - 1);
+        std::vector<int> ids(n);
+        for (int& i : ids) i = pick(rng);
+        Tensor target = Tensor::randn({n, D});
+        const double lr = 1e-3;
+        int reps = std::max(3, 50000000 / (V * D + n * D * 20));
+
+        double onehot_us = -1.0;
+        if (static_cast<long long>(n) * V <= 20000000LL) {
+            Tensor table = Tensor::randn({V, D}, 0.0, 1.0, true);
+            Tensor onehot({n, V});
+            for (int i = 0; i < n; ++i) onehot.getMutableData()[static_cast<size_t>(i) * V + ids[i]] = 1.0;
+            onehot_us = bench::timeUs(reps, [&] {
+                ops::sum(ops::matmul(onehot, table) * target).backward();
+                denseStep(table, lr);
+            });
+        }
+
+        double dense_us, sparse_us;
+        size_t dense_bytes, sparse_bytes = 0;
+        {
+            Tensor table = Tensor::randn({V, D}, 0.0, 1.0, true);
+            dense_us = bench::timeUs(reps, [&] {
+                ops::sum(ops::embedding(table, ids) * target).backward();
+                denseStep(table, lr);
+            });
+            dense_bytes = table.getGrad().size() * sizeof(double);
+        }
+        {
+            Tensor table = Tensor::randn({V, D});
+            table.releaseGrad();
+            auto grad = std::make_shared<ops::RowSparseGrad>();
+            sparse_us = bench::timeUs(reps, [&] {
+                ops::sum(ops::embedding(table, ids, grad) * target).backward();
+                sparse_bytes = std::max(sparse_bytes, grad->bytes() + table.getGrad().size() * sizeof(double));
+                grad->sgdStep(table, lr);
+            });
+        }
+
+        std::string label = std::to_string(V) + "x" + std::to_string(D) + ", " + std::to_string(n);
+        std::cout << std::left << std::setw(22) << label << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12);
+        if (onehot_us < 0) std::cout << "-";
+        else std::cout << onehot_us;
+        std::cout << std::setw(12) << dense_us << std::setw(12) << sparse_us << std::setw(16) << dense_bytes
+                  << std::setw(16) << sparse_bytes << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+    std::cout << "times are forward + backward + SGD update per step\n";
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <atomic>
+#include <new>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "BenchUtil.hpp"
+
+// Per-op overhead on graphs of tiny tensors, where metadata and bookkeeping dominate the math.
+//   bench_graph [reps] [chain]
+// "autodiff": f(x, y) = sin(x*y) + tanh(x) + sigmoid(y) on 1-element tensors, forward + backward
+// (the main.cpp test_autodiff graph). "chain": h = tanh(h*w + b) repeated, 4-element tensors.
+
+static std::atomic<size_t> g_allocs{0};
+
+void* operator new(size_t n) {
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+struct Result { double ops_per_s; double allocs_per_op; };
+
+template <typename F>
+Result run(int reps, int ops_per_rep, F&& body) {
+    body();  // warm up
+    size_t a0 = g_allocs.load();
+    auto t0 = bench::Clock::now();
+    for (int r = 0; r < reps; ++r) body();
+    double s = bench::secondsSince(t0);
+    double ops = static_cast<double>(reps) * ops_per_rep;
+    return {ops / s, (g_allocs.load() - a0) / ops};
+}
+
+void report(const char* name, const Result& r) {
+    std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(14) << r.ops_per_s << std::setprecision(1) << std::setw(14) << r.allocs_per_op << "\n";
+    std::cout.unsetf(std::ios::fixed);
+}
+
+int main(int argc, char** argv) {
+    int reps = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int chain = argc > 2 ? std::atoi(argv[2]) : 64;
+
+    std::cout << std::left << std::setw(22) << "graph" << std::right << std::setw(14) << "ops/s"
+              << std::setw(14) << "allocs/op" << "\n";
+
+    Tensor x({1}, {2.0}, true), y({1}, {3.0}, true);
+    // 6 forward ops + backward (counted as one op per node).
+    report("autodiff fwd", run(reps, 6, [&] {
+        Tensor f = ops::sin(x * y) + ops::tanh(x) + ops::sigmoid(y);
+    }));
+    report("autodiff fwd+bwd", run(reps, 12, [&] {
+        Tensor f = ops::sin(x * y) + ops::tanh(x) + ops::sigmoid(y);
+        f.backward();
+    }));
+
+    Tensor h0 = Tensor::randn({4}), w = Tensor::randn({4}, 0.0, 1.0, true), b = Tensor::randn({4}, 0.0, 1.0, true);
+    int chain_reps = std::max(1, reps / chain);
+    report("chain fwd+bwd", run(chain_reps, 6 * chain, [&] {
+        Tensor h = h0;
+        for (int i = 0; i < chain; ++i) h = ops::tanh(h * w + b);
+        Tensor loss = ops::sum(h);
+        loss.backward();
+    }));
+
+    Tensor a({1}, std::vector<double>{1.5});
+    report("add + shapeView reads", run(reps, 1, [&] {
+        Tensor c = a + a;
+        volatile int r = c.rank() + c.size() + static_cast<int>(c.shapeView().size()) + c.shapeView()[0];
+        (void)r;
+    }));
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/autograd/Grad.hpp"
+#include "BenchUtil.hpp"
+
+// Hessian-vector products of an MLP loss: autograd::hvp (double backward) vs
+// finite differences of gradients from Tensor::backward, one-sided and central.
+//   bench_hvp [batch] [in] [hidden] [out] [reps]
+
+namespace {
+
+std::vector<Tensor> params;
+Tensor X, Y;
+
+Tensor loss(const std::vector<Tensor>& p) {
+    Tensor h = ops::tanh(ops::matmul(X, p[0]));
+    Tensor d = ops::matmul(h, p[1]) - Y;
+    return ops::mean(d * d);
+}
+
+// Gradient at params + eps * v with the regular engine.
+std::vector<std::vector<double>> gradAt(const std::vector<Tensor>& v, double eps) {
+    std::vector<Tensor> p;
+    for (size_t i = 0; i < params.size(); ++i) {
+        Tensor q = eps != 0.0 ? params[i].detach() + v[i] * eps : params[i].detach();
+        q.setRequiresGrad(true);
+        p.push_back(q);
+    }
+    loss(p).backward();
+    std::vector<std::vector<double>> g;
+    for (auto& q : p) g.push_back(q.getGrad());
+    return g;
+}
+
+double relError(const std::vector<std::vector<double>>& approx, const std::vector<Tensor>& exact) {
+    double num = 0.0, den = 0.0;
+    for (size_t i = 0; i < exact.size(); ++i) {
+        const auto& e = exact[i].getData();
+        for (size_t k = 0; k < e.size(); ++k) {
+            num += (approx[i][k] - e[k]) * (approx[i][k] - e[k]);
+            den += e[k] * e[k];
+        }
+    }
+    return std::sqrt(num / den);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int batch = argc > 1 ? std::atoi(argv[1]) : 64;
+    int in = argc > 2 ? std::atoi(argv[2]) : 64;
+    int hidden = argc > 3 ? std::atoi(argv[3]) : 128;
+    int outd = argc > 4 ? std::atoi(argv[4]) : 10;
+    int reps = argc > 5 ? std::atoi(argv[5]) : 10;
+
+    X = Tensor::randn({batch, in});
+    Y = Tensor::randn({batch, outd});
+    params = {Tensor::randn({in, hidden}, 0.0, 1.0 / std::sqrt(in), true),
+              Tensor::randn({hidden, outd}, 0.0, 1.0 / std::sqrt(hidden), true)};
+    std::vector<Tensor> v = {Tensor::randn({in, hidden}), Tensor::randn({hidden, outd})};
+
+    std::vector<Tensor> Hv;
+    double grad_ms = bench::timeMs(reps, [&] { gradAt(v, 0.0); });
+    double hvp_ms = bench::timeMs(reps, [&] { Hv = autograd::hvp(loss(params), params, v); });
+
+    std::cout << "MLP " << in << "-" << hidden << "-" << outd << ", batch " << batch << "; one gradient: " << std::fixed
+              << std::setprecision(2) << grad_ms << " ms\n";
+    std::cout << std::left << std::setw(26) << "method" << std::right << std::setw(10) << "ms" << std::setw(14)
+              << "rel. error" << "\n";
+    std::cout << std::left << std::setw(26) << "hvp (double backward)" << std::right << std::setw(10) << hvp_ms
+              << std::setw(14) << "exact" << "\n";
+
+    for (double eps : {1e-3, 1e-5, 1e-7}) {
+        std::vector<std::vector<double>> fd;
+        double ms = bench::timeMs(reps, [&] {
+            auto g0 = gradAt(v, 0.0), g1 = gradAt(v, eps);
+            fd = g1;
+            for (size_t i = 0; i < fd.size(); ++i)
+                for (size_t k = 0; k < fd[i].size(); ++k) fd[i][k] = (g1[i][k] - g0[i][k]) / eps;
+        });
+        std::cout << std::left << std::setw(26) << "forward FD, eps " + std::to_string(eps).substr(0, 9) << std::right
+                  << std::setw(10) << ms << std::scientific << std::setprecision(1) << std::setw(14) << relError(fd, Hv)
+                  << std::fixed << std::setprecision(2) << "\n";
+        ms = bench::timeMs(reps, [&] {
+            auto gp = gradAt(v, eps), gm = gradAt(v, -eps);
+            fd = gp;
+            for (size_t i = 0; i < fd.size(); ++i)
+                for (size_t k = 0; k < fd[i].size(); ++k) fd[i][k] = (gp[i][k] - gm[i][k]) / (2 * eps);
+        });
+        std::cout << std::left << std::setw(26) << "central FD, eps " + std::to_string(eps).substr(0, 9) << std::right
+                  << std::setw(10) << ms << std::scientific << std::setprecision(1) << std::setw(14) << relError(fd, Hv)
+                  << std::fixed << std::setprecision(2) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/autograd/ForwardAD.hpp"
+#include "BenchUtil.hpp"
+
+// Full Jacobian of a wide map R^n -> R^m (m >> n): jacfwd (n forward passes with
+// tangents) vs one reverse pass per output row (m forward + backward passes).
+//   bench_jvp [n] [hidden] [m...]
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 8;
+    int hidden = argc > 2 ? std::atoi(argv[2]) : 64;
+    std::vector<int> widths;
+    for (int i = 3; i < argc; ++i) widths.push_back(std::atoi(argv[i]));
+    if (widths.empty()) widths = {16, 64, 256, 1024};
+
+    std::cout << "f(x) = sigmoid(tanh(x W1) W2), x in R^" << n << ", hidden " << hidden << "\n";
+    std::cout << std::setw(8) << "m" << std::setw(14) << "jacfwd ms" << std::setw(14) << "reverse ms"
+              << std::setw(10) << "speedup" << std::setw(12) << "max |diff|" << "\n";
+
+    for (int m : widths) {
+        Tensor x = Tensor::randn({1, n});
+        Tensor W1 = Tensor::randn({n, hidden}, 0.0, 1.0 / std::sqrt(n));
+        Tensor W2 = Tensor::randn({hidden, m}, 0.0, 1.0 / std::sqrt(hidden));
+        autograd::ForwardFn f = [](const std::vector<Tensor>& in) {
+            return ops::sigmoid(ops::matmul(ops::tanh(ops::matmul(in[0], in[1])), in[2]));
+        };
+
+        auto t0 = bench::Clock::now();
+        Tensor J = autograd::jacfwd(f, {x, W1, W2});
+        double fwd_ms = bench::msSince(t0);
+
+        // Row r of the Jacobian is the gradient of y[r]: seed a one-hot cotangent per pass.
+        t0 = bench::Clock::now();
+        std::vector<double> Jr(static_cast<size_t>(m) * n);
+        Tensor seed({1, m});
+        for (int r = 0; r < m; ++r) {
+            Tensor xr = x.detach();
+            xr.setRequiresGrad(true);
+            seed.getMutableData()[r] = 1.0;
+            Tensor y = ops::sum(f({xr, W1, W2}) * seed);
+            y.backward();
+            seed.getMutableData()[r] = 0.0;
+            const auto& g = xr.getGrad();
+            for (int j = 0; j < n; ++j) Jr[static_cast<size_t>(r) * n + j] = g[j];
+        }
+        double rev_ms = bench::msSince(t0);
+
+        double diff = 0.0;
+        const auto& Jf = J.getData();
+        for (size_t q = 0; q < Jr.size(); ++q) diff = std::max(diff, std::abs(Jf[q] - Jr[q]));
+        std::cout << std::setw(8) << m << std::fixed << std::setprecision(2) << std::setw(14) << fwd_ms
+                  << std::setw(14) << rev_ms << std::setw(9) << rev_ms / fwd_ms << "x" << std::scientific
+                  << std::setprecision(1) << std::setw(12) << diff << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/utils/MemoryTracker.hpp"
+#include "BenchUtil.hpp"
+
+// relu(x W + b) as ops::linear (one node, fused epilogue) vs matmul + bias add + relu
+// (three nodes, two intermediates). Time for forward and forward + backward, bytes the
+// recorded graph keeps alive, and the largest difference between the two results.
+//   bench_linear [batch in out]...
+
+double max_diff(const std::vector<double>& a, const std::vector<double>& b) {
+    double d = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) d = std::max(d, std::fabs(a[i] - b[i]));
+    return d;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::vector<int>> shapes;
+    for (int i = 1; i + 2 < argc; i += 3) shapes.push_back({std::atoi(argv[i]), std::atoi(argv[i + 1]), std::atoi(argv[i + 2])});
+    if (shapes.empty()) shapes = {{32, 64, 64}, {256, 512, 512}};
+
+    std::cout << "relu(x W + b): fused ops::linear vs matmul + add + relu\n";
+    std::cout << std::left << std::setw(16) << "batch/in/out" << std::right << std::setw(12) << "fwd fused"
+              << std::setw(12) << "fwd split" << std::setw(12) << "f+b fused" << std::setw(12) << "f+b split"
+              << std::setw(14) << "graph B fused" << std::setw(14) << "graph B split" << std::setw(12)
+              << "max |diff|" << "\n";
+
+    for (const auto& s : shapes) {
+        int batch = s[0], in = s[1], out = s[2];
+        Tensor x = Tensor::randn({batch, in}, 0.0, 1.0, true);
+        Tensor W = Tensor::randn({in, out}, 0.0, 0.1, true);
+        Tensor b = Tensor::randn({1, out}, 0.0, 0.1, true);
+        Tensor ones = Tensor::ones({batch, 1});
+        auto fused = [&] { return ops::linear(x, W, b, ops::Activation::ReLU); };
+        auto split = [&] { return ops::relu(ops::matmul(x, W) + ops::matmul(ones, b)); };
+        int reps = std::max(3, static_cast<int>(20000000LL / (static_cast<long long>(batch) * in * out + 1)));
+
+        double f_fwd = bench::timeUs(reps, [&] { fused(); });
+        double s_fwd = bench::timeUs(reps, [&] { split(); });
+        double f_all = bench::timeUs(reps, [&] { ops::sum(fused()).backward(); });
+        double s_all = bench::timeUs(reps, [&] { ops::sum(split()).backward(); });
+
+        auto graph_bytes = [&](auto&& f) {
+            size_t before = memory::stats().live_total;
+            Tensor y = f();
+            return memory::stats().live_total - before;
+        };
+        size_t f_bytes = graph_bytes(fused);
+        size_t s_bytes = graph_bytes(split);
+
+        x.zero_grad(); W.zero_grad(); b.zero_grad();
+        Tensor yf = fused();
+        ops::sum(yf).backward();
+        std::vector<double> gw = W.getGrad(), gb = b.getGrad();
+        x.zero_grad(); W.zero_grad(); b.zero_grad();
+        Tensor ys = split();
+        ops::sum(ys).backward();
+        double diff = std::max({max_diff(yf.getData(), ys.getData()), max_diff(gw, W.getGrad()), max_diff(gb, b.getGrad())});
+
+        std::string label = std::to_string(batch) + "/" + std::to_string(in) + "/" + std::to_string(out);
+        std::cout << std::left << std::setw(16) << label << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << f_fwd << std::setw(12) << s_fwd << std::setw(12) << f_all << std::setw(12)
+                  << s_all << std::setw(14) << f_bytes << std::setw(14) << s_bytes << std::scientific
+                  << std::setprecision(1) << std::setw(12) << diff << "\n";
+        std::cout.unsetf(std::ios::fixed | std::ios::scientific);
+    }
+    std::cout << "times in us; graph B = tensor bytes (data, grad, graph) alive after the forward pass\n";
+    return 0;
+}
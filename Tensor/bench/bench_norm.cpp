@@ -0,0 +1,70 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/utils/MemoryTracker.hpp"
+#include "BenchUtil.hpp"
+
+// ops::layer_norm / ops::batch_norm against the same normalization composed from
+// matmul (row / column sums against ones), sub, mul and pow: forward + backward time
+// and the tensor bytes the recorded graph keeps alive.
+//   bench_norm [rows cols]...
+
+template <typename F>
+size_t graph_bytes(F&& f) {
+    size_t before = memory::stats().live_total;
+    Tensor y = f();
+    return memory::stats().live_total - before;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::pair<int, int>> shapes;
+    for (int i = 1; i + 1 < argc; i += 2) shapes.push_back({std::atoi(argv[i]), std::atoi(argv[i + 1])});
+    if (shapes.empty()) shapes = {{64, 64}, {256, 1024}, {4096, 128}};
+
+    std::cout << std::left << std::setw(12) << "rows x cols" << std::setw(12) << "op" << std::right << std::setw(12)
+              << "fused us" << std::setw(12) << "split us" << std::setw(10) << "speedup" << std::setw(14)
+              << "graph B fused" << std::setw(14) << "graph B split" << "\n";
+
+    for (auto [R, N] : shapes) {
+        Tensor x = Tensor::randn({R, N}, 1.0, 2.0, true);
+        Tensor gamma = Tensor::ones({N}, true), beta = Tensor::zeros({N}, true);
+        Tensor gamma2d = Tensor::ones({1, N}, true), beta2d = Tensor::zeros({1, N}, true);
+        Tensor onesN = Tensor::ones({N, 1}), ones1N = Tensor::ones({1, N});
+        Tensor onesR = Tensor::ones({R, 1}), ones1R = Tensor::ones({1, R});
+        Tensor none;
+
+        auto ln_fused = [&] { return ops::layer_norm(x, gamma, beta); };
+        auto ln_split = [&] {
+            Tensor xc = x - ops::matmul(ops::matmul(x, onesN) * (1.0 / N), ones1N);
+            Tensor var = ops::matmul(xc * xc, onesN) * (1.0 / N);
+            Tensor rstd = ops::matmul(ops::pow(var + 1e-5, -0.5), ones1N);
+            return xc * rstd * ops::matmul(onesR, gamma2d) + ops::matmul(onesR, beta2d);
+        };
+        auto bn_fused = [&] { return ops::batch_norm(x, none, none, gamma, beta); };
+        auto bn_split = [&] {
+            Tensor xc = x - ops::matmul(onesR, ops::matmul(ones1R, x) * (1.0 / R));
+            Tensor var = ops::matmul(ones1R, xc * xc) * (1.0 / R);
+            Tensor rstd = ops::matmul(onesR, ops::pow(var + 1e-5, -0.5));
+            return xc * rstd * ops::matmul(onesR, gamma2d) + ops::matmul(onesR, beta2d);
+        };
+
+        int reps = std::max(3, 20000000 / (R * N * 20));
+        std::string label = std::to_string(R) + "x" + std::to_string(N);
+        auto row = [&](const char* op, auto&& fused, auto&& split) {
+            double f = bench::timeUs(reps, [&] { ops::sum(fused()).backward(); });
+            double s = bench::timeUs(reps, [&] { ops::sum(split()).backward(); });
+            std::cout << std::left << std::setw(12) << label << std::setw(12) << op << std::right << std::fixed
+                      << std::setprecision(1) << std::setw(12) << f << std::setw(12) << s << std::setprecision(2)
+                      << std::setw(9) << s / f << "x" << std::setw(14) << graph_bytes(fused) << std::setw(14)
+                      << graph_bytes(split) << "\n";
+            std::cout.unsetf(std::ios::fixed);
+        };
+        row("layer_norm", ln_fused, ln_split);
+        row("batch_norm", bn_fused, bn_split);
+    }
+    std::cout << "times are forward + backward\n";
+    return 0;
+}
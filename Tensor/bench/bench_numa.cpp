@@ -0,0 +1,75 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/utils/Numa.hpp"
+#include "../include/utils/Parallel.hpp"
+#include "BenchUtil.hpp"
+
+// STREAM-style bandwidth (copy, scale, add, triad) over Tensor buffers, with the kernels
+// split by parallel_for. "placed" builds the tensors with NUMA first-touch placement,
+// "serial" with it switched off, so every page sits on the constructing thread's node.
+// On a single-node machine both rows measure the same thing.
+//   bench_numa [elements [reps]]
+
+using bench::Clock;
+
+struct Kernel {
+    const char* name;
+    int arrays;   // buffers streamed per element
+};
+
+int main(int argc, char** argv) {
+    int64_t n = argc > 1 ? std::atoll(argv[1]) : (int64_t(1) << 24);
+    int reps = argc > 2 ? std::atoi(argv[2]) : 10;
+    const auto& topo = numa::topology();
+    std::cout << "nodes " << topo.node_cpus.size() << ", cpus " << topo.cpu_order.size() << ", threads "
+              << parallel::get_num_threads() << ", numa " << (numa::enabled() ? "on" : "off") << ", "
+              << n * 8 / (1 << 20) << " MiB per array\n";
+
+    const Kernel kernels[] = {{"copy", 2}, {"scale", 2}, {"add", 3}, {"triad", 3}};
+    bool default_on = numa::enabled();
+    std::cout << std::left << std::setw(10) << "placement" << std::right;
+    for (const auto& k : kernels) std::cout << std::setw(12) << (std::string(k.name) + " GB/s");
+    std::cout << "\n";
+
+    for (bool placed : {true, false}) {
+        numa::setEnabled(placed && default_on);
+        Tensor ta({static_cast<int>(n)}), tb({static_cast<int>(n)}, std::vector<double>(n, 2.0)),
+            tc({static_cast<int>(n)}, std::vector<double>(n, 0.5));
+        for (Tensor* t : {&ta, &tb, &tc}) t->releaseGrad();
+        double* a = ta.getMutableData().data();
+        double* b = tb.getMutableData().data();
+        double* c = tc.getMutableData().data();
+        const double s = 3.0;
+
+        std::cout << std::left << std::setw(10) << (placed && default_on ? "placed" : "serial") << std::right
+                  << std::fixed << std::setprecision(2);
+        for (int ki = 0; ki < 4; ++ki) {
+            double best = 1e30;
+            for (int r = 0; r < reps; ++r) {
+                auto t0 = Clock::now();
+                // Same grain as numa::firstTouch, so each thread streams the pages it placed.
+                parallel::parallel_for(0, n, 512, [&](int64_t lo, int64_t hi) {
+                    switch (ki) {
+                    case 0: for (int64_t i = lo; i < hi; ++i) c[i] = a[i]; break;
+                    case 1: for (int64_t i = lo; i < hi; ++i) b[i] = s * c[i]; break;
+                    case 2: for (int64_t i = lo; i < hi; ++i) c[i] = a[i] + b[i]; break;
+                    default: for (int64_t i = lo; i < hi; ++i) a[i] = b[i] + s * c[i]; break;
+                    }
+                });
+                best = std::min(best, bench::secondsSince(t0));
+            }
+            std::cout << std::setw(12) << kernels[ki].arrays * 8.0 * n / best / 1e9;
+        }
+        std::cout << "\n";
+        std::cout.unsetf(std::ios::fixed);
+        if (!default_on) break;
+    }
+    numa::setEnabled(default_on);
+    if (!default_on) std::cout << "single node: placement and pinning are off (TENSOR_NUMA=1 forces them)\n";
+    return 0;
+}
@@ -0,0 +1,529 @@
+// Op-level benchmark suite.
+//
+//   bench_ops [--filter <substr>] [--min-time <sec>] [--quick] [--threads 1,2,4]
+//             [--out <file.json>] [--compare <baseline.json>] [--threshold <frac>]
+//
+// Every op from all_ops.hpp is timed forward and backward over a sweep of
+// shapes and thread counts; ops with 16-bit kernels also run in bfloat16 and
+// float16. Results are written as JSON; with --compare, each case is matched
+// by id against a saved baseline and slowdowns above the threshold are
+// reported and make the process exit with status 2.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <atomic>
+#include <random>
+#include <map>
+#include <algorithm>
+#include <functional>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/SparseTensor.hpp"
+#include "../include/utils/Parallel.hpp"
+
+// ==========================================
+// Allocation Counting
+// ==========================================
+
+static std::atomic<long long> g_alloc_count{0};
+static std::atomic<long long> g_alloc_bytes{0};
+
+// GCC flags malloc/free inside replacement operators as mismatched; they are not.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t n) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    g_alloc_bytes.fetch_add(static_cast<long long>(n), std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// ==========================================
+// Benchmark Cases
+// ==========================================
+
+using Shapes = std::vector<std::vector<int>>;
+
+struct Case {
+    std::string op;
+    Shapes shapes;
+    std::function<Tensor(const std::vector<Tensor>&)> fn;
+    double fwd_flops;
+    double fwd_bytes;
+    double bwd_flops;
+    double bwd_bytes;
+    bool diag_dominant = false;
+    DType dtype = DType::Float64;
+    int captured = 0;   // leading shapes are operands fn holds itself; their inputs stay empty
+};
+
+struct Result {
+    std::string id, op, pass, shape, dtype;
+    int threads = 1;
+    long long reps = 0;
+    double median_ns = 0, min_ns = 0, gflops = 0, gbps = 0;
+    double allocs_per_call = 0, bytes_alloc_per_call = 0;
+};
+
+static std::string shapeString(const Shapes& shapes) {
+    std::ostringstream os;
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        if (i) os << ",";
+        for (size_t d = 0; d < shapes[i].size(); ++d) os << (d ? "x" : "") << shapes[i][d];
+    }
+    return os.str();
+}
+
+static double numel(const std::vector<int>& s) {
+    double n = 1;
+    for (int d : s) n *= d;
+    return n;
+}
+
+static std::vector<Case> buildCases(bool quick) {
+    std::vector<Case> cases;
+    const double B = sizeof(double);
+
+    std::vector<std::vector<int>> elem_shapes = quick
+        ? std::vector<std::vector<int>>{{1024}, {256, 256}}
+        : std::vector<std::vector<int>>{{1}, {1024}, {256, 256}, {1024, 1024}};
+
+    struct Unary { const char* name; std::function<Tensor(const Tensor&)> f; double flops_per_el; };
+    std::vector<Unary> unary = {
+        {"neg", [](const Tensor& a) { return ops::neg(a); }, 1},
+        {"pow", [](const Tensor& a) { return ops::pow(a, 3.0); }, 10},
+        {"exp", [](const Tensor& a) { return ops::exp(a); }, 10},
+        {"log", [](const Tensor& a) { return ops::log(a); }, 10},
+        {"sin", [](const Tensor& a) { return ops::sin(a); }, 10},
+        {"cos", [](const Tensor& a) { return ops::cos(a); }, 10},
+        {"tan", [](const Tensor& a) { return ops::tan(a); }, 10},
+        {"tanh", [](const Tensor& a) { return ops::tanh(a); }, 10},
+        {"relu", [](const Tensor& a) { return ops::relu(a); }, 1},
+        {"sigmoid", [](const Tensor& a) { return ops::sigmoid(a); }, 12},
+        {"dropout", [](const Tensor& a) { return ops::dropout(a, 0.1); }, 2},
+        // double overloads: the constant lives in the graph node, not in a {1} tensor
+        {"add_scalar", [](const Tensor& a) { return ops::add(a, 0.5); }, 1},
+        {"sub_scalar", [](const Tensor& a) { return ops::sub(a, 0.5); }, 1},
+        {"mul_scalar", [](const Tensor& a) { return ops::mul(a, 0.5); }, 1},
+        {"div_scalar", [](const Tensor& a) { return ops::div(a, 0.5); }, 1},
+    };
+    struct Binary { const char* name; std::function<Tensor(const Tensor&, const Tensor&)> f; };
+    std::vector<Binary> binary = {
+        {"add", [](const Tensor& a, const Tensor& b) { return ops::add(a, b); }},
+        {"sub", [](const Tensor& a, const Tensor& b) { return ops::sub(a, b); }},
+        {"mul", [](const Tensor& a, const Tensor& b) { return ops::mul(a, b); }},
+        {"div", [](const Tensor& a, const Tensor& b) { return ops::div(a, b); }},
+    };
+
+    for (const auto& s : elem_shapes) {
+        double n = numel(s);
+        for (const auto& b : binary) {
+            auto f = b.f;
+            cases.push_back({b.name, {s, s}, [f](const std::vector<Tensor>& in) { return f(in[0], in[1]); },
+                             n, 3 * n * B, 2 * n, 5 * n * B});
+            // Scalar-broadcast branch
+            cases.push_back({b.name, {s, {1}}, [f](const std::vector<Tensor>& in) { return f(in[0], in[1]); },
+                             n, 2 * n * B, 2 * n, 4 * n * B});
+        }
+        for (const auto& u : unary) {
+            auto f = u.f;
+            cases.push_back({u.name, {s}, [f](const std::vector<Tensor>& in) { return f(in[0]); },
+                             u.flops_per_el * n, 2 * n * B, u.flops_per_el * n, 3 * n * B});
+        }
+        cases.push_back({"sum", {s}, [](const std::vector<Tensor>& in) { return ops::sum(in[0]); },
+                         n, n * B, 0, n * B});
+        cases.push_back({"mean", {s}, [](const std::vector<Tensor>& in) { return ops::mean(in[0]); },
+                         n, n * B, n, n * B});
+    }
+
+    std::vector<std::vector<int>> softmax_shapes = quick
+        ? std::vector<std::vector<int>>{{64, 128}}
+        : std::vector<std::vector<int>>{{1024}, {64, 128}, {256, 1024}};
+    for (const auto& s : softmax_shapes) {
+        double n = numel(s), row = static_cast<double>(s.back());
+        cases.push_back({"softmax", {s}, [](const std::vector<Tensor>& in) { return ops::softmax(in[0]); },
+                         15 * n, 2 * n * B, 3 * n * row, 3 * n * B});
+    }
+
+    std::vector<int> mat_sizes = quick ? std::vector<int>{32, 128} : std::vector<int>{16, 64, 128, 256};
+    for (int m : mat_sizes) {
+        double mm = static_cast<double>(m);
+        cases.push_back({"matmul", {{m, m}, {m, m}}, [](const std::vector<Tensor>& in) { return ops::matmul(in[0], in[1]); },
+                         2 * mm * mm * mm, 3 * mm * mm * B, 4 * mm * mm * mm, 5 * mm * mm * B});
+        cases.push_back({"transpose", {{m, m}}, [](const std::vector<Tensor>& in) { return ops::transpose(in[0]); },
+                         0, 2 * mm * mm * B, 0, 2 * mm * mm * B});
+        cases.push_back({"inverse", {{m, m}}, [](const std::vector<Tensor>& in) { return ops::inverse(in[0]); },
+                         4 * mm * mm * mm, 2 * mm * mm * B, 4 * mm * mm * mm, 3 * mm * mm * B, true});
+    }
+    // 16-bit inputs (float64 grads); the 16-bit binary kernels need equal shapes.
+    auto lowPrecision = [](const char* name) {
+        for (const char* op : {"add", "sub", "mul", "relu", "sigmoid", "tanh"}) {
+            if (std::strcmp(op, name) == 0) return true;
+        }
+        return false;
+    };
+    for (DType d : {DType::BFloat16, DType::Float16}) {
+        const double H = static_cast<double>(dtypeSize(d));
+        for (const auto& s : elem_shapes) {
+            double n = numel(s);
+            for (const auto& b : binary) {
+                if (!lowPrecision(b.name)) continue;
+                auto f = b.f;
+                Case c{b.name, {s, s}, [f](const std::vector<Tensor>& in) { return f(in[0], in[1]); },
+                       n, 3 * n * H, 2 * n, 2 * n * H + 3 * n * B};
+                c.dtype = d;
+                cases.push_back(c);
+            }
+            for (const auto& u : unary) {
+                if (!lowPrecision(u.name)) continue;
+                auto f = u.f;
+                Case c{u.name, {s}, [f](const std::vector<Tensor>& in) { return f(in[0]); },
+                       u.flops_per_el * n, 2 * n * H, u.flops_per_el * n, n * H + 2 * n * B};
+                c.dtype = d;
+                cases.push_back(c);
+            }
+            Case sum{"sum", {s}, [](const std::vector<Tensor>& in) { return ops::sum(in[0]); }, n, n * H, 0, n * B};
+            Case mean{"mean", {s}, [](const std::vector<Tensor>& in) { return ops::mean(in[0]); }, n, n * H, n, n * B};
+            sum.dtype = mean.dtype = d;
+            cases.push_back(sum);
+            cases.push_back(mean);
+        }
+        for (int m : mat_sizes) {
+            double mm = static_cast<double>(m);
+            Case c{"matmul", {{m, m}, {m, m}}, [](const std::vector<Tensor>& in) { return ops::matmul(in[0], in[1]); },
+                   2 * mm * mm * mm, 3 * mm * mm * H, 4 * mm * mm * mm, 3 * mm * mm * H + 2 * mm * mm * B};
+            c.dtype = d;
+            cases.push_back(c);
+        }
+    }
+
+    // Fused layers.
+    std::vector<int> layer_sizes = quick ? std::vector<int>{128} : std::vector<int>{64, 256};
+    for (int h : layer_sizes) {
+        double hh = static_cast<double>(h), bs = 64, steps = 16;
+        int batch = 64, seq = 16;
+        cases.push_back({"linear", {{batch, h}, {h, h}, {h}},
+                         [](const std::vector<Tensor>& in) { return ops::linear(in[0], in[1], in[2], ops::Activation::Tanh); },
+                         2 * bs * hh * hh + 11 * bs * hh, (2 * bs * hh + hh * hh + hh) * B,
+                         4 * bs * hh * hh + 3 * bs * hh, (4 * bs * hh + 2 * hh * hh + 2 * hh) * B});
+        double lstm_flops = steps * 16 * bs * hh * hh;
+        cases.push_back({"lstm", {{seq, batch, h}, {h, 4 * h}, {h, 4 * h}, {4 * h}},
+                         [](const std::vector<Tensor>& in) {
+                             return ops::lstm(in[0], ops::LSTMState(), in[1], in[2], in[3]).output;
+                         },
+                         lstm_flops + 60 * steps * bs * hh, (2 * steps * bs * hh + 8 * hh * hh) * B,
+                         2 * lstm_flops + 40 * steps * bs * hh, (4 * steps * bs * hh + 16 * hh * hh) * B});
+        cases.push_back({"lstm_cell", {{batch, h}, {batch, h}, {batch, h}, {h, 4 * h}, {h, 4 * h}, {4 * h}},
+                         [](const std::vector<Tensor>& in) {
+                             return ops::lstm_cell(in[0], {in[1], in[2]}, in[3], in[4], in[5]).h;
+                         },
+                         16 * bs * hh * hh + 60 * bs * hh, (4 * bs * hh + 8 * hh * hh) * B,
+                         32 * bs * hh * hh + 40 * bs * hh, (7 * bs * hh + 16 * hh * hh) * B});
+        cases.push_back({"gru_cell", {{batch, h}, {batch, h}, {h, 3 * h}, {h, 3 * h}, {3 * h}, {3 * h}},
+                         [](const std::vector<Tensor>& in) { return ops::gru_cell(in[0], in[1], in[2], in[3], in[4], in[5]); },
+                         12 * bs * hh * hh + 40 * bs * hh, (3 * bs * hh + 6 * hh * hh) * B,
+                         24 * bs * hh * hh + 40 * bs * hh, (5 * bs * hh + 12 * hh * hh) * B});
+    }
+
+    std::vector<int> seq_lens = quick ? std::vector<int>{128} : std::vector<int>{64, 256};
+    for (int L : seq_lens) {
+        const int heads = 4, d = 64;
+        double scores = static_cast<double>(heads) * L * L, tok = static_cast<double>(heads) * L * d;
+        cases.push_back({"attention", {{heads, L, d}, {heads, L, d}, {heads, L, d}},
+                         [](const std::vector<Tensor>& in) {
+                             return ops::scaled_dot_product_attention(in[0], in[1], in[2], Tensor(), true);
+                         },
+                         4 * scores * d, 4 * tok * B, 10 * scores * d, 8 * tok * B});
+    }
+
+    std::vector<std::vector<int>> norm_shapes = quick
+        ? std::vector<std::vector<int>>{{64, 256}}
+        : std::vector<std::vector<int>>{{64, 256}, {256, 1024}};
+    for (const auto& s : norm_shapes) {
+        double n = numel(s), c = static_cast<double>(s[1]);
+        cases.push_back({"layer_norm", {s, {s[1]}, {s[1]}},
+                         [](const std::vector<Tensor>& in) { return ops::layer_norm(in[0], in[1], in[2]); },
+                         8 * n, (2 * n + 2 * c) * B, 10 * n, (4 * n + 4 * c) * B});
+        // Running statistics are captured, not inputs: they are updated in place every call.
+        int channels = s[0];
+        Tensor running_mean = Tensor::zeros({channels}), running_var = Tensor::ones({channels});
+        cases.push_back({"batch_norm", {{8, channels, s[1] / 8}, {channels}, {channels}},
+                         [running_mean, running_var](const std::vector<Tensor>& in) {
+                             return ops::batch_norm(in[0], running_mean, running_var, in[1], in[2]);
+                         },
+                         8 * n, 2 * n * B, 10 * n, 4 * n * B});
+    }
+
+    std::vector<int> vocab_sizes = quick ? std::vector<int>{10000} : std::vector<int>{1000, 100000};
+    for (int vocab : vocab_sizes) {
+        const int dim = 64, lookups = 4096;
+        std::mt19937_64 gen(7);
+        std::vector<int> indices(lookups);
+        for (int& i : indices) i = static_cast<int>(gen() % vocab);
+        double moved = static_cast<double>(lookups) * dim * B;
+        cases.push_back({"embedding", {{vocab, dim}}, [indices](const std::vector<Tensor>& in) { return ops::embedding(in[0], indices); },
+                         0, 2 * moved, 0, 2 * moved});
+    }
+
+    for (const auto& s : elem_shapes) {
+        double n = numel(s);
+        cases.push_back({"cast", {s}, [](const std::vector<Tensor>& in) { return ops::cast(in[0], DType::BFloat16); },
+                         n, n * (B + 2), 0, 2 * n * B});
+        Case widen{"cast", {s}, [](const std::vector<Tensor>& in) { return ops::cast(in[0], DType::Float64); },
+                   n, n * (B + 2), 0, 2 * n * B};
+        widen.dtype = DType::Float16;
+        cases.push_back(widen);
+    }
+
+    std::vector<int> dot_sizes = quick ? std::vector<int>{4096} : std::vector<int>{1024, 65536};
+    for (int n : dot_sizes) {
+        double nn = static_cast<double>(n);
+        cases.push_back({"dot", {{n}, {n}}, [](const std::vector<Tensor>& in) { return ops::dot(in[0], in[1]); },
+                         2 * nn, 2 * nn * B, 2 * nn, 4 * nn * B});
+    }
+    std::vector<int> sparse_sizes = quick ? std::vector<int>{1024} : std::vector<int>{1024, 4096};
+    for (int m : sparse_sizes) {
+        // 1% dense left operand, built once per case
+        std::mt19937_64 gen(99);
+        std::uniform_real_distribution<double> u(0.0, 1.0);
+        Tensor dense({m, m});
+        for (double& v : dense.getMutableData()) v = u(gen) < 0.01 ? u(gen) : 0.0;
+        SparseTensor S = SparseTensor::fromDense(dense);
+        double nnz = S.nnz(), cols = 64;
+        Case c{"spmm", {{m, m}, {m, 64}}, [S](const std::vector<Tensor>& in) { return ops::matmul(S, in[1]); },
+               2 * nnz * cols, (nnz * (B + 4) + 2 * m * cols * B), 2 * nnz * cols, (nnz * (B + 4) + 2 * m * cols * B)};
+        c.captured = 1;
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+// ==========================================
+// Measurement
+// ==========================================
+
+static std::vector<Tensor> makeInputs(const Case& c, bool requires_grad) {
+    std::mt19937_64 gen(1234);
+    std::uniform_real_distribution<double> dist(0.5, 1.5);
+    std::vector<Tensor> in;
+    for (const auto& s : c.shapes) {
+        if (static_cast<int>(in.size()) < c.captured) {
+            in.emplace_back();
+            continue;
+        }
+        if (c.dtype != DType::Float64) {
+            Tensor t(s, c.dtype, requires_grad);
+            for (uint16_t& v : t.getMutableHalfData()) v = half::encode(c.dtype, static_cast<float>(dist(gen)));
+            in.push_back(t);
+            continue;
+        }
+        Tensor t(s, requires_grad);
+        auto& d = t.getMutableData();
+        for (double& v : d) v = dist(gen);
+        if (c.diag_dominant && s.size() == 2) {
+            for (int i = 0; i < s[0]; ++i) d[static_cast<size_t>(i) * s[1] + i] += s[0];
+        }
+        in.push_back(t);
+    }
+    return in;
+}
+
+static Result measure(const Case& c, bool backward, double min_time) {
+    using clock = std::chrono::steady_clock;
+    std::vector<double> samples;
+    long long allocs = 0, bytes = 0;
+    double total = 0;
+
+    // Warm-up, then keep sampling until the time budget is used (at least 5 reps).
+    for (int rep = -1; rep < 5 || total < min_time; ++rep) {
+        double ns;
+        long long a0, b0;
+        if (!backward) {
+            auto in = makeInputs(c, false);
+            a0 = g_alloc_count.load(); b0 = g_alloc_bytes.load();
+            auto t0 = clock::now();
+            Tensor out = c.fn(in);
+            ns = std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+        } else {
+            auto in = makeInputs(c, true);
+            Tensor out = c.fn(in);
+            a0 = g_alloc_count.load(); b0 = g_alloc_bytes.load();
+            auto t0 = clock::now();
+            out.backward();
+            ns = std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+        }
+        long long da = g_alloc_count.load() - a0, db = g_alloc_bytes.load() - b0;
+        if (rep < 0) continue;
+        samples.push_back(ns);
+        allocs += da;
+        bytes += db;
+        total += ns * 1e-9;
+        if (samples.size() >= 100000) break;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    Result r;
+    r.op = c.op;
+    r.pass = backward ? "backward" : "forward";
+    r.shape = shapeString(c.shapes);
+    r.dtype = dtypeName(c.dtype);
+    r.threads = parallel::get_num_threads();
+    r.id = r.op + "/" + r.pass + "/" + r.shape + "/" + r.dtype + "/t" + std::to_string(r.threads);
+    r.reps = static_cast<long long>(samples.size());
+    r.median_ns = samples[samples.size() / 2];
+    r.min_ns = samples.front();
+    double flops = backward ? c.bwd_flops : c.fwd_flops;
+    double bytes_moved = backward ? c.bwd_bytes : c.fwd_bytes;
+    r.gflops = flops / r.median_ns;
+    r.gbps = bytes_moved / r.median_ns;
+    r.allocs_per_call = static_cast<double>(allocs) / r.reps;
+    r.bytes_alloc_per_call = static_cast<double>(bytes) / r.reps;
+    return r;
+}
+
+// ==========================================
+// JSON Output & Baseline Comparison
+// ==========================================
+
+static void writeJson(std::ostream& os, const std::vector<Result>& results, double min_time) {
+    os << "{\n  \"schema\": 1,\n  \"min_time_s\": " << min_time << ",\n  \"results\": [\n";
+    os << std::setprecision(10);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        os << "    {\"id\": \"" << r.id << "\", \"op\": \"" << r.op << "\", \"pass\": \"" << r.pass
+           << "\", \"shape\": \"" << r.shape << "\", \"dtype\": \"" << r.dtype
+           << "\", \"threads\": " << r.threads << ", \"reps\": " << r.reps
+           << ", \"median_ns\": " << r.median_ns << ", \"min_ns\": " << r.min_ns
+           << ", \"gflops\": " << r.gflops << ", \"gbps\": " << r.gbps
+           << ", \"allocs_per_call\": " << r.allocs_per_call
+           << ", \"bytes_alloc_per_call\": " << r.bytes_alloc_per_call << "}"
+           << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+}
+
+// Reads the flat result objects written by writeJson(): id -> median_ns.
+static std::map<std::string, double> readBaseline(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Cannot open baseline file: " + path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    std::string text = ss.str();
+
+    auto field = [](const std::string& obj, const std::string& key) -> std::string {
+        auto k = obj.find("\"" + key + "\"");
+        if (k == std::string::npos) return "";
+        auto colon = obj.find(':', k);
+        auto start = obj.find_first_not_of(" \t\n", colon + 1);
+        if (obj[start] == '"') return obj.substr(start + 1, obj.find('"', start + 1) - start - 1);
+        return obj.substr(start, obj.find_first_of(",}", start) - start);
+    };
+
+    std::map<std::string, double> base;
+    auto results = text.find("\"results\"");
+    if (results == std::string::npos) throw std::runtime_error("Baseline has no results array: " + path);
+    for (size_t pos = text.find('{', results); pos != std::string::npos; pos = text.find('{', pos + 1)) {
+        auto end = text.find('}', pos);
+        if (end == std::string::npos) break;
+        std::string obj = text.substr(pos, end - pos + 1);
+        std::string id = field(obj, "id"), median = field(obj, "median_ns");
+        if (!id.empty() && !median.empty()) base[id] = std::atof(median.c_str());
+        pos = end;
+    }
+    return base;
+}
+
+static int compare(const std::vector<Result>& results, const std::map<std::string, double>& base, double threshold) {
+    int regressions = 0, matched = 0;
+    for (const auto& r : results) {
+        auto it = base.find(r.id);
+        if (it == base.end() || it->second <= 0) continue;
+        ++matched;
+        double ratio = r.median_ns / it->second;
+        if (ratio > 1.0 + threshold) {
+            ++regressions;
+            std::cerr << "REGRESSION " << std::left << std::setw(48) << r.id << std::right << std::fixed
+                      << std::setprecision(0) << std::setw(12) << it->second << " ns -> " << std::setw(12)
+                      << r.median_ns << " ns  (" << std::setprecision(2) << ratio << "x)\n";
+        } else if (ratio < 1.0 - threshold) {
+            std::cerr << "improved   " << std::left << std::setw(48) << r.id << std::right << std::fixed
+                      << std::setprecision(2) << ratio << "x\n";
+        }
+    }
+    std::cerr << matched << " cases compared, " << regressions << " regression(s) above "
+              << threshold * 100 << "%\n";
+    return regressions;
+}
+
+int main(int argc, char** argv) {
+    std::string filter, out_path, baseline_path;
+    double min_time = 0.05, threshold = 0.10;
+    bool quick = false;
+    std::vector<int> thread_counts = {parallel::get_num_threads()};
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--filter") filter = value();
+        else if (arg == "--min-time") min_time = std::atof(value().c_str());
+        else if (arg == "--out") out_path = value();
+        else if (arg == "--compare") baseline_path = value();
+        else if (arg == "--threshold") threshold = std::atof(value().c_str());
+        else if (arg == "--quick") quick = true;
+        else if (arg == "--threads") {
+            thread_counts.clear();
+            std::stringstream list(value());
+            for (std::string item; std::getline(list, item, ',');) thread_counts.push_back(std::atoi(item.c_str()));
+        }
+        else {
+            std::cerr << "usage: bench_ops [--filter s] [--min-time sec] [--quick] [--threads 1,2,4] [--out file] "
+                         "[--compare baseline.json] [--threshold frac]\n";
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::vector<Result> results;
+    auto cases = buildCases(quick);
+    for (int threads : thread_counts) {
+        parallel::set_num_threads(threads);
+        for (const auto& c : cases) {
+            for (bool backward : {false, true}) {
+                std::string id = c.op + "/" + (backward ? "backward" : "forward") + "/" + shapeString(c.shapes) + "/" +
+                                 dtypeName(c.dtype);
+                if (!filter.empty() && id.find(filter) == std::string::npos) continue;
+                results.push_back(measure(c, backward, min_time));
+                const auto& r = results.back();
+                std::cerr << std::left << std::setw(48) << r.id << std::right << std::fixed << std::setprecision(0)
+                          << std::setw(12) << r.median_ns << " ns" << std::setprecision(3) << std::setw(10)
+                          << r.gflops << " GFLOP/s" << std::setw(10) << r.gbps << " GB/s" << std::setprecision(1)
+                          << std::setw(12) << r.allocs_per_call << " allocs\n";
+            }
+        }
+    }
+
+    if (out_path.empty()) {
+        writeJson(std::cout, results, min_time);
+    } else {
+        std::ofstream os(out_path);
+        writeJson(os, results, min_time);
+    }
+
+    if (!baseline_path.empty()) {
+        return compare(results, readBaseline(baseline_path), threshold) > 0 ? 2 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/quant/Quantize.hpp"
+#include "../include/quant/QuantizedLinear.hpp"
+#include "BenchUtil.hpp"
+
+// Float64 ops:: path vs INT8 QuantizedLinear on a small MLP (in -> hidden -> hidden -> classes).
+// Accuracy is top-1 agreement with the float path on held-out inputs, plus logit error.
+//   bench_quant [batch] [in] [hidden] [classes]
+
+struct Layer {
+    Tensor W;
+    Tensor b;
+    bool relu;
+};
+
+Tensor floatForward(const std::vector<Layer>& net, const Tensor& x, std::vector<Tensor>* layer_inputs = nullptr) {
+    Tensor h = x;
+    for (const auto& l : net) {
+        if (layer_inputs) layer_inputs->push_back(h);
+        Tensor y = ops::matmul(h, l.W);
+        auto Y = y.accessor<2>();
+        const auto& bias = l.b.getData();
+        for (int i = 0; i < Y.size(0); ++i) {
+            double* row = Y.row(i);
+            for (int j = 0; j < Y.size(1); ++j) row[j] += bias[j];
+        }
+        h = l.relu ? ops::relu(y) : y;
+    }
+    return h;
+}
+
+int argmax(const double* row, int n) {
+    int best = 0;
+    for (int j = 1; j < n; ++j) if (row[j] > row[best]) best = j;
+    return best;
+}
+
+int main(int argc, char** argv) {
+    int batch = argc > 1 ? std::atoi(argv[1]) : 256;
+    int in = argc > 2 ? std::atoi(argv[2]) : 256;
+    int hidden = argc > 3 ? std::atoi(argv[3]) : 512;
+    int classes = argc > 4 ? std::atoi(argv[4]) : 10;
+
+    std::vector<int> dims = {in, hidden, hidden, classes};
+    std::vector<Layer> net;
+    for (size_t l = 0; l + 1 < dims.size(); ++l) {
+        double stddev = std::sqrt(2.0 / dims[l]);
+        net.push_back({Tensor::randn({dims[l], dims[l + 1]}, 0.0, stddev), Tensor::randn({dims[l + 1]}, 0.0, 0.1),
+                       l + 2 < dims.size()});
+    }
+
+    // Calibrate activation ranges on one set of inputs, evaluate on another.
+    Tensor calib = Tensor::randn({batch, in});
+    Tensor x = Tensor::randn({batch, in});
+    std::vector<Tensor> calib_inputs;
+    Tensor calib_out = floatForward(net, calib, &calib_inputs);
+    calib_inputs.push_back(calib_out);
+
+    std::vector<quant::QParams> act_params;
+    for (const Tensor& t : calib_inputs) act_params.push_back(quant::calibrate(t, quant::QScheme::PerTensorAffine));
+
+    auto build = [&](quant::QScheme scheme) {
+        std::vector<quant::QuantizedLinear> q;
+        for (size_t l = 0; l < net.size(); ++l) {
+            q.emplace_back(net[l].W, net[l].b, act_params[l],
+                           net[l].relu ? quant::Activation::ReLU : quant::Activation::None, scheme);
+        }
+        return q;
+    };
+    auto q_tensor = build(quant::QScheme::PerTensorSymmetric);
+    auto q_channel = build(quant::QScheme::PerChannelSymmetric);
+
+    // Dequantize after every layer (float activations between layers).
+    auto runDequant = [](const std::vector<quant::QuantizedLinear>& q, const Tensor& x) {
+        Tensor h = x;
+        for (const auto& l : q) h = l.forward(h);
+        return h;
+    };
+    // Stay in int8 between layers; only the logits are dequantized.
+    auto runInt8 = [&](const std::vector<quant::QuantizedLinear>& q, const Tensor& x) {
+        quant::QTensor h = q[0].quantizeInput(x);
+        for (size_t l = 0; l + 1 < q.size(); ++l) h = q[l].forwardQuantized(h, act_params[l + 1]);
+        return q.back().forward(h);
+    };
+
+    Tensor ref = floatForward(net, x);
+    auto report = [&](const std::string& name, const Tensor& y, double ms, size_t weight_bytes) {
+        auto R = ref.accessor<2>();
+        auto Y = y.accessor<2>();
+        int agree = 0;
+        double max_err = 0.0, sum_err = 0.0, sum_ref = 0.0;
+        for (int i = 0; i < batch; ++i) {
+            agree += argmax(R.row(i), classes) == argmax(Y.row(i), classes);
+            for (int j = 0; j < classes; ++j) {
+                double e = std::abs(R(i, j) - Y(i, j));
+                max_err = std::max(max_err, e);
+                sum_err += e;
+                sum_ref += std::abs(R(i, j));
+            }
+        }
+        std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(10) << ms << std::setw(14) << std::setprecision(0) << batch / ms * 1e3
+                  << std::setw(12) << weight_bytes / 1024 << std::setprecision(2) << std::setw(11)
+                  << 100.0 * agree / batch << "%" << std::setprecision(4) << std::setw(12) << sum_err / sum_ref
+                  << std::setw(12) << max_err << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    };
+
+    size_t float_bytes = 0, q_bytes = 0;
+    for (const auto& l : net) float_bytes += l.W.size() * sizeof(double);
+    for (const auto& l : q_channel) q_bytes += l.weightBytes();
+
+    std::cout << "MLP " << in << "-" << hidden << "-" << hidden << "-" << classes << ", batch " << batch << "\n";
+    std::cout << std::left << std::setw(28) << "path" << std::right << std::setw(10) << "ms" << std::setw(14)
+              << "samples/s" << std::setw(12) << "weight KiB" << std::setw(12) << "top-1 agree" << std::setw(12)
+              << "rel err" << std::setw(12) << "max err" << "\n";
+
+    double ms = bench::timeMs(10, [&]() { floatForward(net, x); });
+    report("float64 ops::matmul", ref, ms, float_bytes);
+    ms = bench::timeMs(10, [&]() { runDequant(q_tensor, x); });
+    report("int8 per-tensor, dequant", runDequant(q_tensor, x), ms, q_bytes);
+    ms = bench::timeMs(10, [&]() { runDequant(q_channel, x); });
+    report("int8 per-channel, dequant", runDequant(q_channel, x), ms, q_bytes);
+    ms = bench::timeMs(10, [&]() { runInt8(q_channel, x); });
+    report("int8 per-channel, int8 acts", runInt8(q_channel, x), ms, q_bytes);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/utils/Parallel.hpp"
+#include "BenchUtil.hpp"
+
+// ops::sum on large tensors: the previous single-accumulator loop vs the block
+// reduction engine across thread counts. Reports time, error against a long double
+// reference, and whether the bits match the 1-thread result.
+//   bench_reduce [n] [reps] [threads...]
+
+namespace {
+
+double sequentialSum(const std::vector<double>& x) {
+    double s = 0.0;
+    for (double v : x) s += v;
+    return s;
+}
+
+bool sameBits(double a, double b) { return std::memcmp(&a, &b, sizeof(double)) == 0; }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 1 << 22;
+    int reps = argc > 2 ? std::atoi(argv[2]) : 20;
+    std::vector<int> threads;
+    for (int i = 3; i < argc; ++i) threads.push_back(std::atoi(argv[i]));
+    if (threads.empty()) threads = {1, 2, 4};
+
+    // Mixed magnitudes make the summation order visible in the result.
+    Tensor x = Tensor::normal({n}, 1.0, 1e3);
+    const auto& data = x.getData();
+    long double ref = 0.0L;
+    for (double v : data) ref += v;
+
+    std::cout << "ops::sum over " << n << " values\n";
+    std::cout << std::left << std::setw(16) << "mode" << std::right << std::setw(8) << "threads" << std::setw(12) << "ms"
+              << std::setw(12) << "GB/s" << std::setw(14) << "rel. error" << std::setw(16) << "bits vs 1 thr" << "\n";
+    auto row = [&](const char* mode, int t, double ms, double s, const char* bits) {
+        double err = std::abs(static_cast<double>((s - ref) / ref));
+        std::cout << std::left << std::setw(16) << mode << std::right << std::setw(8) << t << std::fixed
+                  << std::setprecision(3) << std::setw(12) << ms << std::setprecision(2) << std::setw(12)
+                  << n * sizeof(double) / ms / 1e6 << std::scientific << std::setprecision(1) << std::setw(14) << err
+                  << std::setw(16) << bits << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    };
+
+    double seq = 0.0;
+    double seq_ms = bench::timeMs(reps, [&] { seq = sequentialSum(data); });
+    row("sequential", 1, seq_ms, seq, "-");
+    double first = 0.0;
+    for (size_t k = 0; k < threads.size(); ++k) {
+        parallel::set_num_threads(threads[k]);
+        double s = 0.0;
+        double ms = bench::timeMs(reps, [&] { s = ops::sum(x).at({0}); });
+        if (k == 0) first = s;
+        row("blocks", threads[k], ms, s, k == 0 ? "-" : sameBits(s, first) ? "same" : "differ");
+    }
+    return 0;
+}
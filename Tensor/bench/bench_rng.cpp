@@ -0,0 +1,85 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/utils/Parallel.hpp"
+#include "../include/utils/MemoryTracker.hpp"
+#include "BenchUtil.hpp"
+
+// Philox fills vs the previous per-call std::random_device + std::mt19937 randn,
+// and fused dropout vs multiplying by a stored bernoulli mask (forward + backward).
+//   bench_rng [reps] [threads...]
+
+namespace {
+
+Tensor legacyRandn(const std::vector<int>& shape) {
+    Tensor t(shape);
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::normal_distribution<double> d(0.0, 1.0);
+    for (double& v : t.getMutableData()) v = d(gen);
+    return t;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int reps = argc > 1 ? std::atoi(argv[1]) : 10;
+    std::vector<int> threads;
+    for (int i = 2; i < argc; ++i) threads.push_back(std::atoi(argv[i]));
+    if (threads.empty()) threads = {1, 2, 4};
+
+    std::cout << std::left << std::setw(30) << "case" << std::right << std::setw(8) << "threads" << std::setw(12)
+              << "ms" << std::setw(14) << "M values/s" << "\n";
+    auto row = [](const std::string& name, int t, double ms, double n) {
+        std::cout << std::left << std::setw(30) << name << std::right << std::setw(8) << t << std::fixed
+                  << std::setprecision(3) << std::setw(12) << ms << std::setprecision(1) << std::setw(14)
+                  << n / ms / 1e3 << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    };
+
+    for (int n : {1024, 1 << 20}) {
+        std::string sz = "[" + std::to_string(n) + "]";
+        row("randn (mt19937) " + sz, 1, bench::timeMs(reps, [&] { legacyRandn({n}); }), n);
+        for (int t : threads) {
+            parallel::set_num_threads(t);
+            row("normal (philox) " + sz, t, bench::timeMs(reps, [&] { Tensor::normal({n}); }), n);
+            row("uniform (philox) " + sz, t, bench::timeMs(reps, [&] { Tensor::uniform({n}); }), n);
+            row("bernoulli (philox) " + sz, t, bench::timeMs(reps, [&] { Tensor::bernoulli({n}, 0.9); }), n);
+        }
+    }
+
+    int n = 1 << 20;
+    Tensor x = Tensor::randn({n}, 0.0, 1.0, true);
+    std::cout << "\ndropout p = 0.1 on [" << n << "], forward + backward\n";
+    for (int t : threads) {
+        parallel::set_num_threads(t);
+        size_t fused_peak = 0, mask_peak = 0;
+        double fused = bench::timeMs(reps, [&] {
+            x.zero_grad();
+            memory::resetPeak();
+            size_t base = memory::stats().live_total;
+            Tensor y = ops::dropout(x, 0.1);
+            ops::sum(y).backward();
+            fused_peak = memory::stats().peak_total - base;
+        });
+        double masked = bench::timeMs(reps, [&] {
+            x.zero_grad();
+            memory::resetPeak();
+            size_t base = memory::stats().live_total;
+            Tensor y = x * (Tensor::bernoulli({n}, 0.9) / 0.9);
+            ops::sum(y).backward();
+            mask_peak = memory::stats().peak_total - base;
+        });
+        row("fused dropout", t, fused, n);
+        row("x * stored mask", t, masked, n);
+        std::cout << std::fixed << std::setprecision(1) << "  peak extra MiB: fused " << fused_peak / (1024.0 * 1024.0)
+                  << ", stored mask " << mask_peak / (1024.0 * 1024.0) << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "BenchUtil.hpp"
+
+// Tokens per second (forward + backward) of an LSTM over a sequence, built three ways:
+// from matmul / add / sigmoid / tanh / mul per step, with ops::lstm_cell per step, and
+// with one ops::lstm call. ops::gru_cell per step is listed alongside.
+//   bench_rnn [steps] [batch] [hidden...]
+
+int main(int argc, char** argv) {
+    int steps = argc > 1 ? std::atoi(argv[1]) : 32;
+    int batch = argc > 2 ? std::atoi(argv[2]) : 8;
+    std::vector<int> hidden;
+    for (int i = 3; i < argc; ++i) hidden.push_back(std::atoi(argv[i]));
+    if (hidden.empty()) hidden = {16, 64, 128};
+
+    std::cout << "LSTM, " << steps << " steps x batch " << batch << ", input = hidden, forward + backward\n";
+    std::cout << std::setw(8) << "hidden" << std::setw(14) << "unfused tok/s" << std::setw(14) << "cell tok/s"
+              << std::setw(14) << "seq tok/s" << std::setw(10) << "speedup" << std::setw(14) << "gru tok/s"
+              << "\n";
+
+    for (int H : hidden) {
+        int in = H;
+        std::vector<Tensor> xs;
+        for (int t = 0; t < steps; ++t) xs.push_back(Tensor::randn({batch, in}));
+        Tensor X = Tensor::randn({steps, batch, in});
+        Tensor W_ih = Tensor::randn({in, 4 * H}, 0.0, 0.1, true);
+        Tensor W_hh = Tensor::randn({H, 4 * H}, 0.0, 0.1, true);
+        Tensor b = Tensor::zeros({1, 4 * H}, true);
+        Tensor G_ih = Tensor::randn({in, 3 * H}, 0.0, 0.1, true);
+        Tensor G_hh = Tensor::randn({H, 3 * H}, 0.0, 0.1, true);
+        // Per-gate weights for the unfused version: i, f, g, o
+        std::vector<Tensor> Wx, Wh, bg;
+        for (int k = 0; k < 4; ++k) {
+            Wx.push_back(Tensor::randn({in, H}, 0.0, 0.1, true));
+            Wh.push_back(Tensor::randn({H, H}, 0.0, 0.1, true));
+            bg.push_back(Tensor::zeros({1, H}, true));
+        }
+        Tensor ones = Tensor::ones({batch, 1});
+
+        auto unfused = [&] {
+            Tensor h = Tensor::zeros({batch, H}), c = Tensor::zeros({batch, H});
+            Tensor loss = Tensor::zeros({1});
+            for (int t = 0; t < steps; ++t) {
+                Tensor z[4];
+                for (int k = 0; k < 4; ++k) z[k] = ops::matmul(xs[t], Wx[k]) + ops::matmul(h, Wh[k]) + ops::matmul(ones, bg[k]);
+                c = ops::sigmoid(z[1]) * c + ops::sigmoid(z[0]) * ops::tanh(z[2]);
+                h = ops::sigmoid(z[3]) * ops::tanh(c);
+                loss = loss + ops::sum(h);
+            }
+            loss.backward();
+        };
+        auto cell = [&] {
+            ops::LSTMState st{Tensor::zeros({batch, H}), Tensor::zeros({batch, H})};
+            Tensor loss = Tensor::zeros({1});
+            for (int t = 0; t < steps; ++t) {
+                st = ops::lstm_cell(xs[t], st, W_ih, W_hh, b);
+                loss = loss + ops::sum(st.h);
+            }
+            loss.backward();
+        };
+        auto seq = [&] { ops::sum(ops::lstm(X, {}, W_ih, W_hh, b).output).backward(); };
+        auto gru = [&] {
+            Tensor h = Tensor::zeros({batch, H});
+            Tensor loss = Tensor::zeros({1});
+            for (int t = 0; t < steps; ++t) {
+                h = ops::gru_cell(xs[t], h, G_ih, G_hh);
+                loss = loss + ops::sum(h);
+            }
+            loss.backward();
+        };
+
+        int reps = std::max(2, 2000000 / (steps * batch * H * H + 1));
+        double tokens = static_cast<double>(steps) * batch;
+        double u = tokens / bench::timeUs(reps, unfused) * 1e6;
+        double c = tokens / bench::timeUs(reps, cell) * 1e6;
+        double s = tokens / bench::timeUs(reps, seq) * 1e6;
+        double g = tokens / bench::timeUs(reps, gru) * 1e6;
+        std::cout << std::setw(8) << H << std::fixed << std::setprecision(0) << std::setw(14) << u << std::setw(14) << c
+                  << std::setw(14) << s << std::setprecision(2) << std::setw(9) << s / u << "x" << std::setprecision(0)
+                  << std::setw(14) << g << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+    std::cout << "speedup = seq over unfused\n";
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/utils/MemoryTracker.hpp"
+#include "BenchUtil.hpp"
+
+// y = x * 0.5 + 1.0 (forward + backward) with the constants passed as doubles (scalar
+// overloads) vs wrapped in {1} tensors (the broadcast path operator*(double) used to take).
+//   bench_scalar [sizes...]
+
+int main(int argc, char** argv) {
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; ++i) sizes.push_back(std::atoi(argv[i]));
+    if (sizes.empty()) sizes = {1, 64, 4096, 1 << 20};
+
+    std::cout << "y = x * 0.5 + 1.0, forward + backward\n";
+    std::cout << std::setw(10) << "n" << std::setw(14) << "scalar us" << std::setw(14) << "{1} tensor us"
+              << std::setw(10) << "speedup" << std::setw(16) << "graph B scalar" << std::setw(16) << "graph B {1}"
+              << "\n";
+
+    for (int n : sizes) {
+        Tensor x = Tensor::randn({n}, 0.0, 1.0, true);
+        int reps = std::max(3, 2000000 / (n + 64));
+
+        auto scalar = [&] {
+            Tensor y = x * 0.5 + 1.0;
+            y.backward();
+        };
+        auto boxed = [&] {
+            Tensor y = ops::add(ops::mul(x, Tensor({1}, std::vector<double>{0.5})), Tensor({1}, std::vector<double>{1.0}));
+            y.backward();
+        };
+        auto graph_bytes = [&](bool use_scalar) {
+            size_t before = memory::stats().live_total;
+            Tensor y = use_scalar ? x * 0.5 + 1.0
+                                  : ops::add(ops::mul(x, Tensor({1}, std::vector<double>{0.5})),
+                                             Tensor({1}, std::vector<double>{1.0}));
+            return memory::stats().live_total - before;
+        };
+
+        double s_us = bench::timeUs(reps, scalar);
+        double b_us = bench::timeUs(reps, boxed);
+        std::cout << std::setw(10) << n << std::fixed << std::setprecision(2) << std::setw(14) << s_us
+                  << std::setw(14) << b_us << std::setw(9) << b_us / s_us << "x" << std::setw(16)
+                  << graph_bytes(true) << std::setw(16) << graph_bytes(false) << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+    return 0;
+}
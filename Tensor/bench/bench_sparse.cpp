@@ -0,0 +1,50 @@
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <cstdlib>
+#include "../include/Tensor.hpp"
+#include "../include/SparseTensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/utils/Parallel.hpp"
+#include "BenchUtil.hpp"
+
+// Sparse x dense vs dense ops::matmul, forward + backward to the dense operand.
+//   bench_sparse [rows] [inner] [cols]
+
+int main(int argc, char** argv) {
+    int m = argc > 1 ? std::atoi(argv[1]) : 2048;
+    int n = argc > 2 ? std::atoi(argv[2]) : 4096;
+    int p = argc > 3 ? std::atoi(argv[3]) : 32;
+    int hw = parallel::get_num_threads();
+
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    Tensor W = Tensor::randn({n, p}, 0.0, 0.1, true);
+
+    std::cout << "A[" << m << "x" << n << "] x W[" << n << "x" << p << "], forward + backward (ms/step)\n";
+    std::cout << std::left << std::setw(10) << "density" << std::setw(10) << "nnz" << std::right
+              << std::setw(12) << "dense" << std::setw(14) << "sparse t=1" << std::setw(12) << "sparse t="
+              << hw << std::setw(12) << "speedup" << "\n";
+
+    for (double density : {0.001, 0.01, 0.05, 0.2}) {
+        Tensor A({m, n});
+        for (double& v : A.getMutableData()) v = u(gen) < density ? u(gen) : 0.0;
+        SparseTensor S = SparseTensor::fromDense(A);
+
+        auto step_dense = [&]() { ops::sum(ops::matmul(A, W)).backward(); W.zero_grad(); };
+        auto step_sparse = [&]() { ops::sum(ops::matmul(S, W)).backward(); W.zero_grad(); };
+
+        double dense_ms = bench::timeMs(2, step_dense);
+        parallel::set_num_threads(1);
+        double sparse1_ms = bench::timeMs(5, step_sparse);
+        parallel::set_num_threads(hw);
+        double sparseN_ms = bench::timeMs(5, step_sparse);
+
+        std::cout << std::left << std::setw(10) << density << std::setw(10) << S.nnz() << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(12) << dense_ms << std::setw(14)
+                  << sparse1_ms << std::setw(12) << sparseN_ms << std::setw(11) << dense_ms / sparseN_ms
+                  << "x\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+    return 0;
+}
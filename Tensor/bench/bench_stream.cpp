@@ -0,0 +1,87 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/stream/Stream.hpp"
+#include "BenchUtil.hpp"
+
+// Overlapping data loading with compute. Each step loads a batch (a simulated read of
+// io_ms milliseconds, then normalization into a tensor) and runs an MLP training step on it.
+// Serial: load and compute alternate on the calling thread. Streamed: a loader stream
+// prefetches batch i + 1 while the compute stream runs step i, and the caller only queues work.
+//   bench_stream [io_ms [batch [hidden [steps]]]]
+
+using bench::Clock;
+
+int main(int argc, char** argv) {
+    int io_ms = argc > 1 ? std::atoi(argv[1]) : 20;
+    int batch = argc > 2 ? std::atoi(argv[2]) : 128;
+    int hidden = argc > 3 ? std::atoi(argv[3]) : 256;
+    int steps = argc > 4 ? std::atoi(argv[4]) : 20;
+    const int in = 256;
+
+    rng::Generator gen(7);
+    Tensor W1 = Tensor::randn({in, hidden}, 0.0, 0.05, true), b1 = Tensor::zeros({1, hidden}, true);
+    Tensor W2 = Tensor::randn({hidden, hidden}, 0.0, 0.05, true), b2 = Tensor::zeros({1, hidden}, true);
+    std::vector<Tensor*> params = {&W1, &b1, &W2, &b2};
+
+    auto load = [&](int i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(io_ms));
+        Tensor x = Tensor::normal({batch, in}, 0.0, 1.0, false, &gen);
+        autograd::NoGradGuard no_grad;
+        return ops::layer_norm(x) * (1.0 + 0.01 * i);
+    };
+    auto step = [&](const Tensor& x) {
+        Tensor h = ops::linear(x, W1, b1, ops::Activation::ReLU);
+        Tensor loss = ops::mean(ops::linear(h, W2, b2, ops::Activation::Tanh));
+        loss.backward();
+        for (Tensor* p : params) {
+            auto& w = p->getMutableData();
+            const auto& g = p->getGrad();
+            for (size_t k = 0; k < w.size(); ++k) w[k] -= 0.01 * g[k];
+            p->zero_grad();
+        }
+        return loss.getData()[0];
+    };
+
+    // Time the two stages on their own first.
+    auto t0 = Clock::now();
+    Tensor probe = load(0);
+    double load_ms = bench::msSince(t0);
+    t0 = Clock::now();
+    step(probe);
+    double compute_ms = bench::msSince(t0);
+
+    t0 = Clock::now();
+    for (int i = 0; i < steps; ++i) step(load(i));
+    double serial_ms = bench::msSince(t0) / steps;
+
+    stream::Stream loader, compute;
+    t0 = Clock::now();
+    stream::AsyncTensor next = loader.enqueue(load, 0);
+    std::vector<stream::Future<double>> losses;
+    for (int i = 0; i < steps; ++i) {
+        stream::AsyncTensor cur = next;
+        if (i + 1 < steps) next = loader.enqueue(load, i + 1);
+        losses.push_back(compute.enqueue(step, cur));
+    }
+    double queued_ms = bench::msSince(t0);
+    compute.synchronize();
+    double streamed_ms = bench::msSince(t0) / steps;
+    losses.back().get();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "batch " << batch << " x " << in << ", hidden " << hidden << ", io " << io_ms << " ms, " << steps
+              << " steps\n";
+    std::cout << "load  " << std::setw(8) << load_ms << " ms   compute " << std::setw(8) << compute_ms << " ms\n";
+    std::cout << "serial   " << std::setw(8) << serial_ms << " ms/step\n";
+    std::cout << "streamed " << std::setw(8) << streamed_ms << " ms/step  (caller busy " << queued_ms
+              << " ms in total queuing " << steps << " steps)\n";
+    std::cout << "bound    " << std::setw(8) << std::max(load_ms, compute_ms) << " ms/step  (the slower stage)\n";
+    return 0;
+}
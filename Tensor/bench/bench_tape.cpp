@@ -0,0 +1,84 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "../include/Tensor.hpp"
+#include "../include/ops/all_ops.hpp"
+#include "../include/autograd/Tape.hpp"
+#include "../include/utils/MemoryTracker.hpp"
+#include "BenchUtil.hpp"
+
+// Per-node autograd overhead: closure graph (loss.backward()) vs autograd::Tape.
+// Graph: h = tanh(h * w + b) repeated `depth` times on `width`-element tensors, loss = sum(h).
+//   bench_tape [depth] [width] [reps]
+
+struct Timing { double fwd_ns; double bwd_ns; size_t graph_bytes; double loss; };
+
+Timing run(bool use_tape, int depth, int reps, const Tensor& h0, Tensor& w, Tensor& b) {
+    autograd::Tape tape;
+    Timing t{0.0, 0.0, 0, 0.0};
+    int nodes = 3 * depth + 1;
+    for (int r = 0; r < reps; ++r) {
+        w.zero_grad();
+        b.zero_grad();
+        size_t graph_before = memory::stats().live[memory::Graph];
+
+        auto t0 = bench::Clock::now();
+        Tensor loss;
+        {
+            std::unique_ptr<autograd::TapeGuard> rec;
+            if (use_tape) rec = std::make_unique<autograd::TapeGuard>(tape);
+            Tensor h = h0;
+            for (int i = 0; i < depth; ++i) h = ops::tanh(h * w + b);
+            loss = ops::sum(h);
+        }
+        auto t1 = bench::Clock::now();
+        if (use_tape) tape.backward(loss);
+        else loss.backward();
+        auto t2 = bench::Clock::now();
+
+        size_t graph = memory::stats().live[memory::Graph] - graph_before;
+        t.graph_bytes = use_tape ? tape.bytes() + graph : graph;
+        t.loss = loss.at({0});
+        if (use_tape) tape.clear();
+        if (r == 0) continue;  // warm-up
+        t.fwd_ns += std::chrono::duration<double, std::nano>(t1 - t0).count() / nodes;
+        t.bwd_ns += std::chrono::duration<double, std::nano>(t2 - t1).count() / nodes;
+    }
+    t.fwd_ns /= std::max(1, reps - 1);
+    t.bwd_ns /= std::max(1, reps - 1);
+    return t;
+}
+
+int main(int argc, char** argv) {
+    int depth = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int width = argc > 2 ? std::atoi(argv[2]) : 4;
+    int reps = argc > 3 ? std::atoi(argv[3]) : 20;
+
+    Tensor h0 = Tensor::randn({width});
+    Tensor w = Tensor::randn({width}, 0.0, 1.0, true);
+    Tensor b = Tensor::randn({width}, 0.0, 1.0, true);
+
+    std::cout << "tanh(h * w + b) x " << depth << ", width " << width << " (" << 3 * depth + 1 << " nodes)\n";
+    std::cout << std::left << std::setw(10) << "engine" << std::right << std::setw(14) << "fwd ns/node"
+              << std::setw(14) << "bwd ns/node" << std::setw(16) << "graph B/node" << std::setw(14) << "|dw| diff"
+              << "\n";
+
+    Timing closure = run(false, depth, reps, h0, w, b);
+    std::vector<double> gw = w.getGrad();
+    Timing tape = run(true, depth, reps, h0, w, b);
+    double diff = 0.0;
+    for (size_t i = 0; i < gw.size(); ++i) diff = std::max(diff, std::fabs(gw[i] - w.getGrad()[i]));
+
+    int nodes = 3 * depth + 1;
+    for (auto& [name, t] : {std::pair<const char*, Timing>{"closure", closure}, {"tape", tape}}) {
+        std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << t.fwd_ns << std::setw(14) << t.bwd_ns << std::setw(16)
+                  << static_cast<double>(t.graph_bytes) / nodes;
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setw(14) << (t.loss == closure.loss ? diff : -1.0) << "\n";
+    }
+    return 0;
+}
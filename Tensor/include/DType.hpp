@@ -0,0 +1,89 @@
+#ifndef DTYPE_HPP
+#define DTYPE_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+// Storage type of TensorImpl::data.
+// Float64 tensors keep `data`; BFloat16 / Float16 tensors keep the raw 16-bit
+// patterns in `data16`. Gradients are always float64.
+enum class DType { Float64, BFloat16, Float16 };
+
+inline const char* dtypeName(DType d) {
+    switch (d) {
+        case DType::BFloat16: return "bfloat16";
+        case DType::Float16: return "float16";
+        default: return "float64";
+    }
+}
+
+inline size_t dtypeSize(DType d) { return d == DType::Float64 ? sizeof(double) : sizeof(uint16_t); }
+
+// Software conversions (no F16C / AVX512-BF16 needed). float -> 16-bit rounds to nearest even.
+namespace half {
+
+inline uint32_t floatBits(float f) { uint32_t u; std::memcpy(&u, &f, sizeof(u)); return u; }
+inline float bitsFloat(uint32_t u) { float f; std::memcpy(&f, &u, sizeof(f)); return f; }
+
+inline uint16_t floatToBf16(float f) {
+    uint32_t u = floatBits(f);
+    if ((u & 0x7FFFFFFFu) > 0x7F800000u) return static_cast<uint16_t>((u >> 16) | 0x40u);  // quiet NaN
+    u += 0x7FFFu + ((u >> 16) & 1u);
+    return static_cast<uint16_t>(u >> 16);
+}
+
+inline float bf16ToFloat(uint16_t h) { return bitsFloat(static_cast<uint32_t>(h) << 16); }
+
+inline uint16_t floatToFp16(float f) {
+    uint32_t u = floatBits(f);
+    uint32_t sign = (u >> 16) & 0x8000u;
+    uint32_t a = u & 0x7FFFFFFFu;
+    if (a >= 0x7F800000u) return static_cast<uint16_t>(sign | 0x7C00u | (a > 0x7F800000u ? 0x200u : 0u));
+    if (a >= 0x477FF000u) return static_cast<uint16_t>(sign | 0x7C00u);   // >= 65520 rounds to inf
+    if (a < 0x38800000u) {
+        // Subnormal or zero: the mantissa is |f| / 2^-24, rounded to nearest even.
+        uint32_t m = static_cast<uint32_t>(std::nearbyint(bitsFloat(a) * 16777216.0f));
+        return static_cast<uint16_t>(sign | m);
+    }
+    // Rebias the exponent (127 -> 15) and round the 13 dropped mantissa bits to nearest even.
+    a += 0xC8000FFFu + ((a >> 13) & 1u);
+    return static_cast<uint16_t>(sign | (a >> 13));
+}
+
+inline float fp16ToFloat(uint16_t h) {
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+    uint32_t exp = (h >> 10) & 0x1Fu;
+    uint32_t mant = h & 0x3FFu;
+    if (exp == 0) {
+        float v = static_cast<float>(mant) * (1.0f / 16777216.0f);
+        return sign ? -v : v;
+    }
+    if (exp == 31) return bitsFloat(sign | 0x7F800000u | (mant << 13));
+    return bitsFloat(sign | ((exp + 112u) << 23) | (mant << 13));
+}
+
+inline uint16_t encode(DType d, float f) { return d == DType::BFloat16 ? floatToBf16(f) : floatToFp16(f); }
+inline float decode(DType d, uint16_t h) { return d == DType::BFloat16 ? bf16ToFloat(h) : fp16ToFloat(h); }
+
+// Widens n values into float scratch; kernels then run on float rows.
+inline void decodeRow(DType d, const uint16_t* src, float* dst, size_t n) {
+    if (d == DType::BFloat16) {
+        for (size_t i = 0; i < n; ++i) dst[i] = bf16ToFloat(src[i]);
+    } else {
+        for (size_t i = 0; i < n; ++i) dst[i] = fp16ToFloat(src[i]);
+    }
+}
+
+inline void encodeRow(DType d, const float* src, uint16_t* dst, size_t n) {
+    if (d == DType::BFloat16) {
+        for (size_t i = 0; i < n; ++i) dst[i] = floatToBf16(src[i]);
+    } else {
+        for (size_t i = 0; i < n; ++i) dst[i] = floatToFp16(src[i]);
+    }
+}
+
+} // namespace half
+
+#endif
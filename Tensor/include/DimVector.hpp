@@ -0,0 +1,70 @@
+#ifndef DIM_VECTOR_HPP
+#define DIM_VECTOR_HPP
+
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Shape / strides storage held inline in TensorImpl: up to kMaxRank dimensions, no heap
+// allocation. Converts implicitly from and to std::vector<int>, so existing call sites that
+// build shapes as vectors keep working; hot paths should read Tensor::shapeView() instead
+// of copying with getShape().
+class DimVector {
+public:
+    static constexpr int kMaxRank = 8;
+
+    DimVector() = default;
+    DimVector(std::initializer_list<int> dims) { assign(dims.begin(), dims.end()); }
+    DimVector(const std::vector<int>& dims) { assign(dims.data(), dims.data() + dims.size()); }
+    DimVector(const int* first, const int* last) { assign(first, last); }
+
+    operator std::vector<int>() const { return std::vector<int>(begin(), end()); }
+
+    size_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    int* data() { return dims; }
+    const int* data() const { return dims; }
+    int* begin() { return dims; }
+    int* end() { return dims + n; }
+    const int* begin() const { return dims; }
+    const int* end() const { return dims + n; }
+    int& operator[](size_t i) { return dims[i]; }
+    int operator[](size_t i) const { return dims[i]; }
+    int& back() { return dims[n - 1]; }
+    int back() const { return dims[n - 1]; }
+
+    void resize(size_t count, int value = 0) {
+        checkRank(count);
+        for (size_t i = n; i < count; ++i) dims[i] = value;
+        n = count;
+    }
+    void push_back(int d) {
+        checkRank(n + 1);
+        dims[n++] = d;
+    }
+    void clear() { n = 0; }
+
+    friend bool operator==(const DimVector& a, const DimVector& b) {
+        return a.n == b.n && std::equal(a.begin(), a.end(), b.begin());
+    }
+    friend bool operator!=(const DimVector& a, const DimVector& b) { return !(a == b); }
+
+private:
+    int dims[kMaxRank] = {};
+    size_t n = 0;
+
+    static void checkRank(size_t count) {
+        if (count > static_cast<size_t>(kMaxRank)) {
+            throw std::invalid_argument("Tensor rank exceeds DimVector::kMaxRank (" + std::to_string(kMaxRank) + ")!");
+        }
+    }
+    void assign(const int* first, const int* last) {
+        checkRank(static_cast<size_t>(last - first));
+        n = static_cast<size_t>(last - first);
+        std::copy(first, last, dims);
+    }
+};
+
+#endif
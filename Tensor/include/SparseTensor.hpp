@@ -0,0 +1,75 @@
+#ifndef SPARSE_TENSOR_HPP
+#define SPARSE_TENSOR_HPP
+
+#include "Tensor.hpp"
+#include <memory>
+#include <vector>
+
+enum class SparseLayout { COO, CSR };
+
+// 2D sparse matrix body.
+// COO: indices holds row indices (one per nonzero), sorted by (row, col).
+// CSR: indices holds row offsets (rows + 1 entries).
+// Both layouts keep entries coalesced, row-major ordered, with col_idx per nonzero.
+struct SparseImpl {
+    int rows;
+    int cols;
+    SparseLayout layout;
+    std::vector<int> indices;
+    std::vector<int> col_idx;
+    std::vector<double> values;
+
+    // CSR of the transpose, built on first use by the SpMM backward pass (under a lock).
+    std::shared_ptr<const SparseImpl> transposed;
+};
+
+class SparseTensor {
+private:
+    std::shared_ptr<SparseImpl> impl;
+
+public:
+    // Constructors //
+    SparseTensor();
+    explicit SparseTensor(std::shared_ptr<SparseImpl> ptr);
+
+    // Static Factory Methods //
+    // Duplicate (row, col) entries are summed; explicit zeros are kept.
+    static SparseTensor fromCOO(int rows, int cols, const std::vector<int>& row_idx,
+                                const std::vector<int>& col_idx, const std::vector<double>& values,
+                                SparseLayout layout = SparseLayout::CSR);
+    // Keeps entries with |value| > threshold.
+    static SparseTensor fromDense(const Tensor& dense, SparseLayout layout = SparseLayout::CSR, double threshold = 0.0);
+
+    // Conversions //
+    Tensor toDense() const;
+    SparseTensor toCSR() const;
+    SparseTensor toCOO() const;
+    SparseTensor transpose() const;
+
+    // Getters //
+    std::vector<int> getShape() const;
+    int rows() const;
+    int cols() const;
+    int nnz() const;
+    double density() const;
+    SparseLayout layout() const;
+    std::shared_ptr<SparseImpl> getImpl() const { return impl; }
+
+    const std::vector<int>& rowPtr() const;   // CSR only
+    const std::vector<int>& rowIdx() const;   // COO only
+    const std::vector<int>& colIdx() const;
+    const std::vector<double>& values() const;
+
+    // Element-wise ops with scalars (preserve the sparsity pattern) //
+    SparseTensor operator*(double val) const;
+    SparseTensor operator/(double val) const;
+    SparseTensor operator-() const;
+    SparseTensor pow(double exponent) const;   // exponent > 0, so zeros stay zero
+
+    // Utility methods //
+    void print() const;
+};
+
+SparseTensor operator*(double val, const SparseTensor& s);
+
+#endif
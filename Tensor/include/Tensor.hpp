@@ -9,27 +9,57 @@
 #include <string>
 #include <initializer_list>
 #include <iostream>
+#include "TensorAccessor.hpp"
+#include "DimVector.hpp"
+#include "utils/Arena.hpp"
+#include "DType.hpp"
 
 class Tensor;
+namespace rng { class Generator; }
 
 struct TensorImpl {
     std::vector<double> data;      
+    std::vector<uint16_t> data16;   // storage for BFloat16 / Float16 tensors (data stays empty)
     std::vector<double> grad;
-    std::vector<int> shape;         
-    std::vector<int> strides;      
+    std::vector<double> tangent;    // forward-mode AD; empty when the tensor carries no tangent
+    DimVector shape;                // inline, see DimVector.hpp
+    DimVector strides;
     int total_size;                 
     bool requires_grad;
+    DType dtype = DType::Float64;
 
-    // Autodiff computation graph
-    std::vector<Tensor> parents;
-    std::function<void()> backward_fn;
+    // Autodiff computation graph (bookkeeping lives in the thread's arena, see utils/Arena.hpp)
+    arena::Vector<Tensor> parents;
+    arena::Function backward_fn;
+    // Same gradient expressed in ops, so it can itself be differentiated
+    // (autograd::grad with create_graph). Returns one gradient per parent.
+    std::function<std::vector<Tensor>(const Tensor& out, const std::vector<Tensor>& in, const Tensor& grad)> vjp_fn;
 
-    TensorImpl(const std::vector<int>& shape, bool req_grad = false);
-    TensorImpl(const std::vector<int>& shape, const std::vector<double>& values, bool req_grad = false);
+    // Memory accounting (utils/MemoryTracker.hpp)
+    const char* creator_op = nullptr;
+    size_t graph_bytes = 0;
+    bool tracked = false;
+
+    // Index in the autograd::Tape that last recorded this tensor (checked against the tape).
+    int tape_slot = -1;
+
+    // See Tensor::setGradReadyHook; null for almost every tensor.
+    std::unique_ptr<std::function<void()>> grad_ready_hook;
+
+    TensorImpl(const DimVector& shape, bool req_grad = false);
+    TensorImpl(const DimVector& shape, const std::vector<double>& values, bool req_grad = false);
+    TensorImpl(const DimVector& shape, DType dtype, bool req_grad = false);
+    ~TensorImpl();
+
+    void releaseGraph();
+
+    template <int Rank> TensorAccessor<double, Rank> dataAccessor();
+    template <int Rank> TensorAccessor<double, Rank> gradAccessor();
 
     void computeStrides();          
-    int computeTotalSize(const std::vector<int>& shape) const;
+    int computeTotalSize(const DimVector& shape) const;
     int flattenIndex(const std::vector<int>& indices) const;
+    int flattenIndex(const int* indices, size_t count) const;
 };
 
 class Tensor {
@@ -41,14 +71,21 @@ private:
 public:
     // Constructors //
     Tensor();
-    Tensor(const std::vector<int>& shape, bool requires_grad = false);   
-    Tensor(const std::vector<int>& shape, const std::vector<double>& values, bool requires_grad = false);
+    Tensor(const DimVector& shape, bool requires_grad = false);
+    Tensor(const DimVector& shape, const std::vector<double>& values, bool requires_grad = false);
+    Tensor(const DimVector& shape, DType dtype, bool requires_grad = false);
     explicit Tensor(std::shared_ptr<TensorImpl> ptr);
 
     // Static Factory Methods //
-    static Tensor zeros(const std::vector<int>& shape, bool requires_grad = false);
-    static Tensor ones(const std::vector<int>& shape, bool requires_grad = false);
-    static Tensor randn(const std::vector<int>& shape, double mean = 0.0, double stddev = 1.0, bool requires_grad = false);
+    static Tensor zeros(const DimVector& shape, bool requires_grad = false);
+    static Tensor ones(const DimVector& shape, bool requires_grad = false);
+    // Random factories draw from rng::defaultGenerator() unless `gen` is given (utils/Random.hpp).
+    static Tensor randn(const DimVector& shape, double mean = 0.0, double stddev = 1.0, bool requires_grad = false);
+    static Tensor normal(const DimVector& shape, double mean = 0.0, double stddev = 1.0,
+                         bool requires_grad = false, rng::Generator* gen = nullptr);
+    static Tensor uniform(const DimVector& shape, double low = 0.0, double high = 1.0,
+                          bool requires_grad = false, rng::Generator* gen = nullptr);
+    static Tensor bernoulli(const DimVector& shape, double p = 0.5, rng::Generator* gen = nullptr);
 
     // Operator overloads untuk akses elemen //
     double& operator()(const std::initializer_list<int>& indices);
@@ -56,11 +93,13 @@ public:
 
     // Getters //
     std::vector<int> getShape() const;
+    const DimVector& shapeView() const;     // no copy; valid while the tensor is alive
     int size() const;
     int rank() const;                       
     bool isScalar() const;     
     bool isEmpty() const;      
-    std::shared_ptr<TensorImpl> getImpl() const { return impl; }
+    DType dtype() const;
+    const std::shared_ptr<TensorImpl>& getImpl() const { return impl; }
 
     // Element access methods
     double at(const std::vector<int>& indices) const;      
@@ -71,20 +110,42 @@ public:
     // Direct data access //
     const std::vector<double>& getData() const;
     std::vector<double>& getMutableData() const;
-    const std::vector<int>& getStrides() const;  
+    const DimVector& getStrides() const;
+    // Raw 16-bit patterns of BFloat16 / Float16 tensors; getData() is Float64 only.
+    const std::vector<uint16_t>& getHalfData() const;
+    std::vector<uint16_t>& getMutableHalfData() const;
     
     // Autodiff / Gradient methods //
     bool requiresGrad() const;
     void setRequiresGrad(bool req);
+    // Frees the gradient buffer of a tensor that does not require grad, e.g. an embedding
+    // table trained through ops::RowSparseGrad. setRequiresGrad(true) reallocates it.
+    void releaseGrad();
+    // Runs fn whenever Tensor::backward has finished accumulating into this tensor's grad,
+    // before any node upstream of it runs. Only the outermost backward on a thread calls it,
+    // not the nested ones of e.g. checkpoint; Tape::backward does not either. nullptr removes it.
+    void setGradReadyHook(std::function<void()> fn);
     const std::vector<double>& getGrad() const;
     std::vector<double>& getMutableGrad() const;
     double& gradAt(const std::vector<int>& indices) const;
+
+    // Forward-mode AD (see autograd/ForwardAD.hpp) //
+    bool hasTangent() const;
+    const std::vector<double>& getTangent() const;
+    void setTangent(const std::vector<double>& tangent);
+    void clearTangent();
+
+    // Unchecked fixed-rank access for kernels (see TensorAccessor.hpp)
+    template <int Rank> TensorAccessor<double, Rank> accessor() const;
+    template <int Rank> TensorAccessor<double, Rank> gradAccessor() const;
     void zero_grad();
     void backward();
 
     // Operations //
-    Tensor reshape(const std::vector<int>& new_shape) const;
+    Tensor reshape(const DimVector& new_shape) const;
     Tensor slice(const std::vector<std::pair<int, int>>& ranges) const;
+    Tensor to(DType dtype) const;   // differentiable, see ops::cast
+    Tensor detach() const;          // copy of the values as a new leaf (no graph, requires_grad = false)
 
     // Operator Overloads untuk kemudahan sintaks //
     Tensor operator+(const Tensor& other) const;
@@ -106,4 +167,29 @@ public:
     void shrink_to_fit();
 };
 
+template <int Rank>
+TensorAccessor<double, Rank> TensorImpl::dataAccessor() {
+    if (static_cast<int>(shape.size()) != Rank) throw std::invalid_argument("Accessor rank does not match tensor rank!");
+    return TensorAccessor<double, Rank>(data.data(), shape.data(), strides.data());
+}
+
+template <int Rank>
+TensorAccessor<double, Rank> TensorImpl::gradAccessor() {
+    if (static_cast<int>(shape.size()) != Rank) throw std::invalid_argument("Accessor rank does not match tensor rank!");
+    return TensorAccessor<double, Rank>(grad.data(), shape.data(), strides.data());
+}
+
+template <int Rank>
+TensorAccessor<double, Rank> Tensor::accessor() const {
+    if (!impl) throw std::runtime_error("Uninitialized Tensor");
+    if (impl->dtype != DType::Float64) throw std::runtime_error("accessor() requires a float64 tensor!");
+    return impl->dataAccessor<Rank>();
+}
+
+template <int Rank>
+TensorAccessor<double, Rank> Tensor::gradAccessor() const {
+    if (!impl) throw std::runtime_error("Uninitialized Tensor");
+    return impl->gradAccessor<Rank>();
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef TENSOR_ACCESSOR_HPP
+#define TENSOR_ACCESSOR_HPP
+
+#include <array>
+#include <stdexcept>
+#include <string>
+
+// Fixed-rank view over a contiguous buffer for hot loops.
+// Strides are copied once at construction; element access does no allocation and
+// no rank check. Bounds are only checked in debug builds (NDEBUG not defined).
+//
+//   auto A = a.accessor<2>();
+//   for (int i = 0; i < A.size(0); ++i) {
+//       double* row = A.row(i);
+//       for (int j = 0; j < A.size(1); ++j) row[j] *= 2.0;
+//   }
+template <typename T, int Rank>
+class TensorAccessor {
+    static_assert(Rank >= 1, "TensorAccessor needs Rank >= 1");
+
+private:
+    T* ptr;
+    int sizes[Rank];
+    int strides[Rank];
+
+    template <int D>
+    int offset() const { return 0; }
+
+    template <int D, typename... Rest>
+    int offset(int i, Rest... rest) const {
+#ifndef NDEBUG
+        if (i < 0 || i >= sizes[D]) {
+            throw std::out_of_range("Index out of bounds for dimensional " + std::to_string(D));
+        }
+#endif
+        return i * strides[D] + offset<D + 1>(rest...);
+    }
+
+public:
+    TensorAccessor(T* data, const int* shape, const int* strides_in) : ptr(data) {
+        for (int d = 0; d < Rank; ++d) {
+            sizes[d] = shape[d];
+            strides[d] = strides_in[d];
+        }
+    }
+
+    // Row-major view over a flat buffer, e.g. a [rows, cols] view of an N-D tensor.
+    TensorAccessor(T* data, const std::array<int, Rank>& shape) : ptr(data) {
+        int stride = 1;
+        for (int d = Rank - 1; d >= 0; --d) {
+            sizes[d] = shape[d];
+            strides[d] = stride;
+            stride *= shape[d];
+        }
+    }
+
+    template <typename... Idx>
+    T& operator()(Idx... idx) const {
+        static_assert(sizeof...(Idx) == Rank, "Wrong number of indices for accessor rank");
+        return ptr[offset<0>(static_cast<int>(idx)...)];
+    }
+
+    // Pointer to the innermost row selected by the leading Rank-1 indices.
+    template <typename... Idx>
+    T* row(Idx... idx) const {
+        static_assert(sizeof...(Idx) == Rank - 1, "row() takes Rank-1 indices");
+        return ptr + offset<0>(static_cast<int>(idx)...);
+    }
+
+    T* data() const { return ptr; }
+    int size(int d) const { return sizes[d]; }
+    int stride(int d) const { return strides[d]; }
+};
+
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+#include "../Tensor.hpp"
+#include <vector>
+
+// Dynamic loss scaling for Float16 training.
+//
+// The loss is multiplied by `scale` before backward so small gradients stay above
+// the fp16 subnormal range. If any gradient overflows, the step is skipped and the
+// scale is cut by backoff_factor; after growth_interval clean steps it grows again.
+namespace amp {
+
+struct GradScalerOptions {
+    double init_scale = 65536.0;
+    double growth_factor = 2.0;
+    double backoff_factor = 0.5;
+    int growth_interval = 2000;
+};
+
+class GradScaler {
+private:
+    GradScalerOptions opt;
+    double current_scale;
+    int clean_steps = 0;
+    int skipped = 0;
+    bool enabled;
+
+public:
+    explicit GradScaler(GradScalerOptions options = {}, bool enabled = true);
+
+    Tensor scale(const Tensor& loss) const;   // loss * scale (loss itself when disabled)
+
+    // Divides each parameter's grad by the scale; false if any value is inf or NaN.
+    bool unscale(const std::vector<Tensor>& params) const;
+    void update(bool grads_finite);
+
+    double getScale() const { return enabled ? current_scale : 1.0; }
+    int skippedSteps() const { return skipped; }
+    bool isEnabled() const { return enabled; }
+};
+
+} // namespace amp
@@ -0,0 +1,44 @@
+#pragma once
+#include "../Tensor.hpp"
+#include "GradScaler.hpp"
+#include <vector>
+
+// SGD (with optional momentum) over float64 master weights and 16-bit model copies.
+//
+//   amp::MixedPrecisionSGD opt({W1, W2}, DType::Float16, 0.05);
+//   const auto& p = opt.params();                      // Float16 copies of W1, W2
+//   Tensor loss = ops::mean(ops::cast(model(x, p), DType::Float64) ...);
+//   opt.backward(loss);                                // scaled backward
+//   opt.step();                                        // false when the step was skipped
+//
+// Updates are applied to the masters and then rounded into the copies, so
+// increments smaller than one 16-bit ulp are not lost. Loss scaling is only
+// enabled for Float16; BFloat16 has the float32 exponent range.
+namespace amp {
+
+class MixedPrecisionSGD {
+private:
+    std::vector<Tensor> master;
+    std::vector<Tensor> model;
+    std::vector<std::vector<double>> velocity;
+    double lr;
+    double momentum;
+    GradScaler scaler;
+
+    void refreshModel(size_t i);
+
+public:
+    MixedPrecisionSGD(const std::vector<Tensor>& master_params, DType dtype, double lr, double momentum = 0.0,
+                      GradScalerOptions scaler_options = {});
+
+    const std::vector<Tensor>& params() const { return model; }
+    const std::vector<Tensor>& masterParams() const { return master; }
+    const GradScaler& gradScaler() const { return scaler; }
+
+    void backward(const Tensor& loss);
+    // Unscales the model grads, skips the update on inf/NaN, then zeroes the grads.
+    bool step();
+    void zero_grad();
+};
+
+} // namespace amp
@@ -0,0 +1,25 @@
+#pragma once
+#include "../Tensor.hpp"
+#include <functional>
+#include <vector>
+
+// Activation checkpointing: recompute a segment in backward instead of keeping
+// its intermediates alive.
+//
+//   Tensor h = autograd::checkpoint([](const std::vector<Tensor>& in) {
+//       return ops::tanh(ops::matmul(ops::tanh(ops::matmul(in[0], in[1])), in[2]));
+//   }, {x, W1, W2});
+//
+// fn first runs under NoGradGuard, so only `inputs` and the output are kept.
+// When the output's gradient arrives, fn runs again with grad enabled (non-leaf
+// inputs are detached first), that local graph is backpropagated and freed, and
+// the input gradients are accumulated. fn must be deterministic apart from draws
+// from rng::defaultGenerator(), which are replayed; every tensor that needs a
+// gradient must be passed through `inputs`.
+namespace autograd {
+
+using CheckpointFn = std::function<Tensor(const std::vector<Tensor>&)>;
+
+Tensor checkpoint(CheckpointFn fn, const std::vector<Tensor>& inputs);
+
+} // namespace autograd
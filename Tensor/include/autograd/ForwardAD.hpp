@@ -0,0 +1,36 @@
+#pragma once
+#include "../Tensor.hpp"
+#include <functional>
+#include <vector>
+
+// Forward-mode AD: each tensor may carry a tangent (a directional derivative of
+// its values), and every op in ops/ pushes tangents forward alongside the values.
+// One forward pass gives J * v for a chosen input direction v, so a full Jacobian
+// costs one pass per input element instead of one backward pass per output.
+//
+//   auto r = autograd::jvp([](const std::vector<Tensor>& in) {
+//       return ops::tanh(ops::matmul(in[0], in[1]));
+//   }, {x, W}, {dx, Tensor::zeros(W.getShape())});
+//   // r.output = tanh(x W), r.tangent = d/de tanh((x + e dx) W) at e = 0
+//
+//   Tensor J = autograd::jacfwd(f, {x, W});  // shape f(x, W).shape ++ x.shape
+//
+// fn runs under NoGradGuard on detached copies of the primals; no reverse graph
+// is built. Tangents are float64 only.
+namespace autograd {
+
+using ForwardFn = std::function<Tensor(const std::vector<Tensor>&)>;
+
+struct JvpResult {
+    Tensor output;
+    Tensor tangent;     // same shape as output
+};
+
+// An uninitialized Tensor() in `tangents` stands for a zero tangent.
+JvpResult jvp(const ForwardFn& fn, const std::vector<Tensor>& primals, const std::vector<Tensor>& tangents);
+
+// Jacobian of fn with respect to primals[argnum], one forward pass per element of
+// that input. The result has shape output.shape ++ primals[argnum].shape.
+Tensor jacfwd(const ForwardFn& fn, const std::vector<Tensor>& primals, int argnum = 0);
+
+} // namespace autograd
@@ -0,0 +1,27 @@
+#pragma once
+#include "../Tensor.hpp"
+#include <vector>
+
+// Functional gradients with optional higher-order support.
+//
+//   auto g = autograd::grad(loss, {W1, W2}, true);       // g[i] are graph nodes
+//   Tensor gv = ops::sum(g[0] * v0) + ops::sum(g[1] * v1);
+//   auto Hv = autograd::grad(gv, {W1, W2});              // Hessian-vector product
+//
+//   auto Hv = autograd::hvp(loss, {W1, W2}, {v0, v1});   // same thing
+//
+// Unlike Tensor::backward this leaves every .grad untouched and returns the
+// gradients. It walks the per-op vjp closures, which compute the gradient with
+// ops: with create_graph the results are differentiable (second derivatives and
+// beyond), otherwise they are plain values. Ops without a differentiable backward
+// (16-bit dtypes, checkpoint) throw. Inputs the output does not depend on get zeros.
+namespace autograd {
+
+std::vector<Tensor> grad(const Tensor& output, const std::vector<Tensor>& inputs, bool create_graph = false,
+                         const Tensor& grad_output = Tensor());
+
+// H v for the Hessian of a scalar loss w.r.t. params, by double backward:
+// grad(sum_i <grad(loss, params_i), v_i>, params).
+std::vector<Tensor> hvp(const Tensor& loss, const std::vector<Tensor>& params, const std::vector<Tensor>& v);
+
+} // namespace autograd
@@ -0,0 +1,41 @@
+#pragma once
+
+// Thread-local switch for graph recording.
+//
+//   {
+//       autograd::NoGradGuard no_grad;
+//       Tensor y = model(x);          // no parents, no closures, requires_grad = false
+//   }
+//
+// Ops still compute their outputs; attach_*_backward just skips the graph.
+namespace autograd {
+
+namespace detail {
+    inline thread_local bool grad_enabled = true;
+}
+
+inline bool isGradEnabled() { return detail::grad_enabled; }
+
+class NoGradGuard {
+private:
+    bool prev;
+
+public:
+    NoGradGuard() : prev(detail::grad_enabled) { detail::grad_enabled = false; }
+    ~NoGradGuard() { detail::grad_enabled = prev; }
+    NoGradGuard(const NoGradGuard&) = delete;
+    NoGradGuard& operator=(const NoGradGuard&) = delete;
+};
+
+class EnableGradGuard {
+private:
+    bool prev;
+
+public:
+    EnableGradGuard() : prev(detail::grad_enabled) { detail::grad_enabled = true; }
+    ~EnableGradGuard() { detail::grad_enabled = prev; }
+    EnableGradGuard(const EnableGradGuard&) = delete;
+    EnableGradGuard& operator=(const EnableGradGuard&) = delete;
+};
+
+} // namespace autograd
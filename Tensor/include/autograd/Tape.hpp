@@ -0,0 +1,87 @@
+#pragma once
+#include "../Tensor.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Tape-based alternative to the closure graph.
+//
+//   autograd::Tape tape;
+//   {
+//       autograd::TapeGuard record(tape);
+//       loss = ops::sum(ops::tanh(x * w + b));
+//   }
+//   tape.backward(loss);   // gradients land in x/w/b.getGrad(), as with loss.backward()
+//   tape.clear();          // drops the recorded tensors, keeps the capacity
+//
+// While a TapeGuard is active on a thread, the common float64 ops (elementwise,
+// scalar-operand, sum/mean, 1D/2D matmul) append a TapeNode instead of allocating
+// a backward closure, and their outputs get no parents. Tape::backward walks the
+// nodes in reverse recording order and dispatches on the op code. Any other op
+// keeps its closure and is recorded as a Closure node that calls it, so every op
+// works under a tape. Tape outputs have no closure graph: call tape.backward(loss),
+// not loss.backward(), and autograd::grad / create_graph do not see them.
+namespace autograd {
+
+enum class TapeOp : uint8_t {
+    Add, Sub, Mul, Div,     // tensor operands; a single-element operand may be broadcast
+    AddScalar,              // x + c and x - c
+    MulScalar, DivScalar,   // constant in TapeNode::scalar
+    Neg, Exp, Log, Sin, Cos, Tanh, Sigmoid, Relu,
+    Sum, Mean,
+    Dot, Matmul,
+    Closure                 // out's backward_fn
+};
+
+struct TapeNode {
+    TapeOp op;
+    int32_t out;
+    int32_t in0;            // -1 when unused
+    int32_t in1;
+    double scalar;
+};
+
+class Tape {
+public:
+    Tape() = default;
+    ~Tape();
+    Tape(const Tape&) = delete;
+    Tape& operator=(const Tape&) = delete;
+
+    void record(TapeOp op, const Tensor& out, const Tensor& a, const Tensor* b = nullptr, double scalar = 0.0);
+    void recordClosure(const Tensor& out);
+
+    // Seeds loss.grad with ones if it is all zero, then runs every node in reverse.
+    void backward(const Tensor& loss);
+    void clear();
+
+    size_t size() const { return nodes.size(); }
+    // Bytes held by the node records and tensor slots (capacity, not size).
+    size_t bytes() const;
+
+private:
+    std::vector<TapeNode> nodes;
+    std::vector<std::shared_ptr<TensorImpl>> values;
+
+    int32_t slot(const Tensor& t);
+};
+
+namespace detail {
+    inline thread_local Tape* active_tape = nullptr;
+}
+
+// Tape recording on this thread, or nullptr.
+inline Tape* activeTape() { return detail::active_tape; }
+
+class TapeGuard {
+private:
+    Tape* prev;
+
+public:
+    explicit TapeGuard(Tape& tape) : prev(detail::active_tape) { detail::active_tape = &tape; }
+    ~TapeGuard() { detail::active_tape = prev; }
+    TapeGuard(const TapeGuard&) = delete;
+    TapeGuard& operator=(const TapeGuard&) = delete;
+};
+
+} // namespace autograd
@@ -0,0 +1,95 @@
+#pragma once
+#include "../Tensor.hpp"
+#include "Dataset.hpp"
+#include "SpscQueue.hpp"
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <cstdint>
+
+namespace data {
+
+struct DataLoaderOptions {
+    int batch_size = 32;
+    bool shuffle = true;
+    uint64_t seed = 0;
+    int num_workers = 2;     // 0 = build batches synchronously inside next()
+    int prefetch_depth = 4;  // batches ready ahead of the consumer, over all workers
+    bool drop_last = false;
+};
+
+struct Batch {
+    Tensor inputs;    // [batch, ...inputShape]
+    Tensor targets;   // [batch, ...targetShape]
+    int index = -1;
+};
+
+// Shuffles the dataset with a seeded permutation and hands out batches in order.
+// Worker w assembles batches w, w + N, w + 2N, ... into pooled tensors and pushes
+// them onto its own SPSC ring, so the consumer pops them back in sequence without
+// locking. A side that finds its ring empty (consumer) or full (worker) spins briefly,
+// then sleeps until the other side signals. A pooled buffer is reused once nothing but the pool references it
+// (i.e. the batch and any graph built on it were dropped).
+class DataLoader {
+private:
+    struct Slot {
+        std::shared_ptr<TensorImpl> inputs;
+        std::shared_ptr<TensorImpl> targets;
+        bool reserved = false;
+    };
+
+    const Dataset& dataset;
+    DataLoaderOptions options;
+    std::vector<int> batch_input_shape;
+    std::vector<int> batch_target_shape;
+    int input_size;
+    int target_size;
+
+    std::vector<size_t> perm;
+    int num_batches;
+    int next_batch;
+
+    std::mutex pool_mutex;
+    std::vector<std::unique_ptr<Slot>> pool;
+
+    std::vector<std::unique_ptr<SpscQueue<Batch>>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<bool> stop{false};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    std::mutex wait_mutex;                  // only for sleeping on the two conditions below
+    std::condition_variable batch_ready;    // a worker pushed a batch or failed
+    std::condition_variable slot_free;      // the consumer popped a batch, or stop was set
+
+    Slot* acquireSlot();
+    void releaseSlot(Slot* slot);
+    Batch assemble(int batch_index);
+    void workerLoop(int worker_id);
+    void stopWorkers();
+    void rethrowWorkerError();
+    bool hasWorkerError();
+    void signal(std::condition_variable& cv);
+
+public:
+    DataLoader(const Dataset& dataset, const DataLoaderOptions& options = DataLoaderOptions());
+    ~DataLoader();
+
+    DataLoader(const DataLoader&) = delete;
+    DataLoader& operator=(const DataLoader&) = delete;
+
+    // Reshuffles with (seed, epoch) and restarts prefetching from the first batch.
+    void startEpoch(int epoch);
+
+    // Returns false once the epoch is exhausted.
+    bool next(Batch& batch);
+
+    int numBatches() const { return num_batches; }
+    size_t poolSize();
+    const std::vector<size_t>& permutation() const { return perm; }
+};
+
+} // namespace data
@@ -0,0 +1,61 @@
+#pragma once
+#include "../Tensor.hpp"
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+
+namespace data {
+
+// Random-access source of (input, target) samples.
+// load() writes one sample straight into the batch buffers, so any per-sample
+// transform should happen there and must be safe to call from several threads.
+class Dataset {
+public:
+    virtual ~Dataset() = default;
+
+    virtual size_t size() const = 0;
+    virtual std::vector<int> inputShape() const = 0;
+    virtual std::vector<int> targetShape() const = 0;
+    virtual void load(size_t index, double* input, double* target) const = 0;
+};
+
+// Dataset over two in-memory tensors whose first dimension is the sample index.
+class TensorDataset : public Dataset {
+private:
+    Tensor inputs;
+    Tensor targets;
+    int input_stride;
+    int target_stride;
+
+public:
+    TensorDataset(const Tensor& inputs, const Tensor& targets)
+        : inputs(inputs), targets(targets) {
+        if (inputs.rank() == 0 || targets.rank() == 0 ||
+            inputs.getShape()[0] != targets.getShape()[0]) {
+            throw std::invalid_argument("TensorDataset: inputs and targets must share the first dimension!");
+        }
+        input_stride = inputs.size() / inputs.getShape()[0];
+        target_stride = targets.size() / targets.getShape()[0];
+    }
+
+    size_t size() const override { return static_cast<size_t>(inputs.getShape()[0]); }
+
+    std::vector<int> inputShape() const override {
+        auto shape = inputs.getShape();
+        return std::vector<int>(shape.begin() + 1, shape.end());
+    }
+
+    std::vector<int> targetShape() const override {
+        auto shape = targets.getShape();
+        return std::vector<int>(shape.begin() + 1, shape.end());
+    }
+
+    void load(size_t index, double* input, double* target) const override {
+        const double* src_in = inputs.getData().data() + index * input_stride;
+        const double* src_tg = targets.getData().data() + index * target_stride;
+        for (int i = 0; i < input_stride; ++i) input[i] = src_in[i];
+        for (int i = 0; i < target_stride; ++i) target[i] = src_tg[i];
+    }
+};
+
+} // namespace data
@@ -0,0 +1,47 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+namespace data {
+
+// Bounded single-producer / single-consumer ring buffer.
+// Neither side ever takes a lock: the producer owns `tail`, the consumer owns `head`.
+template <typename T>
+class SpscQueue {
+private:
+    std::vector<T> ring;
+    size_t slots;
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+
+public:
+    explicit SpscQueue(size_t capacity) : ring(capacity + 1), slots(capacity + 1) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Moves from `item` only when there was room.
+    bool try_push(T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t next = (t + 1) % slots;
+        if (next == head.load(std::memory_order_acquire)) return false;
+        ring[t] = std::move(item);
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        item = std::move(ring[h]);
+        ring[h] = T();
+        head.store((h + 1) % slots, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return slots - 1; }
+};
+
+} // namespace data
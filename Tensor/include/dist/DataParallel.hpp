@@ -0,0 +1,68 @@
+#pragma once
+#include "../Tensor.hpp"
+#include "../stream/Stream.hpp"
+#include "ProcessGroup.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Data-parallel training: every rank runs the same model on its own shard of the batch,
+// and backward() leaves each parameter's grad averaged over the ranks.
+//
+//   dist::ProcessGroup group(dist::launchInfo());
+//   dist::DataParallel ddp(group, {W1, b1, W2, b2});     // broadcasts rank 0's values
+//   Tensor loss = model(shard_x, shard_y);
+//   ddp.backward(loss);                                  // loss.backward() + gradient all-reduce
+//   optimizer step on W1, b1, ...; zero their grads
+//
+// Parameters are packed into buckets of about bucket_bytes, last parameter first, since
+// backward usually finishes them in that order. A grad-ready hook per parameter counts
+// down its bucket; a full bucket is all-reduced on a communication stream while the rest
+// of backward still runs. Buckets are launched strictly in order, so all ranks issue the
+// same collectives even if their hooks fire in a different order. Parameters that
+// backward never reaches are reduced as they are (zero or previously accumulated).
+// Parameters used inside autograd::checkpoint must be among its inputs, so the outer
+// backward reaches them after the segment's nested backward.
+namespace dist {
+
+struct DataParallelOptions {
+    size_t bucket_bytes = size_t(1) << 20;
+    bool average = true;   // false: sum instead of mean over ranks
+};
+
+class DataParallel {
+private:
+    struct Bucket {
+        std::vector<int> params;
+        std::vector<double> flat;
+        int pending = 0;
+    };
+
+    ProcessGroup& group;
+    std::vector<Tensor> params;
+    DataParallelOptions options;
+    std::vector<Bucket> buckets;
+    std::vector<int> bucket_of;
+    std::vector<char> marked;   // hook already counted this backward
+    int next_launch = 0;
+    std::vector<stream::Future<void>> inflight;
+    std::unique_ptr<stream::Stream> comm;
+
+    void markReady(int param);
+    void launch(int bucket);
+
+public:
+    DataParallel(ProcessGroup& group, const std::vector<Tensor>& parameters,
+                 const DataParallelOptions& options = DataParallelOptions());
+    ~DataParallel();
+
+    DataParallel(const DataParallel&) = delete;
+    DataParallel& operator=(const DataParallel&) = delete;
+
+    // Runs loss.backward() and returns once every parameter grad has been reduced.
+    void backward(const Tensor& loss);
+    size_t numBuckets() const { return buckets.size(); }
+    ProcessGroup& processGroup() { return group; }
+};
+
+} // namespace dist
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Collectives between the processes of one host over a POSIX shared-memory segment.
+//
+//   int main(int argc, char** argv) {
+//       dist::LaunchInfo info = dist::launchInfo();
+//       std::vector<int> workers;
+//       if (info.rank == 0) workers = dist::spawnWorkers(4, argv);   // ranks 1..3 rerun main
+//       dist::ProcessGroup group(dist::launchInfo());
+//       group.allReduce(buf.data(), buf.size());                     // sum over all ranks
+//       ...
+//       if (info.rank == 0) dist::waitWorkers(workers);
+//   }
+//
+// Every rank owns two slots of slot_elements doubles in the segment. allReduce is a ring:
+// the buffer is cut into world_size chunks, reduce-scattered in world_size - 1 steps (each
+// rank adds the chunk its predecessor left in a slot) and all-gathered in as many more.
+// Slots alternate between steps, so one barrier per step suffices. Every rank ends with
+// the same bits. Buffers longer than world_size * slot_elements go through in pieces.
+// All ranks must issue the same collectives in the same order. POSIX (Linux, macOS) only.
+namespace dist {
+
+// Set by spawnWorkers through TENSOR_DIST_RANK / TENSOR_DIST_WORLD_SIZE / TENSOR_DIST_NAME.
+// A process started without them is rank 0 of 1 (and spawnWorkers picks the name).
+struct LaunchInfo {
+    int rank = 0;
+    int world_size = 1;
+    std::string name;
+};
+
+LaunchInfo launchInfo();
+
+// Starts ranks 1..world_size-1 as copies of this executable with the same argv, and makes
+// the caller rank 0 of world_size (launchInfo() reflects it afterwards). Returns their pids.
+std::vector<int> spawnWorkers(int world_size, char** argv);
+// Waits for the spawned ranks; false if any of them failed.
+bool waitWorkers(const std::vector<int>& pids);
+
+class ProcessGroup {
+private:
+    struct Header;
+
+    int rank_;
+    int world_;
+    size_t slot_elements_;
+    std::string name_;
+    void* mapping = nullptr;
+    size_t mapping_bytes = 0;
+    Header* header = nullptr;
+    int step = 0;   // collective steps issued so far: selects the slot parity
+
+    double* slot(int rank, int parity) const;
+
+public:
+    explicit ProcessGroup(const LaunchInfo& info, size_t slot_elements = size_t(1) << 16);
+    ~ProcessGroup();
+
+    ProcessGroup(const ProcessGroup&) = delete;
+    ProcessGroup& operator=(const ProcessGroup&) = delete;
+
+    int rank() const { return rank_; }
+    int size() const { return world_; }
+
+    void barrier();
+    // In place: data[i] = sum over ranks of data[i].
+    void allReduce(double* data, size_t n);
+    // In place: every rank gets root's data.
+    void broadcast(double* data, size_t n, int root = 0);
+};
+
+} // namespace dist
@@ -1,20 +1,76 @@
 #pragma once
 #include "../Tensor.hpp"
+#include "../utils/Profiler.hpp"
+#include "../utils/MemoryTracker.hpp"
+#include "../autograd/GradMode.hpp"
+#include "../autograd/Tape.hpp"
+#include "sum.hpp"
 #include <functional>
+#include <type_traits>
+#include <utility>
 
 namespace ops {
 
-inline void attach_binary_backward(Tensor& out, const Tensor& a, const Tensor& b, std::function<void()> bwd) {
-    if (!out.requiresGrad()) return;
-    out.getImpl()->parents.push_back(a);
-    out.getImpl()->parents.push_back(b);
-    out.getImpl()->backward_fn = bwd;
+// Graph metadata charged to `out`: parent handles plus the closure's captures.
+template <typename F>
+inline void attach_backward_fn(Tensor& out, F&& bwd) {
+    TensorImpl& impl = *out.getImpl();
+    if (profiler::enabled()) impl.backward_fn = profiler::instrumentBackward(std::function<void()>(std::forward<F>(bwd)));
+    else impl.backward_fn = std::forward<F>(bwd);
+    memory::onGraphAttach(impl, impl.parents.size() * sizeof(Tensor) + sizeof(std::decay_t<F>));
+    if (autograd::Tape* tape = autograd::activeTape()) tape->recordClosure(out);
+}
+
+// Under autograd::NoGradGuard outputs are plain values: no parents, requires_grad = false.
+inline bool should_record(Tensor& out) {
+    if (!out.requiresGrad()) return false;
+    if (autograd::isGradEnabled()) return true;
+    out.setRequiresGrad(false);
+    return false;
 }
 
-inline void attach_unary_backward(Tensor& out, const Tensor& a, std::function<void()> bwd) {
-    if (!out.requiresGrad()) return;
+// Under an autograd::TapeGuard, ops with a tape kernel call this instead of attaching
+// a closure. True when the op is done: recorded, or nothing needs recording.
+inline bool record_on_tape(Tensor& out, autograd::TapeOp op, const Tensor& a, const Tensor* b = nullptr,
+                           double scalar = 0.0) {
+    autograd::Tape* tape = autograd::activeTape();
+    if (!tape) return false;
+    if (should_record(out)) tape->record(op, out, a, b, scalar);
+    return true;
+}
+
+template <typename F>
+inline void attach_binary_backward(Tensor& out, const Tensor& a, const Tensor& b, F&& bwd) {
+    if (!should_record(out)) return;
+    auto& parents = out.getImpl()->parents;
+    parents.reserve(2);
+    parents.push_back(a);
+    parents.push_back(b);
+    attach_backward_fn(out, std::forward<F>(bwd));
+}
+
+template <typename F>
+inline void attach_unary_backward(Tensor& out, const Tensor& a, F&& bwd) {
+    if (!should_record(out)) return;
     out.getImpl()->parents.push_back(a);
-    out.getImpl()->backward_fn = bwd;
+    attach_backward_fn(out, std::forward<F>(bwd));
+}
+
+// Differentiable backward used by autograd::grad: maps (out, parents, grad of out)
+// to one gradient per parent (Tensor() where none is needed), built from ops.
+// Only attached when the backward closure was.
+template <typename F>
+inline void attach_vjp(Tensor& out, F&& vjp) {
+    TensorImpl& impl = *out.getImpl();
+    if (!impl.backward_fn) return;
+    impl.vjp_fn = std::forward<F>(vjp);
+    memory::onGraphAttach(impl, sizeof(std::decay_t<F>));
+}
+
+// Gradient of an operand that may have been broadcast from a single element.
+inline Tensor unbroadcast(const Tensor& operand, const Tensor& grad) {
+    if (operand.size() == 1 && grad.size() != 1) return ops::sum(grad);
+    return grad;
 }
 
 } // namespace ops
@@ -0,0 +1,51 @@
+#pragma once
+#include "../Tensor.hpp"
+
+// Forward-mode AD helpers (user API in autograd/ForwardAD.hpp).
+// A tensor may carry a float64 tangent of its own size; each op fills the
+// output tangent when any input carries one. Missing tangents count as zero.
+namespace ops {
+
+inline const double* tangent_of(const Tensor& t) {
+    const auto& v = t.getImpl()->tangent;
+    return v.empty() ? nullptr : v.data();
+}
+
+inline bool has_tangent(const Tensor& t) { return !t.getImpl()->tangent.empty(); }
+
+// Zero-filled tangent buffer for `out`.
+inline double* make_tangent(Tensor& out) {
+    auto& v = out.getImpl()->tangent;
+    v.assign(out.size(), 0.0);
+    return v.data();
+}
+
+// Elementwise unary op: out_t[i] = deriv(i) * a_t[i].
+template <typename D>
+inline void unary_tangent(Tensor& out, const Tensor& a, D deriv) {
+    const double* ta = tangent_of(a);
+    if (!ta) return;
+    double* to = make_tangent(out);
+    for (int i = 0; i < out.size(); ++i) to[i] = deriv(i) * ta[i];
+}
+
+// Elementwise binary op: out_t[i] = da(i) * a_t[i] + db(i) * b_t[i], with a
+// single-element operand broadcast against a larger output.
+template <typename DA, typename DB>
+inline void binary_tangent(Tensor& out, const Tensor& a, const Tensor& b, DA da, DB db) {
+    const double* ta = tangent_of(a);
+    const double* tb = tangent_of(b);
+    if (!ta && !tb) return;
+    double* to = make_tangent(out);
+    int n = out.size();
+    bool a_bcast = a.size() == 1 && n != 1;
+    bool b_bcast = b.size() == 1 && n != 1;
+    for (int i = 0; i < n; ++i) {
+        double v = 0.0;
+        if (ta) v += da(i) * ta[a_bcast ? 0 : i];
+        if (tb) v += db(i) * tb[b_bcast ? 0 : i];
+        to[i] = v;
+    }
+}
+
+} // namespace ops
@@ -0,0 +1,72 @@
+#pragma once
+#include "../Tensor.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Shared pieces of the BFloat16 / Float16 op paths.
+// Inputs are widened to float, math and accumulation run in float, and every
+// output element is rounded to 16 bits once. Gradient buffers are float64, but
+// contributions to a 16-bit tensor's grad are rounded to its dtype first, so
+// fp16 gradients underflow and overflow as they would in 16-bit storage.
+namespace ops {
+
+inline bool isLowPrecision(const Tensor& t) { return t.dtype() != DType::Float64; }
+
+inline double roundTo(DType d, double v) { return half::decode(d, half::encode(d, static_cast<float>(v))); }
+
+// Both operands must share one 16-bit dtype and shape.
+inline DType checkLowPrecisionPair(const char* op, const Tensor& a, const Tensor& b) {
+    if (a.dtype() != b.dtype()) {
+        throw std::invalid_argument(std::string("dtype mismatch in ops::") + op + " (" + dtypeName(a.dtype()) + " vs " +
+                                    dtypeName(b.dtype()) + "); use to() first");
+    }
+    if (a.shapeView() != b.shapeView()) {
+        throw std::invalid_argument(std::string("ops::") + op + " on " + dtypeName(a.dtype()) + " requires matching shapes!");
+    }
+    return a.dtype();
+}
+
+// Float copy of a 16-bit tensor's values.
+inline std::vector<float> widen(const Tensor& t) {
+    const auto& h = t.getHalfData();
+    std::vector<float> out(h.size());
+    half::decodeRow(t.dtype(), h.data(), out.data(), h.size());
+    return out;
+}
+
+// out[i] = f(a[i])
+template <typename F>
+Tensor mapLowPrecision(const Tensor& a, bool req_grad, F f) {
+    DType d = a.dtype();
+    Tensor out(a.shapeView(), d, req_grad);
+    const auto& src = a.getHalfData();
+    auto& dst = out.getMutableHalfData();
+    for (size_t i = 0; i < src.size(); ++i) dst[i] = half::encode(d, f(half::decode(d, src[i])));
+    return out;
+}
+
+// out[i] = f(a[i], b[i])
+template <typename F>
+Tensor zipLowPrecision(const char* op, const Tensor& a, const Tensor& b, bool req_grad, F f) {
+    DType d = checkLowPrecisionPair(op, a, b);
+    Tensor out(a.shapeView(), d, req_grad);
+    const auto& ha = a.getHalfData();
+    const auto& hb = b.getHalfData();
+    auto& dst = out.getMutableHalfData();
+    for (size_t i = 0; i < ha.size(); ++i) dst[i] = half::encode(d, f(half::decode(d, ha[i]), half::decode(d, hb[i])));
+    return out;
+}
+
+// t.grad[i] += round(scale * og[i] * w[i]) with w = 1 when `weights` is null.
+inline void accumulateLowPrecisionGrad(const Tensor& t, const std::vector<double>& og, double scale,
+                                       const std::vector<float>* weights = nullptr) {
+    DType d = t.dtype();
+    auto& g = t.getMutableGrad();
+    for (size_t i = 0; i < og.size(); ++i) {
+        double w = weights ? (*weights)[i] : 1.0;
+        g[i] += roundTo(d, scale * og[i] * w);
+    }
+}
+
+} // namespace ops
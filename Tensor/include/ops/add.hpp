@@ -3,4 +3,6 @@
 
 namespace ops {
     Tensor add(const Tensor& a, const Tensor& b);
+    // Constant operand stored in the graph node: no {1} tensor, no gradient for it.
+    Tensor add(const Tensor& a, double b);
 }
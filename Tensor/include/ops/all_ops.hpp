@@ -21,9 +21,27 @@
 #include "sigmoid.hpp"
 #include "softmax.hpp"
 
+// Normalization
+#include "norm.hpp"
+
+// Embedding
+#include "embedding.hpp"
+
+// Regularization
+#include "dropout.hpp"
+
 // Linear Algebra & Reductions
 #include "matmul.hpp"
+#include "linear.hpp"
 #include "transpose.hpp"
 #include "inverse.hpp"
+#include "spmm.hpp"
 #include "sum.hpp"
 #include "mean.hpp"
+
+// Attention & Recurrent Layers
+#include "attention.hpp"
+#include "rnn.hpp"
+
+// Precision
+#include "cast.hpp"
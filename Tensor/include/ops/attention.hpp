@@ -0,0 +1,16 @@
+#pragma once
+#include "../Tensor.hpp"
+
+namespace ops {
+    // softmax(q k^T / sqrt(d) + mask) v without materializing the score matrix.
+    // q [..., Lq, d], k [..., Lk, d], v [..., Lk, dv] with equal leading (batch / head) dims;
+    // mask is an additive [Lq, Lk] float64 tensor (0 / -inf) shared by all heads, or Tensor().
+    // causal hides key j from query i when j > i without building a mask.
+    //
+    // Keys and values are streamed in tiles against tiles of queries with an online softmax;
+    // only the output and one log-sum-exp per query row are kept for backward, which
+    // recomputes the scores tile by tile. Rows with every key masked produce zeros.
+    // float64 only, no forward tangents; double backward (autograd::grad) is 2D only.
+    Tensor scaled_dot_product_attention(const Tensor& q, const Tensor& k, const Tensor& v,
+                                        const Tensor& mask = Tensor(), bool causal = false);
+}
@@ -0,0 +1,7 @@
+#pragma once
+#include "../Tensor.hpp"
+
+namespace ops {
+    // Converts storage to `dtype`; the gradient passes straight through to t.
+    Tensor cast(const Tensor& t, DType dtype);
+}
@@ -3,4 +3,6 @@
 
 namespace ops {
     Tensor div(const Tensor& a, const Tensor& b);
+    // Constant operand, see add.hpp.
+    Tensor div(const Tensor& a, double b);
 }
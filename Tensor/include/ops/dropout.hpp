@@ -0,0 +1,10 @@
+#pragma once
+#include "../Tensor.hpp"
+#include "../utils/Random.hpp"
+
+namespace ops {
+    // Zeroes each element with probability p and scales the rest by 1 / (1 - p).
+    // The mask is drawn from a Philox stream (`gen`, default generator if null)
+    // and regenerated in backward instead of stored. Identity when !training.
+    Tensor dropout(const Tensor& t, double p, bool training = true, rng::Generator* gen = nullptr);
+}
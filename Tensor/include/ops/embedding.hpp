@@ -0,0 +1,49 @@
+#pragma once
+#include "../Tensor.hpp"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ops {
+    // Gradient of a [num_rows, dim] embedding table restricted to the rows that were looked up.
+    // Rows are kept in first-touch order; values() holds one dim-wide row per entry of rows().
+    //
+    //   Tensor table = Tensor::randn({num_rows, dim});
+    //   table.releaseGrad();                              // no dense gradient buffer at all
+    //   auto grad = std::make_shared<ops::RowSparseGrad>();
+    //   Tensor e = ops::embedding(table, ids, grad);
+    //   loss(e).backward();
+    //   grad->sgdStep(table, 0.1);                        // touches only grad->rows(), then clears
+    class RowSparseGrad {
+    private:
+        int dim_ = 0;
+        std::vector<int> rows_;
+        std::vector<double> values_;
+        std::unordered_map<int, int> slot_;   // row -> position in rows_
+
+    public:
+        int dim() const { return dim_; }
+        size_t nnzRows() const { return rows_.size(); }
+        const std::vector<int>& rows() const { return rows_; }
+        const std::vector<double>& values() const { return values_; }
+        size_t bytes() const;
+
+        // values[row(indices[i])] += g[i], g being [indices.size(), dim] row-major.
+        // Duplicate indices are summed in index order, so the result does not depend on the thread count.
+        void accumulate(const std::vector<int>& indices, const double* g, int dim);
+        void clear();
+
+        // table[r] -= lr * grad[r] for every stored row, then clear().
+        void sgdStep(const Tensor& table, double lr);
+        // Dense [num_rows, dim] copy, for inspection.
+        Tensor toDense(int num_rows) const;
+    };
+
+    // out[i] = table[indices[i]]: table [num_rows, dim] -> out [indices.size(), dim], gathered in parallel.
+    // If sparse_grad is set, backward accumulates dL/dtable into it row-wise and never touches
+    // the table's dense grad, so the table need not require grad (see Tensor::releaseGrad).
+    // Otherwise a table that requires grad receives a row-wise scatter into its dense grad.
+    // float64 and first order only.
+    Tensor embedding(const Tensor& table, const std::vector<int>& indices,
+                     const std::shared_ptr<RowSparseGrad>& sparse_grad = nullptr);
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "../Tensor.hpp"
+
+namespace ops {
+    enum class Activation { None, ReLU, Sigmoid, Tanh };
+
+    // act(x @ W + b) as one graph node: x [batch, in], W [in, out], b [out] or [1, out]
+    // (Tensor() for none). Bias and activation are applied to each output row right after
+    // its GEMM accumulation; backward takes a single pass over the output gradient.
+    // float64 only.
+    Tensor linear(const Tensor& x, const Tensor& W, const Tensor& b = Tensor(), Activation act = Activation::None);
+}
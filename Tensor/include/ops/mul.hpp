@@ -3,4 +3,6 @@
 
 namespace ops {
     Tensor mul(const Tensor& a, const Tensor& b);
+    // Constant operand, see add.hpp.
+    Tensor mul(const Tensor& a, double b);
 }
@@ -0,0 +1,20 @@
+#pragma once
+#include "../Tensor.hpp"
+
+namespace ops {
+    // Normalizes each row of x [..., N] over its last dim: (x - mean) / sqrt(var + eps) * gamma + beta.
+    // gamma / beta are [N] (Tensor() for none). Statistics come from one Welford pass per row;
+    // rows are split across threads. float64 and first order only.
+    Tensor layer_norm(const Tensor& x, const Tensor& gamma = Tensor(), const Tensor& beta = Tensor(),
+                      double eps = 1e-5);
+
+    // Per-channel normalization of x [batch, C, ...] over the batch and trailing dims.
+    // training: batch statistics (one Welford pass per channel, biased variance), and when
+    //   running_mean / running_var [C] are given they are updated in place:
+    //   r = (1 - momentum) * r + momentum * stat, with the unbiased variance.
+    // otherwise: running_mean / running_var are required and used as constants.
+    // Channels are split across threads. float64 and first order only.
+    Tensor batch_norm(const Tensor& x, const Tensor& running_mean, const Tensor& running_var,
+                      const Tensor& gamma = Tensor(), const Tensor& beta = Tensor(), bool training = true,
+                      double momentum = 0.1, double eps = 1e-5);
+}
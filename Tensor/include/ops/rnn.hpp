@@ -0,0 +1,38 @@
+#pragma once
+#include "../Tensor.hpp"
+
+namespace ops {
+    // Hidden and cell state, each [batch, hidden].
+    struct LSTMState {
+        Tensor h;
+        Tensor c;
+    };
+
+    struct LSTMOutput {
+        Tensor output;      // [steps, batch, hidden]: h of every step
+        LSTMState state;    // h and c after the last step
+    };
+
+    // Weights hold the four gates side by side in the order i, f, g, o:
+    // W_ih [in, 4*hidden], W_hh [hidden, 4*hidden], b [4*hidden] or [1, 4*hidden] (Tensor() for none).
+    //   i, f, o = sigmoid(.), g = tanh(.), c' = f * c + i * g, h' = o * tanh(c')
+    //
+    // lstm runs a whole sequence x [steps, batch, in] as one node: a single input-projection
+    // GEMM for all steps, then one recurrent GEMM row and the gate math per step. Backward
+    // through time is a single reverse sweep with the weight gradients batched at the end.
+    // An empty state starts from zeros.
+    // lstm_cell is the same kernel for one step (x [batch, in]).
+    // Both are float64 and first order only: no forward tangents or autograd::grad.
+    LSTMOutput lstm(const Tensor& x, const LSTMState& state, const Tensor& W_ih, const Tensor& W_hh,
+                    const Tensor& b = Tensor());
+    LSTMState lstm_cell(const Tensor& x, const LSTMState& state, const Tensor& W_ih, const Tensor& W_hh,
+                        const Tensor& b = Tensor());
+
+    // One GRU step as a single node, gates in the order r, z, n:
+    // W_ih [in, 3*hidden], W_hh [hidden, 3*hidden], biases [3*hidden] or [1, 3*hidden].
+    //   r, z = sigmoid(x W_i + b_i + h W_h + b_h), n = tanh(x W_in + b_in + r * (h W_hn + b_hn))
+    //   h' = (1 - z) * n + z * h
+    // float64 and first order only, like lstm.
+    Tensor gru_cell(const Tensor& x, const Tensor& h, const Tensor& W_ih, const Tensor& W_hh,
+                    const Tensor& b_ih = Tensor(), const Tensor& b_hh = Tensor());
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include "../Tensor.hpp"
+#include "../SparseTensor.hpp"
+
+namespace ops {
+    // Sparse x dense product; gradients flow to the dense operand only.
+    Tensor matmul(const SparseTensor& a, const Tensor& b);
+}
@@ -3,4 +3,6 @@
 
 namespace ops {
     Tensor sub(const Tensor& a, const Tensor& b);
+    // Constant operand, see add.hpp.
+    Tensor sub(const Tensor& a, double b);
 }
@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+// int8 x int8 -> int32 GEMM with zero-point correction.
+//
+//   C[i, j] = sum_k (A[i, k] - a_zp) * (B[j, k] - b_zp[j])
+//
+// A is row-major [M, K]; B is the weight packed as [N, K] so both operands are
+// read along K. b_colsum[j] = sum_k B[j, k] is precomputed once per weight.
+// Rows of A are split across the parallel:: pool.
+namespace quant {
+
+void gemm_s8s8s32(int M, int N, int K, const int8_t* A, int32_t a_zp, const int8_t* B, const int32_t* b_zp,
+                  const int32_t* b_colsum, int32_t* C);
+
+} // namespace quant
@@ -0,0 +1,66 @@
+#pragma once
+#include "../Tensor.hpp"
+#include <cstdint>
+#include <vector>
+
+// Post-training INT8 quantization: real = scale * (q - zero_point), q in [-128, 127].
+//
+//   quant::Observer obs(quant::QScheme::PerTensorAffine);
+//   for (const Tensor& batch : calibration_set) obs.observe(batch);
+//   quant::QParams p = obs.calculate();
+//   quant::QTensor q = quant::quantize(x, p);
+//   Tensor back = quant::dequantize(q);
+namespace quant {
+
+enum class QScheme {
+    PerTensorAffine,       // activations: one (scale, zero_point) covering [min, max]
+    PerTensorSymmetric,    // zero_point = 0, range [-127, 127]
+    PerChannelSymmetric,   // weights: one scale per slice along `axis`, zero_point = 0
+    PerChannelAffine
+};
+
+struct QParams {
+    std::vector<double> scale;        // 1 entry, or one per channel
+    std::vector<int32_t> zero_point;  // same length as scale
+    int axis = -1;                    // channel axis, -1 for per-tensor
+
+    bool perChannel() const { return axis >= 0; }
+    int channels() const { return static_cast<int>(scale.size()); }
+};
+
+struct QTensor {
+    std::vector<int8_t> data;
+    std::vector<int> shape;
+    QParams params;
+
+    int size() const { return static_cast<int>(data.size()); }
+};
+
+// Chooses (scale, zero_point) so that [min_val, max_val] (widened to include 0) maps onto int8.
+QParams chooseParams(double min_val, double max_val, bool symmetric);
+
+// Running min/max over calibration samples.
+class Observer {
+private:
+    QScheme scheme;
+    int axis;
+    std::vector<double> mins;
+    std::vector<double> maxs;
+
+public:
+    // axis is only used by the per-channel schemes.
+    explicit Observer(QScheme scheme = QScheme::PerTensorAffine, int axis = -1);
+
+    void observe(const Tensor& t);
+    QParams calculate() const;
+    void reset();
+    bool empty() const { return mins.empty(); }
+};
+
+// One-shot calibration of a single tensor (typically a weight).
+QParams calibrate(const Tensor& t, QScheme scheme, int axis = -1);
+
+QTensor quantize(const Tensor& t, const QParams& params);
+Tensor dequantize(const QTensor& q);
+
+} // namespace quant
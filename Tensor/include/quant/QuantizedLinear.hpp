@@ -0,0 +1,56 @@
+#pragma once
+#include "../Tensor.hpp"
+#include "Quantize.hpp"
+#include <cstdint>
+#include <vector>
+
+// Inference-only int8 version of y = act(x @ W + b), W laid out [in, out] as for ops::matmul.
+//
+//   quant::Observer obs;                            // calibrate the layer input
+//   for (const Tensor& x : samples) obs.observe(x);
+//   quant::QuantizedLinear fc(W, b, obs.calculate(), quant::Activation::ReLU);
+//   Tensor y = fc.forward(x);                       // float in, float out
+//
+// The int32 accumulator is turned into the output by a fused epilogue: scale, bias
+// and activation are applied in the same pass that either dequantizes to a Tensor
+// or requantizes to int8 for the next layer. Outputs carry no autodiff graph.
+namespace quant {
+
+enum class Activation { None, ReLU };
+
+class QuantizedLinear {
+private:
+    int in_features;
+    int out_features;
+    Activation act;
+    QParams input_params;               // per-tensor
+    QParams weight_params;              // per-tensor or per output channel
+    std::vector<int8_t> weight_packed;  // [out, in]
+    std::vector<int32_t> weight_zp;     // per output channel
+    std::vector<int32_t> weight_colsum; // sum over `in` of each packed row
+    std::vector<double> bias;
+
+    std::vector<int32_t> accumulate(const QTensor& x, int& rows) const;
+    double weightScale(int j) const;
+
+public:
+    // weight_scheme may be any QScheme; per-channel schemes use one scale per output column of W.
+    QuantizedLinear(const Tensor& weight, const Tensor& bias, const QParams& input_params,
+                    Activation act = Activation::None, QScheme weight_scheme = QScheme::PerChannelSymmetric);
+
+    QTensor quantizeInput(const Tensor& x) const;
+
+    // x: [batch, in] -> [batch, out], dequantized
+    Tensor forward(const Tensor& x) const;
+    Tensor forward(const QTensor& x) const;
+    // x: [batch, in] -> [batch, out], requantized with output_params (per-tensor)
+    QTensor forwardQuantized(const QTensor& x, const QParams& output_params) const;
+
+    int inFeatures() const { return in_features; }
+    int outFeatures() const { return out_features; }
+    const QParams& inputParams() const { return input_params; }
+    const QParams& weightParams() const { return weight_params; }
+    size_t weightBytes() const { return weight_packed.size(); }
+};
+
+} // namespace quant
@@ -0,0 +1,209 @@
+#pragma once
+#include "../Tensor.hpp"
+#include "../autograd/GradMode.hpp"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// In-order work queues, each drained by its own worker thread, so the caller can queue
+// the next batch's preparation while a large op is still running.
+//
+//   stream::Stream loader, compute;
+//   stream::AsyncTensor x = loader.enqueue(load_batch, i);                 // returns at once
+//   stream::AsyncTensor y = compute.enqueue(
+//       [](const Tensor& a, const Tensor& w) { return ops::matmul(a, w); }, x, W);
+//   stream::Event e = compute.record();
+//   const Tensor& out = y.get();         // blocks only until y is computed; rethrows its error
+//   stream::synchronize();               // drains every stream
+//
+// Work on one stream runs in submission order. A future passed as an argument is resolved
+// on the worker right before the task runs, so a task waits only for its own inputs and
+// independent streams overlap. waitEvent orders a whole stream behind an event.
+// Tasks run with the caller's grad mode at enqueue time; an active autograd::Tape does not
+// record them. Arguments share storage with the caller's tensors: do not modify those
+// until the task's future is ready.
+namespace stream {
+
+namespace detail {
+
+struct Signal {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    std::exception_ptr error;
+
+    void set(std::exception_ptr e = nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = e;
+            done = true;
+        }
+        cv.notify_all();
+    }
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return done; });
+    }
+    bool ready() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return done;
+    }
+};
+
+template <typename T>
+struct Slot : Signal {
+    std::optional<T> value;
+};
+
+template <>
+struct Slot<void> : Signal {};
+
+} // namespace detail
+
+// Completes when the work queued before it (see Stream::record) has run.
+// A default-constructed event is already complete.
+class Event {
+private:
+    std::shared_ptr<detail::Signal> signal;
+
+public:
+    Event() = default;
+    explicit Event(std::shared_ptr<detail::Signal> s) : signal(std::move(s)) {}
+
+    bool ready() const { return !signal || signal->ready(); }
+    void wait() const {
+        if (signal) signal->wait();
+    }
+};
+
+template <typename T>
+class Future {
+private:
+    std::shared_ptr<detail::Slot<T>> slot;
+
+public:
+    Future() = default;
+    explicit Future(std::shared_ptr<detail::Slot<T>> s) : slot(std::move(s)) {}
+
+    bool valid() const { return slot != nullptr; }
+    bool ready() const { return slot->ready(); }
+    void wait() const { slot->wait(); }
+    const T& get() const {
+        slot->wait();
+        if (slot->error) std::rethrow_exception(slot->error);
+        return *slot->value;
+    }
+    // Lets a Future<Tensor> stand in for a Tensor argument; blocks like get().
+    operator const T&() const { return get(); }
+    Event event() const { return Event(slot); }
+};
+
+template <>
+class Future<void> {
+private:
+    std::shared_ptr<detail::Slot<void>> slot;
+
+public:
+    Future() = default;
+    explicit Future(std::shared_ptr<detail::Slot<void>> s) : slot(std::move(s)) {}
+
+    bool valid() const { return slot != nullptr; }
+    bool ready() const { return slot->ready(); }
+    void wait() const { slot->wait(); }
+    void get() const {
+        slot->wait();
+        if (slot->error) std::rethrow_exception(slot->error);
+    }
+    Event event() const { return Event(slot); }
+};
+
+using AsyncTensor = Future<Tensor>;
+
+namespace detail {
+
+// Task arguments as the callable sees them: futures become their (awaited) values.
+template <typename A>
+struct Resolve {
+    using type = A&;
+    static A& get(A& a) { return a; }
+};
+
+template <typename T>
+struct Resolve<Future<T>> {
+    using type = const T&;
+    static const T& get(Future<T>& f) { return f.get(); }
+};
+
+} // namespace detail
+
+class Stream {
+private:
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::deque<std::function<void()>> queue;
+    bool busy = false;
+    bool shutdown = false;
+    std::thread worker;
+
+    void workerLoop();
+    void push(std::function<void()> task);
+
+public:
+    Stream();
+    // Runs the work still queued, then joins the worker.
+    ~Stream();
+
+    Stream(const Stream&) = delete;
+    Stream& operator=(const Stream&) = delete;
+
+    // Queues f(args...) and returns its result as a future. An exception thrown by f
+    // (or by resolving a future argument) is rethrown by get().
+    template <typename F, typename... Args>
+    auto enqueue(F&& f, Args&&... args)
+        -> Future<std::invoke_result_t<std::decay_t<F>&, typename detail::Resolve<std::decay_t<Args>>::type...>> {
+        using R = std::invoke_result_t<std::decay_t<F>&, typename detail::Resolve<std::decay_t<Args>>::type...>;
+        auto slot = std::make_shared<detail::Slot<R>>();
+        bool grad = autograd::isGradEnabled();
+        push([slot, grad, fn = std::decay_t<F>(std::forward<F>(f)),
+              tup = std::make_tuple(std::decay_t<Args>(std::forward<Args>(args))...)]() mutable {
+            autograd::detail::grad_enabled = grad;
+            try {
+                auto call = [&](auto&... a) -> R {
+                    return fn(detail::Resolve<std::decay_t<decltype(a)>>::get(a)...);
+                };
+                if constexpr (std::is_void_v<R>) {
+                    std::apply(call, tup);
+                } else {
+                    slot->value.emplace(std::apply(call, tup));
+                }
+                slot->set();
+            } catch (...) {
+                slot->set(std::current_exception());
+            }
+        });
+        return Future<R>(slot);
+    }
+
+    // Event that completes once everything queued so far has run.
+    Event record();
+    // Work queued after this call starts only once e has completed.
+    void waitEvent(const Event& e);
+    // Blocks the caller until the queue is empty.
+    void synchronize();
+    // True when nothing is queued or running.
+    bool query();
+};
+
+// Synchronizes every live stream.
+void synchronize();
+
+} // namespace stream
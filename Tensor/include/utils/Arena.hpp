@@ -0,0 +1,128 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Per-thread arena for autograd graph bookkeeping: parent lists, backward closures and
+// the scratch containers of Tensor::backward().
+//
+// Blocks are bump-allocated from chunks (64 KiB, or larger for a single big block).
+// Freeing a block only decrements its chunk's live count. A chunk whose count drops to
+// zero is rewound in O(1) and refilled. A training loop drops iteration k's graph before
+// it records iteration k+1, so once the chunks exist, recording and backward do no
+// general-purpose heap allocation for bookkeeping (check arena::stats().heap_allocations).
+// Blocks may be freed from any thread. The owning thread holds one reference on each of
+// its chunks; a chunk still holding live blocks when that thread exits is freed by
+// whichever thread frees its last block.
+namespace arena {
+
+void* allocate(size_t bytes, size_t align);
+void deallocate(void* p) noexcept;
+
+// Off: every block comes from operator new (for comparison). On by default.
+void setEnabled(bool on);
+bool enabled();
+
+struct Stats {
+    size_t allocations;       // blocks handed out on this thread
+    size_t heap_allocations;  // operator new calls behind them: new chunks, or every block when disabled
+    size_t live;              // blocks not yet freed in this thread's chunks
+    size_t chunks;
+    size_t reserved_bytes;
+    size_t rewinds;           // chunks reset for reuse
+};
+
+Stats stats();
+
+template <typename T>
+struct Allocator {
+    using value_type = T;
+
+    Allocator() = default;
+    template <typename U>
+    Allocator(const Allocator<U>&) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(arena::allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T* p, size_t) noexcept { arena::deallocate(p); }
+
+    template <typename U>
+    bool operator==(const Allocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const Allocator<U>&) const { return false; }
+};
+
+template <typename T>
+using Vector = std::vector<T, Allocator<T>>;
+
+template <typename T>
+using Set = std::unordered_set<T, std::hash<T>, std::equal_to<T>, Allocator<T>>;
+
+// Move-only void() callable whose target lives in the arena (std::function cannot take an allocator).
+class Function {
+public:
+    Function() = default;
+    Function(std::nullptr_t) {}
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Function>>>
+    Function(F&& f) {
+        using T = std::decay_t<F>;
+        void* mem = arena::allocate(sizeof(T), alignof(T));
+        try {
+            obj = new (mem) T(std::forward<F>(f));
+        } catch (...) {
+            arena::deallocate(mem);
+            throw;
+        }
+        invoke = [](void* o) { (*static_cast<T*>(o))(); };
+        destroy = [](void* o) {
+            static_cast<T*>(o)->~T();
+            arena::deallocate(o);
+        };
+    }
+
+    Function(Function&& other) noexcept : obj(other.obj), invoke(other.invoke), destroy(other.destroy) {
+        other.obj = nullptr;
+    }
+
+    Function& operator=(Function&& other) noexcept {
+        if (this != &other) {
+            reset();
+            obj = other.obj;
+            invoke = other.invoke;
+            destroy = other.destroy;
+            other.obj = nullptr;
+        }
+        return *this;
+    }
+
+    Function& operator=(std::nullptr_t) {
+        reset();
+        return *this;
+    }
+
+    ~Function() { reset(); }
+
+    Function(const Function&) = delete;
+    Function& operator=(const Function&) = delete;
+
+    explicit operator bool() const { return obj != nullptr; }
+    void operator()() const { invoke(obj); }
+
+private:
+    void* obj = nullptr;
+    void (*invoke)(void*) = nullptr;
+    void (*destroy)(void*) = nullptr;
+
+    void reset() {
+        if (!obj) return;
+        void* o = obj;
+        obj = nullptr;
+        destroy(o);
+    }
+};
+
+} // namespace arena
@@ -0,0 +1,70 @@
+#pragma once
+#include "../Tensor.hpp"
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Memory accounting for TensorImpl allocations.
+//
+// Live and peak byte counters, split by category, are always maintained.
+// enableTracking() additionally attributes each new tensor to the ops:: call
+// that created it and keeps a registry of live tensors for snapshot():
+//
+//   memory::enableTracking();
+//   Tensor loss = model(x);
+//   for (const auto& t : memory::snapshot(10)) ...   // what the graph keeps alive
+//   loss.backward();
+namespace memory {
+
+enum Category { Data = 0, Grad = 1, Graph = 2, NumCategories = 3 };
+
+struct Stats {
+    size_t live[NumCategories];
+    size_t peak[NumCategories];
+    size_t live_total;
+    size_t peak_total;
+};
+
+struct OpMemory {
+    std::string op;
+    size_t live_bytes;
+    size_t peak_bytes;
+    size_t allocated_bytes;
+    size_t tensors;
+};
+
+struct LiveTensor {
+    std::string op;
+    std::vector<int> shape;
+    size_t data_bytes;
+    size_t grad_bytes;
+    size_t graph_bytes;
+    bool requires_grad;
+    bool has_backward;
+    size_t totalBytes() const { return data_bytes + grad_bytes + graph_bytes; }
+};
+
+Stats stats();
+void resetPeak();
+
+void enableTracking();
+void disableTracking();
+bool trackingEnabled();
+
+// Per creating op, sorted by live bytes. Only covers tensors created while tracking.
+std::vector<OpMemory> byOp();
+// Largest live tracked tensors first; top = 0 returns all of them.
+std::vector<LiveTensor> snapshot(size_t top = 0);
+void printReport(std::ostream& os = std::cout, size_t top = 10);
+
+// Hooks called by TensorImpl and the autodiff helpers.
+void onAllocate(TensorImpl& impl);
+void onFree(TensorImpl& impl);
+void onGraphAttach(TensorImpl& impl, size_t bytes);
+void onGraphRelease(TensorImpl& impl);
+// Around Tensor::releaseGrad and the reallocation in setRequiresGrad(true).
+void onGradRelease(TensorImpl& impl);
+void onGradAllocate(TensorImpl& impl);
+
+} // namespace memory
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// NUMA placement for the parallel pool and large tensor buffers.
+//
+// Topology comes from /sys/devices/system/node/node*/cpulist, restricted to the CPUs this
+// process may run on. Without it (single node, other OSes) everything below is a no-op.
+//
+// When enabled, the pool's workers are pinned so that parallel_for chunk c always runs on
+// cpuForChunk(c), with consecutive chunks on the same node. Large float64 buffers of a new
+// TensorImpl are then first-touched with that same chunking: each page is allocated on the
+// node of the thread whose parallel_for partition covers it. Chunk 0 runs on the calling
+// thread, which firstTouch pins to cpuForChunk(0) for the placement pass only.
+// Only kernels that split the elements the same way (reduce::, the Philox fills, dropout)
+// read all-local memory. matmul, linear and the elementwise ops run serially on the caller
+// and read placed buffers from every node.
+//
+// Enabled by default on multi-node machines. TENSOR_NUMA=0 turns it off, TENSOR_NUMA=1 on
+// even with one node.
+namespace numa {
+
+struct Topology {
+    std::vector<std::vector<int>> node_cpus;   // allowed CPUs of each node with any
+    std::vector<int> cpu_order;                // all of them, node by node
+};
+
+const Topology& topology();
+int numNodes();
+
+void setEnabled(bool on);   // pinning applies to pools created afterwards
+bool enabled();
+
+// CPU that parallel_for chunk c is pinned to.
+int cpuForChunk(int chunk);
+// Pins the calling thread; false if unsupported or refused.
+bool pinCurrentThread(int cpu);
+
+// Buffers of at least this many bytes are placed by first touch.
+constexpr size_t kFirstTouchBytes = 1 << 20;
+
+bool shouldPlace(size_t elements);
+// Re-homes the already zeroed buffer p[0, n): its whole pages are released and touched
+// again by the pool, in parallel_for's partition. With src the touch copies src[0, n)
+// instead of writing zeros.
+void firstTouch(double* p, size_t n, const double* src = nullptr);
+
+} // namespace numa
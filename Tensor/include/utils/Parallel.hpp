@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+// Shared worker pool for intra-op parallelism.
+//
+//   parallel::set_num_threads(8);
+//   parallel::parallel_for(0, rows, 64, [&](int64_t lo, int64_t hi) { ... });
+//
+// The range is split into contiguous chunks, one per thread, so the same
+// (range, grain, thread count) always yields the same partition. Calls made
+// from inside a parallel region run serially on the calling thread.
+// With NUMA placement on, chunk c always runs on numa::cpuForChunk(c) (see Numa.hpp).
+namespace parallel {
+
+void set_num_threads(int n);
+int get_num_threads();
+bool in_parallel_region();
+
+// Runs fn(lo, hi) over [begin, end). Ranges shorter than `grain` per thread
+// use fewer threads; a range no longer than `grain` runs inline.
+void parallel_for(int64_t begin, int64_t end, int64_t grain,
+                  const std::function<void(int64_t, int64_t)>& fn);
+
+} // namespace parallel
@@ -0,0 +1,101 @@
+#pragma once
+#include "../Tensor.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Opt-in per-op profiler.
+//
+//   profiler::enable();
+//   ... forward + loss.backward() ...
+//   profiler::disable();
+//   profiler::printSummary();
+//   profiler::exportChromeTrace("trace.json");   // chrome://tracing or ui.perfetto.dev
+//
+// Every ops:: entry point opens an OpScope; backward closures recorded while the
+// profiler is enabled are wrapped so their runtime is attributed to the same op.
+namespace profiler {
+
+enum class Pass { Forward, Backward };
+
+struct OpStats {
+    std::string name;
+    Pass pass;
+    std::string shapes;
+    long long calls;
+    double total_us;
+    double min_us;
+    double max_us;
+    long long bytes;
+};
+
+namespace detail {
+    // OpScope hooks: Timing is this profiler, MemoryTracking is utils/MemoryTracker.hpp.
+    enum : unsigned { Timing = 1u, MemoryTracking = 2u };
+    extern std::atomic<unsigned> active_flags;
+    void setFlag(unsigned flag, bool on);
+    // Bytes of tensor storage allocated on this thread; bumped by TensorImpl.
+    inline thread_local long long allocated_bytes = 0;
+
+    int64_t nowNs();
+    std::string describeShapes(std::initializer_list<const Tensor*> inputs);
+    void record(const char* name, Pass pass, const std::string& shapes, int64_t start_ns, int64_t end_ns, long long bytes);
+}
+
+inline bool enabled() { return (detail::active_flags.load(std::memory_order_relaxed) & detail::Timing) != 0; }
+
+void enable();
+void disable();
+void reset();
+
+std::vector<OpStats> summary();
+void printSummary(std::ostream& os = std::cout, size_t top = 20);
+void exportChromeTrace(const std::string& path);
+
+// Marks one op invocation: timed when the profiler is on, and used as the
+// creating op for tensors allocated inside it when memory tracking is on.
+class OpScope {
+private:
+    const char* name = nullptr;
+    Pass pass = Pass::Forward;
+    bool active = false;
+    int64_t start_ns = 0;
+    long long start_bytes = 0;
+    std::string shapes;
+    OpScope* prev = nullptr;
+
+    bool timed = false;
+
+    void begin(const char* op, Pass p, std::initializer_list<const Tensor*> inputs);
+    void begin(const char* op, Pass p, const std::string& input_shapes);
+    void end();
+
+public:
+    // When no hook is active the constructor is a single branch.
+    OpScope(const char* op, std::initializer_list<const Tensor*> inputs) {
+        if (detail::active_flags.load(std::memory_order_relaxed)) begin(op, Pass::Forward, inputs);
+    }
+    OpScope(const char* op, Pass p, const std::string& input_shapes) {
+        if (detail::active_flags.load(std::memory_order_relaxed)) begin(op, p, input_shapes);
+    }
+    ~OpScope() {
+        if (active) end();
+    }
+
+    OpScope(const OpScope&) = delete;
+    OpScope& operator=(const OpScope&) = delete;
+
+    // Innermost active scope on this thread, or nullptr.
+    static OpScope* current();
+    const char* opName() const { return name; }
+    const std::string& inputShapes() const { return shapes; }
+};
+
+// Wraps a backward closure so it is timed under the op currently being recorded.
+std::function<void()> instrumentBackward(std::function<void()> bwd);
+
+} // namespace profiler
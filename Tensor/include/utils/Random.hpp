@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Counter-based random numbers (Philox4x32-10, Salmon et al. 2011).
+//
+//   rng::manualSeed(42);                          // reproducible Tensor::randn / uniform / dropout
+//   rng::Generator gen(7);
+//   Tensor w = Tensor::normal({256, 256}, 0.0, 0.05, false, &gen);
+//
+// A generator is only a (seed, offset) pair. Each fill claims a range of 128-bit
+// counter blocks and block i of the range is philox(seed, offset + i), so values
+// are a pure function of the generator state and can be produced in parallel in
+// any order: results do not depend on the thread count.
+namespace rng {
+
+// Position in a Philox stream: key and first counter block.
+struct PhiloxState {
+    uint64_t seed = 0;
+    uint64_t offset = 0;
+};
+
+class Generator {
+private:
+    std::atomic<uint64_t> seed_;
+    std::atomic<uint64_t> offset_;
+
+public:
+    static constexpr uint64_t kDefaultSeed = 0x853C49E6748FEA9BULL;
+
+    explicit Generator(uint64_t seed = kDefaultSeed) : seed_(seed), offset_(0) {}
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    void manualSeed(uint64_t seed);     // also rewinds the stream
+    uint64_t seed() const { return seed_.load(); }
+
+    PhiloxState state() const { return {seed_.load(), offset_.load()}; }
+    void setState(PhiloxState s);
+
+    // Claims `blocks` consecutive counter blocks (4 x 32 random bits each).
+    PhiloxState reserve(uint64_t blocks);
+};
+
+Generator& defaultGenerator();
+void manualSeed(uint64_t seed);
+
+// Restores the default generator's state on scope exit.
+class StateGuard {
+private:
+    PhiloxState saved;
+
+public:
+    StateGuard() : saved(defaultGenerator().state()) {}
+    ~StateGuard() { defaultGenerator().setState(saved); }
+    StateGuard(const StateGuard&) = delete;
+    StateGuard& operator=(const StateGuard&) = delete;
+};
+
+// Philox is evaluated kLanes blocks at a time so the rounds vectorize.
+constexpr int kLanes = 8;
+
+// out[w][l] = word w of philox(seed, counter + l).
+void philoxBatch(uint64_t seed, uint64_t counter, uint32_t out[4][kLanes]);
+
+// Bit patterns to floating point in [0, 1).
+inline double toUnitDouble(uint32_t hi, uint32_t lo) {
+    return static_cast<double>(((static_cast<uint64_t>(hi) << 32) | lo) >> 11) * 0x1.0p-53;
+}
+inline double toUnitFloat(uint32_t x) { return static_cast<double>(x >> 8) * 0x1.0p-24; }
+
+// Fills of n values (2 per block for uniform/normal, 4 for bernoulli), split
+// across the parallel:: pool.
+void uniform(double* out, int64_t n, double low, double high, Generator& gen);
+void normal(double* out, int64_t n, double mean, double stddev, Generator& gen);
+void bernoulli(double* out, int64_t n, double p, Generator& gen);
+
+} // namespace rng
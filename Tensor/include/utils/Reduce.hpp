@@ -0,0 +1,22 @@
+#pragma once
+#include "../DType.hpp"
+#include <cstdint>
+
+// Parallel float64 reductions used by the ops.
+//
+// Values are summed in blocks of kBlock elements, each with kLanes interleaved
+// accumulators (a short, fixed-order pairwise tree), so rounding error grows with
+// n / kBlock + log(kBlock) rather than n. Blocks run on the thread pool, each into its
+// own partial, and the partials are combined in a fixed pairwise tree, so the result is
+// bitwise identical for any thread count. 16-bit inputs are widened a block at a time
+// and summed the same way, in double.
+namespace reduce {
+
+constexpr int64_t kBlock = 4096;
+constexpr int kLanes = 8;
+
+double sum(const double* x, int64_t n);
+double dot(const double* x, const double* y, int64_t n);
+double sum(DType dtype, const uint16_t* x, int64_t n);
+
+} // namespace reduce
@@ -0,0 +1,243 @@
+#include "../include/SparseTensor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Builds row offsets from row indices that are already sorted.
+std::vector<int> rowPtrFromRows(int rows, const std::vector<int>& row_idx) {
+    std::vector<int> row_ptr(rows + 1, 0);
+    for (int r : row_idx) row_ptr[r + 1]++;
+    for (int i = 0; i < rows; ++i) row_ptr[i + 1] += row_ptr[i];
+    return row_ptr;
+}
+
+std::vector<int> rowsFromRowPtr(const std::vector<int>& row_ptr) {
+    std::vector<int> row_idx(row_ptr.back());
+    for (size_t i = 0; i + 1 < row_ptr.size(); ++i) {
+        std::fill(row_idx.begin() + row_ptr[i], row_idx.begin() + row_ptr[i + 1], static_cast<int>(i));
+    }
+    return row_idx;
+}
+
+const SparseImpl& checked(const std::shared_ptr<SparseImpl>& impl) {
+    if (!impl) throw std::runtime_error("Uninitialized SparseTensor");
+    return *impl;
+}
+
+} // namespace
+
+// ==========================================
+// Constructors & Factory Methods
+// ==========================================
+
+SparseTensor::SparseTensor() : impl(nullptr) {}
+
+SparseTensor::SparseTensor(std::shared_ptr<SparseImpl> ptr) : impl(ptr) {}
+
+SparseTensor SparseTensor::fromCOO(int rows, int cols, const std::vector<int>& row_idx,
+                                   const std::vector<int>& col_idx, const std::vector<double>& values,
+                                   SparseLayout layout) {
+    if (rows < 0 || cols < 0) throw std::invalid_argument("SparseTensor: negative shape!");
+    if (row_idx.size() != values.size() || col_idx.size() != values.size()) {
+        throw std::invalid_argument("SparseTensor: index and value counts do not match!");
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (row_idx[i] < 0 || row_idx[i] >= rows || col_idx[i] < 0 || col_idx[i] >= cols) {
+            throw std::out_of_range("SparseTensor: entry " + std::to_string(i) + " is out of bounds");
+        }
+    }
+
+    std::vector<size_t> order(values.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return row_idx[a] != row_idx[b] ? row_idx[a] < row_idx[b] : col_idx[a] < col_idx[b];
+    });
+
+    auto impl = std::make_shared<SparseImpl>();
+    impl->rows = rows;
+    impl->cols = cols;
+    impl->layout = layout;
+    std::vector<int> rows_sorted;
+    for (size_t o : order) {
+        if (!rows_sorted.empty() && rows_sorted.back() == row_idx[o] && impl->col_idx.back() == col_idx[o]) {
+            impl->values.back() += values[o];
+            continue;
+        }
+        rows_sorted.push_back(row_idx[o]);
+        impl->col_idx.push_back(col_idx[o]);
+        impl->values.push_back(values[o]);
+    }
+    impl->indices = layout == SparseLayout::CSR ? rowPtrFromRows(rows, rows_sorted) : std::move(rows_sorted);
+    return SparseTensor(impl);
+}
+
+SparseTensor SparseTensor::fromDense(const Tensor& dense, SparseLayout layout, double threshold) {
+    auto shape = dense.getShape();
+    if (shape.size() != 2) throw std::invalid_argument("SparseTensor::fromDense requires a 2D tensor!");
+
+    auto impl = std::make_shared<SparseImpl>();
+    impl->rows = shape[0];
+    impl->cols = shape[1];
+    impl->layout = layout;
+    if (layout == SparseLayout::CSR) impl->indices.push_back(0);
+
+    auto D = dense.accessor<2>();
+    for (int i = 0; i < impl->rows; ++i) {
+        const double* row = D.row(i);
+        for (int j = 0; j < impl->cols; ++j) {
+            if (std::abs(row[j]) > threshold) {
+                if (layout == SparseLayout::COO) impl->indices.push_back(i);
+                impl->col_idx.push_back(j);
+                impl->values.push_back(row[j]);
+            }
+        }
+        if (layout == SparseLayout::CSR) impl->indices.push_back(static_cast<int>(impl->values.size()));
+    }
+    return SparseTensor(impl);
+}
+
+// ==========================================
+// Conversions
+// ==========================================
+
+Tensor SparseTensor::toDense() const {
+    const auto& s = checked(impl);
+    Tensor out({s.rows, s.cols});
+    auto O = out.accessor<2>();
+    if (s.layout == SparseLayout::CSR) {
+        for (int i = 0; i < s.rows; ++i) {
+            double* row = O.row(i);
+            for (int p = s.indices[i]; p < s.indices[i + 1]; ++p) row[s.col_idx[p]] += s.values[p];
+        }
+    } else {
+        for (size_t p = 0; p < s.values.size(); ++p) O(s.indices[p], s.col_idx[p]) += s.values[p];
+    }
+    return out;
+}
+
+SparseTensor SparseTensor::toCSR() const {
+    const auto& s = checked(impl);
+    if (s.layout == SparseLayout::CSR) return *this;
+    auto out = std::make_shared<SparseImpl>(s);
+    out->layout = SparseLayout::CSR;
+    out->indices = rowPtrFromRows(s.rows, s.indices);
+    out->transposed = nullptr;
+    return SparseTensor(out);
+}
+
+SparseTensor SparseTensor::toCOO() const {
+    const auto& s = checked(impl);
+    if (s.layout == SparseLayout::COO) return *this;
+    auto out = std::make_shared<SparseImpl>(s);
+    out->layout = SparseLayout::COO;
+    out->indices = rowsFromRowPtr(s.indices);
+    out->transposed = nullptr;
+    return SparseTensor(out);
+}
+
+SparseTensor SparseTensor::transpose() const {
+    SparseTensor csr = toCSR();
+    const auto& s = *csr.impl;
+
+    // Counting sort by column; rows are visited in order, so each output row stays sorted.
+    auto out = std::make_shared<SparseImpl>();
+    out->rows = s.cols;
+    out->cols = s.rows;
+    out->layout = SparseLayout::CSR;
+    out->indices.assign(s.cols + 1, 0);
+    for (int c : s.col_idx) out->indices[c + 1]++;
+    for (int c = 0; c < s.cols; ++c) out->indices[c + 1] += out->indices[c];
+    out->col_idx.resize(s.values.size());
+    out->values.resize(s.values.size());
+    std::vector<int> cursor(out->indices.begin(), out->indices.end() - 1);
+    for (int i = 0; i < s.rows; ++i) {
+        for (int p = s.indices[i]; p < s.indices[i + 1]; ++p) {
+            int dst = cursor[s.col_idx[p]]++;
+            out->col_idx[dst] = i;
+            out->values[dst] = s.values[p];
+        }
+    }
+    return SparseTensor(out);
+}
+
+// ==========================================
+// Getters
+// ==========================================
+
+std::vector<int> SparseTensor::getShape() const { return impl ? std::vector<int>{impl->rows, impl->cols} : std::vector<int>{}; }
+int SparseTensor::rows() const { return impl ? impl->rows : 0; }
+int SparseTensor::cols() const { return impl ? impl->cols : 0; }
+int SparseTensor::nnz() const { return impl ? static_cast<int>(impl->values.size()) : 0; }
+SparseLayout SparseTensor::layout() const { return checked(impl).layout; }
+
+double SparseTensor::density() const {
+    if (!impl || impl->rows == 0 || impl->cols == 0) return 0.0;
+    return static_cast<double>(impl->values.size()) / (static_cast<double>(impl->rows) * impl->cols);
+}
+
+const std::vector<int>& SparseTensor::rowPtr() const {
+    const auto& s = checked(impl);
+    if (s.layout != SparseLayout::CSR) throw std::runtime_error("rowPtr() requires CSR layout!");
+    return s.indices;
+}
+
+const std::vector<int>& SparseTensor::rowIdx() const {
+    const auto& s = checked(impl);
+    if (s.layout != SparseLayout::COO) throw std::runtime_error("rowIdx() requires COO layout!");
+    return s.indices;
+}
+
+const std::vector<int>& SparseTensor::colIdx() const { return checked(impl).col_idx; }
+const std::vector<double>& SparseTensor::values() const { return checked(impl).values; }
+
+// ==========================================
+// Element-wise Scalar Ops
+// ==========================================
+
+namespace {
+
+template <typename F>
+SparseTensor mapValues(const std::shared_ptr<SparseImpl>& impl, F f) {
+    auto out = std::make_shared<SparseImpl>(checked(impl));
+    out->transposed = nullptr;
+    for (double& v : out->values) v = f(v);
+    return SparseTensor(out);
+}
+
+} // namespace
+
+SparseTensor SparseTensor::operator*(double val) const { return mapValues(impl, [val](double v) { return v * val; }); }
+SparseTensor SparseTensor::operator/(double val) const { return mapValues(impl, [val](double v) { return v / val; }); }
+SparseTensor SparseTensor::operator-() const { return mapValues(impl, [](double v) { return -v; }); }
+
+SparseTensor SparseTensor::pow(double exponent) const {
+    if (exponent <= 0.0) throw std::invalid_argument("SparseTensor::pow needs a positive exponent to keep zeros!");
+    return mapValues(impl, [exponent](double v) { return std::pow(v, exponent); });
+}
+
+SparseTensor operator*(double val, const SparseTensor& s) { return s * val; }
+
+// ==========================================
+// Formatting & Printing
+// ==========================================
+
+void SparseTensor::print() const {
+    if (!impl) {
+        std::cout << "Empty SparseTensor\n";
+        return;
+    }
+    SparseTensor coo = toCOO();
+    const auto& s = *coo.impl;
+    std::cout << "SparseTensor(shape=[" << s.rows << ", " << s.cols << "], layout="
+              << (impl->layout == SparseLayout::CSR ? "CSR" : "COO") << ", nnz=" << s.values.size() << ",\nentries=[";
+    for (size_t p = 0; p < s.values.size(); ++p) {
+        std::cout << "(" << s.indices[p] << ", " << s.col_idx[p] << "): " << s.values[p];
+        if (p + 1 < s.values.size()) std::cout << ", ";
+    }
+    std::cout << "])\n";
+}
@@ -1,5 +1,9 @@
 #include "../include/Tensor.hpp"
 #include "../include/ops/all_ops.hpp"
+#include "../include/utils/Profiler.hpp"
+#include "../include/utils/MemoryTracker.hpp"
+#include "../include/utils/Numa.hpp"
+#include "../include/utils/Random.hpp"
 #include <iostream>
 #include <numeric>
 #include <algorithm>
@@ -7,9 +11,36 @@
 #include <string>
 #include <sstream>
 #include <cmath>
-#include <random>
 #include <unordered_set>
 
+namespace {
+
+// Element storage of a Float64 tensor; 16-bit tensors must be cast first.
+std::vector<double>& float64Data(const std::shared_ptr<TensorImpl>& impl) {
+    if (!impl) throw std::runtime_error("Uninitialized Tensor");
+    if (impl->dtype != DType::Float64) {
+        throw std::runtime_error(std::string("Tensor holds ") + dtypeName(impl->dtype) +
+                                 " data; convert with to(DType::Float64) first");
+    }
+    return impl->data;
+}
+
+double elementAsDouble(const TensorImpl& impl, int flat) {
+    return impl.dtype == DType::Float64 ? impl.data[flat] : half::decode(impl.dtype, impl.data16[flat]);
+}
+
+// Nesting of Tensor::backward on this thread. Backward closures such as checkpoint's run
+// their own backward; only the outermost one knows when a grad is final.
+thread_local int backward_depth = 0;
+
+struct BackwardDepth {
+    BackwardDepth() { ++backward_depth; }
+    ~BackwardDepth() { --backward_depth; }
+    bool outermost() const { return backward_depth == 1; }
+};
+
+} // namespace
+
 // ==========================================
 // TensorImpl Methods
 // ==========================================
@@ -24,7 +55,7 @@ void TensorImpl::computeStrides() {
     }
 }
 
-int TensorImpl::computeTotalSize(const std::vector<int>& shp) const {
+int TensorImpl::computeTotalSize(const DimVector& shp) const {
     if (shp.empty()) return 0;
     for (int dim : shp) {
         if (dim <= 0) return 0;
@@ -33,11 +64,15 @@ int TensorImpl::computeTotalSize(const std::vector<int>& shp) const {
 }
 
 int TensorImpl::flattenIndex(const std::vector<int>& indices) const {
-    if (indices.size() != shape.size()) {
+    return flattenIndex(indices.data(), indices.size());
+}
+
+int TensorImpl::flattenIndex(const int* indices, size_t count) const {
+    if (count != shape.size()) {
         throw std::invalid_argument("The index number does not match!");
     }
     int flatIndex = 0;
-    for (size_t i = 0; i < indices.size(); ++i) {
+    for (size_t i = 0; i < count; ++i) {
         if (indices[i] < 0 || indices[i] >= shape[i]) {
             throw std::out_of_range("Index out of bounds for dimensional " + std::to_string(i));
         }
@@ -46,21 +81,57 @@ int TensorImpl::flattenIndex(const std::vector<int>& indices) const {
     return flatIndex;
 }
 
-TensorImpl::TensorImpl(const std::vector<int>& shape, bool req_grad)
+TensorImpl::TensorImpl(const DimVector& shape, bool req_grad)
     : shape(shape), total_size(computeTotalSize(shape)), requires_grad(req_grad) {
     computeStrides();
     data.resize(total_size, 0.0);
     grad.resize(total_size, 0.0);
+    if (numa::shouldPlace(total_size)) {
+        numa::firstTouch(data.data(), total_size);
+        numa::firstTouch(grad.data(), total_size);
+    }
+    memory::onAllocate(*this);
 }
 
-TensorImpl::TensorImpl(const std::vector<int>& shape, const std::vector<double>& values, bool req_grad)
+TensorImpl::TensorImpl(const DimVector& shape, const std::vector<double>& values, bool req_grad)
     : shape(shape), total_size(computeTotalSize(shape)), requires_grad(req_grad) {
     if (values.size() != static_cast<size_t>(total_size)) {
         throw std::invalid_argument("The index number does not match!");
     }
     computeStrides();
-    data = values;
     grad.resize(total_size, 0.0);
+    if (numa::shouldPlace(total_size)) {
+        data.resize(total_size, 0.0);
+        numa::firstTouch(data.data(), total_size, values.data());
+        numa::firstTouch(grad.data(), total_size);
+    } else {
+        data = values;
+    }
+    memory::onAllocate(*this);
+}
+
+TensorImpl::TensorImpl(const DimVector& shape, DType dt, bool req_grad)
+    : shape(shape), total_size(computeTotalSize(shape)), requires_grad(req_grad), dtype(dt) {
+    computeStrides();
+    if (dtype == DType::Float64) data.resize(total_size, 0.0);
+    else data16.resize(total_size, 0);
+    grad.resize(total_size, 0.0);
+    if (numa::shouldPlace(total_size)) {
+        if (dtype == DType::Float64) numa::firstTouch(data.data(), total_size);
+        numa::firstTouch(grad.data(), total_size);
+    }
+    memory::onAllocate(*this);
+}
+
+TensorImpl::~TensorImpl() {
+    memory::onFree(*this);
+}
+
+void TensorImpl::releaseGraph() {
+    parents.clear();
+    backward_fn = nullptr;
+    vjp_fn = nullptr;
+    memory::onGraphRelease(*this);
 }
 
 // ==========================================
@@ -69,33 +140,49 @@ TensorImpl::TensorImpl(const std::vector<int>& shape, const std::vector<double>&
 
 Tensor::Tensor() : impl(nullptr) {}
 
-Tensor::Tensor(const std::vector<int>& shape, bool requires_grad)
+Tensor::Tensor(const DimVector& shape, bool requires_grad)
     : impl(std::make_shared<TensorImpl>(shape, requires_grad)) {}
 
-Tensor::Tensor(const std::vector<int>& shape, const std::vector<double>& values, bool requires_grad)
+Tensor::Tensor(const DimVector& shape, const std::vector<double>& values, bool requires_grad)
     : impl(std::make_shared<TensorImpl>(shape, values, requires_grad)) {}
 
+Tensor::Tensor(const DimVector& shape, DType dtype, bool requires_grad)
+    : impl(std::make_shared<TensorImpl>(shape, dtype, requires_grad)) {}
+
 Tensor::Tensor(std::shared_ptr<TensorImpl> ptr) : impl(ptr) {}
 
-Tensor Tensor::zeros(const std::vector<int>& shape, bool requires_grad) {
+Tensor Tensor::zeros(const DimVector& shape, bool requires_grad) {
     return Tensor(shape, requires_grad);
 }
 
-Tensor Tensor::ones(const std::vector<int>& shape, bool requires_grad) {
+Tensor Tensor::ones(const DimVector& shape, bool requires_grad) {
     Tensor t(shape, requires_grad);
     std::fill(t.getMutableData().begin(), t.getMutableData().end(), 1.0);
     return t;
 }
 
-Tensor Tensor::randn(const std::vector<int>& shape, double mean, double stddev, bool requires_grad) {
+Tensor Tensor::randn(const DimVector& shape, double mean, double stddev, bool requires_grad) {
+    return normal(shape, mean, stddev, requires_grad);
+}
+
+Tensor Tensor::normal(const DimVector& shape, double mean, double stddev, bool requires_grad,
+                      rng::Generator* gen) {
     Tensor t(shape, requires_grad);
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::normal_distribution<double> d(mean, stddev);
-    auto& mutable_data = t.getMutableData();
-    for (double& val : mutable_data) {
-        val = d(gen);
-    }
+    rng::normal(t.getMutableData().data(), t.size(), mean, stddev, gen ? *gen : rng::defaultGenerator());
+    return t;
+}
+
+Tensor Tensor::uniform(const DimVector& shape, double low, double high, bool requires_grad,
+                       rng::Generator* gen) {
+    Tensor t(shape, requires_grad);
+    rng::uniform(t.getMutableData().data(), t.size(), low, high, gen ? *gen : rng::defaultGenerator());
+    return t;
+}
+
+Tensor Tensor::bernoulli(const DimVector& shape, double p, rng::Generator* gen) {
+    if (p < 0.0 || p > 1.0) throw std::invalid_argument("bernoulli: p must be in [0, 1]!");
+    Tensor t(shape);
+    rng::bernoulli(t.getMutableData().data(), t.size(), p, gen ? *gen : rng::defaultGenerator());
     return t;
 }
 
@@ -104,23 +191,20 @@ Tensor Tensor::randn(const std::vector<int>& shape, double mean, double stddev,
 // ==========================================
 
 double& Tensor::operator()(const std::initializer_list<int>& indices) {
-    if (!impl) throw std::runtime_error("Uninitialized Tensor");
-    return impl->data[impl->flattenIndex(indices)];
+    return float64Data(impl)[impl->flattenIndex(indices.begin(), indices.size())];
 }
 
 const double& Tensor::operator()(const std::initializer_list<int>& indices) const {
-    if (!impl) throw std::runtime_error("Uninitialized Tensor");
-    return impl->data[impl->flattenIndex(indices)];
+    return float64Data(impl)[impl->flattenIndex(indices.begin(), indices.size())];
 }
 
 double Tensor::at(const std::vector<int>& indices) const {
     if (!impl) throw std::runtime_error("Uninitialized Tensor");
-    return impl->data[impl->flattenIndex(indices)];
+    return elementAsDouble(*impl, impl->flattenIndex(indices));
 }
 
 double& Tensor::at(const std::vector<int>& indices) {
-    if (!impl) throw std::runtime_error("Uninitialized Tensor");
-    return impl->data[impl->flattenIndex(indices)];
+    return float64Data(impl)[impl->flattenIndex(indices)];
 }
 
 void Tensor::set(const std::vector<int>& indices, double value) {
@@ -129,7 +213,7 @@ void Tensor::set(const std::vector<int>& indices, double value) {
 
 void Tensor::apply(const std::function<double(double)>& func) {
     if (!impl) return;
-    for (double& val : impl->data) {
+    for (double& val : float64Data(impl)) {
         val = func(val);
     }
 }
@@ -138,23 +222,35 @@ void Tensor::apply(const std::function<double(double)>& func) {
 // Getters & Metadata
 // ==========================================
 
-std::vector<int> Tensor::getShape() const { return impl ? impl->shape : std::vector<int>{}; }
+std::vector<int> Tensor::getShape() const {
+    if (!impl) return {};
+    return impl->shape;
+}
+
+const DimVector& Tensor::shapeView() const {
+    static const DimVector empty;
+    return impl ? impl->shape : empty;
+}
+
 int Tensor::size() const { return impl ? impl->total_size : 0; }
 int Tensor::rank() const { return impl ? static_cast<int>(impl->shape.size()) : 0; }
 bool Tensor::isScalar() const { return impl && (impl->shape.empty() || (impl->shape.size() == 1 && impl->shape[0] == 1)); }
 bool Tensor::isEmpty() const { return !impl || impl->total_size == 0; }
+DType Tensor::dtype() const { return impl ? impl->dtype : DType::Float64; }
 
-const std::vector<double>& Tensor::getData() const {
-    if (!impl) throw std::runtime_error("Uninitialized Tensor");
-    return impl->data;
-}
+const std::vector<double>& Tensor::getData() const { return float64Data(impl); }
+
+std::vector<double>& Tensor::getMutableData() const { return float64Data(impl); }
 
-std::vector<double>& Tensor::getMutableData() const {
+const std::vector<uint16_t>& Tensor::getHalfData() const { return getMutableHalfData(); }
+
+std::vector<uint16_t>& Tensor::getMutableHalfData() const {
     if (!impl) throw std::runtime_error("Uninitialized Tensor");
-    return impl->data;
+    if (impl->dtype == DType::Float64) throw std::runtime_error("getHalfData() requires a bfloat16/float16 tensor!");
+    return impl->data16;
 }
 
-const std::vector<int>& Tensor::getStrides() const {
+const DimVector& Tensor::getStrides() const {
     if (!impl) throw std::runtime_error("Uninitialized Tensor");
     return impl->strides;
 }
@@ -166,7 +262,26 @@ const std::vector<int>& Tensor::getStrides() const {
 bool Tensor::requiresGrad() const { return impl ? impl->requires_grad : false; }
 
 void Tensor::setRequiresGrad(bool req) {
-    if (impl) impl->requires_grad = req;
+    if (!impl) return;
+    impl->requires_grad = req;
+    if (req && impl->grad.empty() && impl->total_size > 0) {
+        impl->grad.assign(impl->total_size, 0.0);
+        if (numa::shouldPlace(impl->total_size)) numa::firstTouch(impl->grad.data(), impl->total_size);
+        memory::onGradAllocate(*impl);
+    }
+}
+
+void Tensor::setGradReadyHook(std::function<void()> fn) {
+    if (!impl) throw std::runtime_error("Uninitialized Tensor");
+    if (fn) impl->grad_ready_hook = std::make_unique<std::function<void()>>(std::move(fn));
+    else impl->grad_ready_hook.reset();
+}
+
+void Tensor::releaseGrad() {
+    if (!impl) throw std::runtime_error("Uninitialized Tensor");
+    if (impl->requires_grad) throw std::runtime_error("releaseGrad: tensor requires grad!");
+    memory::onGradRelease(*impl);
+    std::vector<double>().swap(impl->grad);
 }
 
 const std::vector<double>& Tensor::getGrad() const {
@@ -184,6 +299,26 @@ double& Tensor::gradAt(const std::vector<int>& indices) const {
     return impl->grad[impl->flattenIndex(indices)];
 }
 
+bool Tensor::hasTangent() const { return impl && !impl->tangent.empty(); }
+
+const std::vector<double>& Tensor::getTangent() const {
+    if (!impl) throw std::runtime_error("Uninitialized Tensor");
+    return impl->tangent;
+}
+
+void Tensor::setTangent(const std::vector<double>& tangent) {
+    if (!impl) throw std::runtime_error("Uninitialized Tensor");
+    if (impl->dtype != DType::Float64) throw std::runtime_error("Forward-mode AD requires float64 tensors!");
+    if (tangent.size() != static_cast<size_t>(impl->total_size)) {
+        throw std::invalid_argument("Tangent size does not match tensor size!");
+    }
+    impl->tangent = tangent;
+}
+
+void Tensor::clearTangent() {
+    if (impl) impl->tangent.clear();
+}
+
 void Tensor::zero_grad() {
     if (!impl) return;
     std::fill(impl->grad.begin(), impl->grad.end(), 0.0);
@@ -191,6 +326,7 @@ void Tensor::zero_grad() {
 
 void Tensor::backward() {
     if (!impl || !impl->requires_grad) return;
+    profiler::OpScope prof("backward", profiler::Pass::Backward, "");
 
     // Check if initial loss gradient is zero, seed with 1.0
     bool all_zero = true;
@@ -201,24 +337,27 @@ void Tensor::backward() {
         std::fill(impl->grad.begin(), impl->grad.end(), 1.0);
     }
 
-    std::vector<std::shared_ptr<TensorImpl>> topo;
-    std::unordered_set<TensorImpl*> visited;
-
-    std::function<void(std::shared_ptr<TensorImpl>)> build_topo = [&](std::shared_ptr<TensorImpl> node) {
-        if (!node || visited.find(node.get()) != visited.end()) return;
-        visited.insert(node.get());
-        for (auto& parent : node->parents) {
-            if (parent.getImpl()) {
-                build_topo(parent.getImpl());
-            }
+    // Post-order DFS without recursion; the scratch containers come from the graph arena.
+    arena::Vector<TensorImpl*> topo;
+    arena::Set<TensorImpl*> visited;
+    arena::Vector<std::pair<TensorImpl*, size_t>> stack;
+    stack.emplace_back(impl.get(), 0);
+    visited.insert(impl.get());
+    while (!stack.empty()) {
+        auto& [node, next] = stack.back();
+        if (next < node->parents.size()) {
+            TensorImpl* parent = node->parents[next++].getImpl().get();
+            if (parent && visited.insert(parent).second) stack.emplace_back(parent, 0);
+            continue;
         }
         topo.push_back(node);
-    };
-
-    build_topo(impl);
+        stack.pop_back();
+    }
 
     // Run backward closures in reverse topological order
+    BackwardDepth depth;
     for (auto it = topo.rbegin(); it != topo.rend(); ++it) {
+        if ((*it)->grad_ready_hook && depth.outermost()) (*(*it)->grad_ready_hook)();
         if ((*it)->backward_fn) {
             ((*it)->backward_fn)();
         }
@@ -229,19 +368,37 @@ void Tensor::backward() {
 // Operations & Manipulation
 // ==========================================
 
-Tensor Tensor::reshape(const std::vector<int>& new_shape) const {
+Tensor Tensor::reshape(const DimVector& new_shape) const {
     if (!impl) throw std::runtime_error("Uninitialized Tensor");
     int new_total_size = impl->computeTotalSize(new_shape);
     if (new_total_size != impl->total_size) {
         throw std::invalid_argument("Reshape: size mismatch!");
     }
+    if (impl->dtype != DType::Float64) {
+        Tensor res(new_shape, impl->dtype, impl->requires_grad);
+        res.impl->data16 = impl->data16;
+        if (!impl->grad.empty()) res.getMutableGrad() = impl->grad;
+        return res;
+    }
     Tensor res(new_shape, impl->data, impl->requires_grad);
-    res.getMutableGrad() = impl->grad;
+    if (!impl->grad.empty()) res.getMutableGrad() = impl->grad;
+    res.impl->tangent = impl->tangent;
+    return res;
+}
+
+Tensor Tensor::to(DType dtype) const { return ops::cast(*this, dtype); }
+
+Tensor Tensor::detach() const {
+    if (!impl) throw std::runtime_error("Uninitialized Tensor");
+    Tensor res(impl->shape, impl->dtype);
+    res.impl->data = impl->data;
+    res.impl->data16 = impl->data16;
     return res;
 }
 
 Tensor Tensor::slice(const std::vector<std::pair<int, int>>& ranges) const {
     if (!impl) throw std::runtime_error("Uninitialized Tensor");
+    if (impl->dtype != DType::Float64) throw std::runtime_error("slice() requires a float64 tensor!");
     if (ranges.size() != impl->shape.size()) {
         throw std::invalid_argument("Rank mismatch for slice!");
     }
@@ -289,10 +446,10 @@ Tensor Tensor::operator*(const Tensor& other) const { return ops::mul(*this, oth
 Tensor Tensor::operator/(const Tensor& other) const { return ops::div(*this, other); }
 Tensor Tensor::operator-() const { return ops::neg(*this); }
 
-Tensor Tensor::operator+(double val) const { return ops::add(*this, Tensor({1}, std::vector<double>{val})); }
-Tensor Tensor::operator-(double val) const { return ops::sub(*this, Tensor({1}, std::vector<double>{val})); }
-Tensor Tensor::operator*(double val) const { return ops::mul(*this, Tensor({1}, std::vector<double>{val})); }
-Tensor Tensor::operator/(double val) const { return ops::div(*this, Tensor({1}, std::vector<double>{val})); }
+Tensor Tensor::operator+(double val) const { return ops::add(*this, val); }
+Tensor Tensor::operator-(double val) const { return ops::sub(*this, val); }
+Tensor Tensor::operator*(double val) const { return ops::mul(*this, val); }
+Tensor Tensor::operator/(double val) const { return ops::div(*this, val); }
 
 // ==========================================
 // Formatting & Printing
@@ -304,7 +461,7 @@ void Tensor::printRecursive(const std::vector<int>& indices, int dim) const {
         for (int i = 0; i < impl->shape[dim]; i++) {
             auto idx = indices;
             idx.push_back(i);
-            std::cout << impl->data[impl->flattenIndex(idx)];
+            std::cout << elementAsDouble(*impl, impl->flattenIndex(idx));
             if (i < impl->shape[dim] - 1) std::cout << ", ";
         }
         std::cout << "]";
@@ -334,7 +491,9 @@ void Tensor::print() const {
         std::cout << impl->shape[i];
         if (i < impl->shape.size() - 1) std::cout << ", ";
     }
-    std::cout << "], requires_grad=" << (impl->requires_grad ? "true" : "false") << ",\ndata=";
+    std::cout << "]";
+    if (impl->dtype != DType::Float64) std::cout << ", dtype=" << dtypeName(impl->dtype);
+    std::cout << ", requires_grad=" << (impl->requires_grad ? "true" : "false") << ",\ndata=";
     printRecursive({}, 0);
 
     if (impl->requires_grad) {
@@ -0,0 +1,45 @@
+#include "../../include/amp/GradScaler.hpp"
+#include "../../include/ops/all_ops.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace amp {
+
+GradScaler::GradScaler(GradScalerOptions options, bool enabled)
+    : opt(options), current_scale(options.init_scale), enabled(enabled) {
+    if (opt.init_scale <= 0.0 || opt.growth_factor < 1.0 || opt.backoff_factor <= 0.0 || opt.backoff_factor >= 1.0) {
+        throw std::invalid_argument("GradScaler: invalid scaling options!");
+    }
+}
+
+Tensor GradScaler::scale(const Tensor& loss) const {
+    if (!enabled) return loss;
+    return ops::mul(loss, current_scale);
+}
+
+bool GradScaler::unscale(const std::vector<Tensor>& params) const {
+    double inv = 1.0 / getScale();
+    bool finite = true;
+    for (const Tensor& p : params) {
+        for (double& g : p.getMutableGrad()) {
+            g *= inv;
+            if (!std::isfinite(g)) finite = false;
+        }
+    }
+    return finite;
+}
+
+void GradScaler::update(bool grads_finite) {
+    if (!grads_finite) {
+        ++skipped;
+        clean_steps = 0;
+        if (enabled) current_scale *= opt.backoff_factor;
+        return;
+    }
+    if (enabled && ++clean_steps >= opt.growth_interval) {
+        current_scale *= opt.growth_factor;
+        clean_steps = 0;
+    }
+}
+
+} // namespace amp
@@ -0,0 +1,55 @@
+#include "../../include/amp/MixedPrecisionSGD.hpp"
+#include <stdexcept>
+
+namespace amp {
+
+MixedPrecisionSGD::MixedPrecisionSGD(const std::vector<Tensor>& master_params, DType dtype, double lr,
+                                     double momentum, GradScalerOptions scaler_options)
+    : master(master_params), lr(lr), momentum(momentum), scaler(scaler_options, dtype == DType::Float16) {
+    for (size_t i = 0; i < master.size(); ++i) {
+        if (master[i].dtype() != DType::Float64) throw std::invalid_argument("Master weights must be float64!");
+        if (dtype == DType::Float64) master[i].setRequiresGrad(true);
+        model.push_back(dtype == DType::Float64 ? master[i] : Tensor(master[i].getShape(), dtype, true));
+        velocity.emplace_back(momentum != 0.0 ? master[i].size() : 0, 0.0);
+        refreshModel(i);
+    }
+}
+
+void MixedPrecisionSGD::refreshModel(size_t i) {
+    if (model[i].dtype() == DType::Float64) return;
+    DType d = model[i].dtype();
+    const auto& src = master[i].getData();
+    auto& dst = model[i].getMutableHalfData();
+    for (size_t k = 0; k < src.size(); ++k) dst[k] = half::encode(d, static_cast<float>(src[k]));
+}
+
+void MixedPrecisionSGD::backward(const Tensor& loss) {
+    Tensor scaled = scaler.scale(loss);
+    scaled.backward();
+}
+
+bool MixedPrecisionSGD::step() {
+    bool finite = scaler.unscale(model);
+    scaler.update(finite);
+    if (finite) {
+        for (size_t i = 0; i < master.size(); ++i) {
+            auto& w = master[i].getMutableData();
+            const auto& g = model[i].getGrad();
+            auto& v = velocity[i];
+            for (size_t k = 0; k < w.size(); ++k) {
+                double update = g[k];
+                if (!v.empty()) update = v[k] = momentum * v[k] + g[k];
+                w[k] -= lr * update;
+            }
+            refreshModel(i);
+        }
+    }
+    zero_grad();
+    return finite;
+}
+
+void MixedPrecisionSGD::zero_grad() {
+    for (auto& p : model) p.zero_grad();
+}
+
+} // namespace amp
@@ -0,0 +1,108 @@
+#include "../../include/autograd/Checkpoint.hpp"
+#include "../../include/autograd/GradMode.hpp"
+#include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/utils/Random.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace autograd {
+
+namespace {
+
+std::string describeInputs(const std::vector<Tensor>& inputs) {
+    std::string s;
+    for (const Tensor& t : inputs) {
+        if (!s.empty()) s += ",";
+        s += "[";
+        auto shape = t.getShape();
+        for (size_t i = 0; i < shape.size(); ++i) {
+            if (i) s += "x";
+            s += std::to_string(shape[i]);
+        }
+        s += "]";
+    }
+    return s;
+}
+
+} // namespace
+
+Tensor checkpoint(CheckpointFn fn, const std::vector<Tensor>& inputs) {
+    profiler::OpScope prof("checkpoint", profiler::Pass::Forward,
+                           profiler::enabled() ? describeInputs(inputs) : std::string());
+    // Recomputation replays the default generator from here, so random ops
+    // such as dropout draw the same values in both passes.
+    rng::PhiloxState rng_state = rng::defaultGenerator().state();
+    Tensor out;
+    {
+        NoGradGuard no_grad;
+        out = fn(inputs);
+    }
+    // The output gets its own node, so it must not alias an input.
+    for (const Tensor& in : inputs) {
+        if (in.getImpl() == out.getImpl()) {
+            out = out.detach();
+            break;
+        }
+    }
+
+    bool req_grad = isGradEnabled() &&
+                    std::any_of(inputs.begin(), inputs.end(), [](const Tensor& t) { return t.requiresGrad(); });
+    if (!req_grad) return out;
+
+    out.setRequiresGrad(true);
+    for (const Tensor& in : inputs) {
+        if (in.requiresGrad()) out.getImpl()->parents.push_back(in);
+    }
+
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    ops::attach_backward_fn(out, [out_weak, fn, inputs, rng_state]() {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        const auto& og = out_impl->grad;
+        if (std::all_of(og.begin(), og.end(), [](double g) { return g == 0.0; })) return;
+
+        // Rebuild the segment's graph. Inputs that are themselves graph nodes are
+        // swapped for detached leaves so this backward stops at them; leaves such as
+        // weights are used directly and receive their gradient in place.
+        EnableGradGuard enable_grad;
+        std::vector<Tensor> local;
+        std::vector<bool> detached(inputs.size(), false);
+        local.reserve(inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            const Tensor& in = inputs[i];
+            if (in.getImpl()->backward_fn) {
+                Tensor leaf = in.detach();
+                leaf.setRequiresGrad(in.requiresGrad());
+                local.push_back(leaf);
+                detached[i] = true;
+            } else {
+                local.push_back(in);
+            }
+        }
+        Tensor y;
+        {
+            rng::StateGuard restore_rng;
+            rng::defaultGenerator().setState(rng_state);
+            y = fn(local);
+        }
+        if (y.shapeView() != out_impl->shape) {
+            throw std::runtime_error("checkpoint: recomputed output shape differs from the forward pass!");
+        }
+        if (!y.requiresGrad()) return;
+        // fn may hand back one of its inputs unchanged; then y is that leaf and already
+        // holds gradient from elsewhere, so add to it and there is nothing to walk.
+        auto& yg = y.getMutableGrad();
+        for (size_t k = 0; k < yg.size(); ++k) yg[k] += og[k];
+        if (y.getImpl()->backward_fn) y.backward();
+
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (!detached[i] || !inputs[i].requiresGrad()) continue;
+            auto& dst = inputs[i].getMutableGrad();
+            const auto& src = local[i].getGrad();
+            for (size_t k = 0; k < dst.size(); ++k) dst[k] += src[k];
+        }
+    });
+    return out;
+}
+
+} // namespace autograd
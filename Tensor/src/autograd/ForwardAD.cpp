@@ -0,0 +1,67 @@
+#include "../../include/autograd/ForwardAD.hpp"
+#include "../../include/autograd/GradMode.hpp"
+#include <stdexcept>
+
+namespace autograd {
+
+JvpResult jvp(const ForwardFn& fn, const std::vector<Tensor>& primals, const std::vector<Tensor>& tangents) {
+    if (tangents.size() != primals.size()) throw std::invalid_argument("jvp: one tangent per primal required!");
+
+    std::vector<Tensor> in;
+    in.reserve(primals.size());
+    for (size_t i = 0; i < primals.size(); ++i) {
+        Tensor p = primals[i].detach();
+        if (tangents[i].getImpl()) {
+            if (tangents[i].shapeView() != p.shapeView()) {
+                throw std::invalid_argument("jvp: tangent " + std::to_string(i) + " does not match its primal's shape!");
+            }
+            p.setTangent(tangents[i].getData());
+        }
+        in.push_back(p);
+    }
+
+    NoGradGuard no_grad;
+    Tensor out = fn(in);
+    Tensor tangent(out.shapeView());
+    if (out.hasTangent()) tangent.getMutableData() = out.getTangent();
+    out.clearTangent();
+    return {out, tangent};
+}
+
+Tensor jacfwd(const ForwardFn& fn, const std::vector<Tensor>& primals, int argnum) {
+    if (argnum < 0 || argnum >= static_cast<int>(primals.size())) {
+        throw std::out_of_range("jacfwd: argnum out of range!");
+    }
+    std::vector<Tensor> in;
+    in.reserve(primals.size());
+    for (const Tensor& p : primals) in.push_back(p.detach());
+
+    NoGradGuard no_grad;
+    Tensor& x = in[argnum];
+    int n = x.size();
+    std::vector<double> basis(n, 0.0);
+    Tensor jac;
+    for (int j = 0; j < n; ++j) {
+        basis[j] = 1.0;
+        x.setTangent(basis);
+        basis[j] = 0.0;
+        Tensor y = fn(in);
+
+        if (j == 0) {
+            std::vector<int> shape = y.getShape();
+            for (int d : x.getShape()) shape.push_back(d);
+            jac = Tensor(shape);
+        } else if (y.size() * n != jac.size()) {
+            throw std::runtime_error("jacfwd: output shape changed between passes!");
+        }
+        // Column j of the [out, in] Jacobian.
+        if (y.hasTangent()) {
+            const auto& ty = y.getTangent();
+            auto& J = jac.getMutableData();
+            for (int r = 0; r < y.size(); ++r) J[static_cast<size_t>(r) * n + j] = ty[r];
+        }
+    }
+    return jac;
+}
+
+} // namespace autograd
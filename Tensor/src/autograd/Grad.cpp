@@ -0,0 +1,112 @@
+#include "../../include/autograd/Grad.hpp"
+#include "../../include/autograd/GradMode.hpp"
+#include "../../include/ops/all_ops.hpp"
+#include "../../include/utils/Profiler.hpp"
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace autograd {
+
+namespace {
+
+std::vector<Tensor> runGrad(const Tensor& output, const std::vector<Tensor>& inputs, const Tensor& grad_output) {
+    std::vector<std::shared_ptr<TensorImpl>> topo;
+    std::unordered_set<TensorImpl*> visited;
+    std::function<void(const std::shared_ptr<TensorImpl>&)> build_topo = [&](const std::shared_ptr<TensorImpl>& node) {
+        if (!node || !visited.insert(node.get()).second) return;
+        for (auto& parent : node->parents) build_topo(parent.getImpl());
+        topo.push_back(node);
+    };
+    build_topo(output.getImpl());
+
+    std::unordered_set<TensorImpl*> wanted;
+    for (const Tensor& in : inputs) wanted.insert(in.getImpl().get());
+    // Nodes with a path to some input; everything else needs no vjp.
+    std::unordered_set<TensorImpl*> needed(wanted);
+    for (auto& node : topo) {
+        for (auto& parent : node->parents) {
+            if (needed.count(parent.getImpl().get())) {
+                needed.insert(node.get());
+                break;
+            }
+        }
+    }
+
+    std::unordered_map<TensorImpl*, Tensor> grads;
+    grads[output.getImpl().get()] = grad_output.getImpl() ? grad_output : Tensor::ones(output.shapeView());
+
+    for (auto it = topo.rbegin(); it != topo.rend(); ++it) {
+        TensorImpl* node = it->get();
+        auto found = grads.find(node);
+        if (found == grads.end() || node->parents.empty() || !needed.count(node)) continue;
+        if (!node->vjp_fn) {
+            throw std::runtime_error(std::string("autograd::grad: no differentiable backward for a tensor created by '") +
+                                     (node->creator_op ? node->creator_op : "?") + "'");
+        }
+        Tensor g = found->second;
+        if (!wanted.count(node)) grads.erase(found);
+
+        std::vector<Tensor> in(node->parents.begin(), node->parents.end());
+        std::vector<Tensor> in_grads = node->vjp_fn(Tensor(*it), in, g);
+        for (size_t i = 0; i < node->parents.size() && i < in_grads.size(); ++i) {
+            const Tensor& parent = node->parents[i];
+            if (!in_grads[i].getImpl() || !needed.count(parent.getImpl().get())) continue;
+            auto slot = grads.find(parent.getImpl().get());
+            if (slot == grads.end()) grads.emplace(parent.getImpl().get(), in_grads[i]);
+            else slot->second = slot->second + in_grads[i];
+        }
+    }
+
+    std::vector<Tensor> result;
+    result.reserve(inputs.size());
+    for (const Tensor& in : inputs) {
+        auto found = grads.find(in.getImpl().get());
+        result.push_back(found != grads.end() ? found->second : Tensor::zeros(in.shapeView()));
+    }
+    return result;
+}
+
+} // namespace
+
+std::vector<Tensor> grad(const Tensor& output, const std::vector<Tensor>& inputs, bool create_graph,
+                         const Tensor& grad_output) {
+    if (!output.getImpl()) throw std::runtime_error("Uninitialized Tensor");
+    if (grad_output.getImpl() && grad_output.shapeView() != output.shapeView()) {
+        throw std::invalid_argument("autograd::grad: grad_output shape does not match output!");
+    }
+    profiler::OpScope prof("grad", profiler::Pass::Backward, "");
+    if (create_graph) {
+        EnableGradGuard enable_grad;
+        return runGrad(output, inputs, grad_output);
+    }
+    NoGradGuard no_grad;
+    return runGrad(output, inputs, grad_output);
+}
+
+std::vector<Tensor> hvp(const Tensor& loss, const std::vector<Tensor>& params, const std::vector<Tensor>& v) {
+    if (v.size() != params.size()) throw std::invalid_argument("hvp: one direction per parameter required!");
+    std::vector<Tensor> g = grad(loss, params, true);
+    Tensor gv;
+    {
+        EnableGradGuard enable_grad;
+        for (size_t i = 0; i < params.size(); ++i) {
+            if (v[i].shapeView() != params[i].shapeView()) {
+                throw std::invalid_argument("hvp: direction " + std::to_string(i) + " does not match its parameter!");
+            }
+            Tensor term = ops::sum(g[i] * v[i]);
+            gv = gv.getImpl() ? gv + term : term;
+        }
+    }
+    // Loss linear in params: the gradient is constant and H = 0.
+    if (!gv.getImpl() || !gv.requiresGrad()) {
+        std::vector<Tensor> zeros;
+        for (const Tensor& p : params) zeros.push_back(Tensor::zeros(p.shapeView()));
+        return zeros;
+    }
+    return grad(gv, params);
+}
+
+} // namespace autograd
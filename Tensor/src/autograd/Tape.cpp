@@ -0,0 +1,243 @@
+#include "../../include/autograd/Tape.hpp"
+#include "../../include/utils/Profiler.hpp"
+#include "../../include/utils/Reduce.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace autograd {
+
+namespace {
+
+// Elementwise input of an op with output grad `og`. A single-element input that was
+// broadcast against a larger output gets the reduced gradient, as in the closures.
+inline bool broadcast(const TensorImpl& in, const std::vector<double>& og) {
+    return in.total_size == 1 && og.size() != 1;
+}
+
+void addGrad(TensorImpl& in, const std::vector<double>& og, double sign) {
+    if (!in.requires_grad) return;
+    if (broadcast(in, og)) {
+        in.grad[0] += sign * reduce::sum(og.data(), og.size());
+        return;
+    }
+    for (size_t i = 0; i < og.size(); ++i) in.grad[i] += sign * og[i];
+}
+
+void mulGrad(TensorImpl& in, const TensorImpl& other, const std::vector<double>& og) {
+    if (!in.requires_grad) return;
+    const auto& d = other.data;
+    if (broadcast(in, og)) {
+        in.grad[0] += reduce::dot(og.data(), d.data(), og.size());
+    } else if (broadcast(other, og)) {
+        for (size_t i = 0; i < og.size(); ++i) in.grad[i] += og[i] * d[0];
+    } else {
+        for (size_t i = 0; i < og.size(); ++i) in.grad[i] += og[i] * d[i];
+    }
+}
+
+void divGrad(TensorImpl& a, TensorImpl& b, const std::vector<double>& og) {
+    const auto& da = a.data;
+    const auto& db = b.data;
+    bool b_bcast = broadcast(b, og);
+    if (a.requires_grad) {
+        for (size_t i = 0; i < og.size(); ++i) a.grad[i] += og[i] / db[b_bcast ? 0 : i];
+    }
+    if (b.requires_grad) {
+        if (b_bcast) {
+            b.grad[0] += -reduce::dot(og.data(), da.data(), og.size()) / (db[0] * db[0]);
+        } else {
+            for (size_t i = 0; i < og.size(); ++i) b.grad[i] += og[i] * (-da[i] / (db[i] * db[i]));
+        }
+    }
+}
+
+void matmulGrad(TensorImpl& out, TensorImpl& a, TensorImpl& b) {
+    int m = a.shape[0], n = a.shape[1], p = b.shape[1];
+    auto G = out.gradAccessor<2>();
+    auto A = a.dataAccessor<2>();
+    auto B = b.dataAccessor<2>();
+    if (a.requires_grad) {
+        auto dA = a.gradAccessor<2>();
+        for (int i = 0; i < m; ++i) {
+            const double* grow = G.row(i);
+            double* darow = dA.row(i);
+            for (int k = 0; k < n; ++k) {
+                const double* brow = B.row(k);
+                double sum = 0.0;
+                for (int j = 0; j < p; ++j) sum += grow[j] * brow[j];
+                darow[k] += sum;
+            }
+        }
+    }
+    if (b.requires_grad) {
+        auto dB = b.gradAccessor<2>();
+        for (int i = 0; i < m; ++i) {
+            const double* grow = G.row(i);
+            for (int k = 0; k < n; ++k) {
+                double aik = A(i, k);
+                double* dbrow = dB.row(k);
+                for (int j = 0; j < p; ++j) dbrow[j] += aik * grow[j];
+            }
+        }
+    }
+}
+
+// Unary elementwise: in.grad[i] += og[i] * f(i).
+template <typename F>
+inline void unaryGrad(TensorImpl& in, const std::vector<double>& og, F f) {
+    if (!in.requires_grad) return;
+    for (size_t i = 0; i < og.size(); ++i) in.grad[i] += og[i] * f(i);
+}
+
+} // namespace
+
+Tape::~Tape() { clear(); }
+
+int32_t Tape::slot(const Tensor& t) {
+    TensorImpl* impl = t.getImpl().get();
+    int32_t s = impl->tape_slot;
+    if (s >= 0 && s < static_cast<int32_t>(values.size()) && values[s].get() == impl) return s;
+    s = static_cast<int32_t>(values.size());
+    values.push_back(t.getImpl());
+    impl->tape_slot = s;
+    return s;
+}
+
+void Tape::record(TapeOp op, const Tensor& out, const Tensor& a, const Tensor* b, double scalar) {
+    int32_t o = slot(out);
+    int32_t i0 = slot(a);
+    int32_t i1 = b ? slot(*b) : -1;
+    nodes.push_back({op, o, i0, i1, scalar});
+}
+
+void Tape::recordClosure(const Tensor& out) {
+    nodes.push_back({TapeOp::Closure, slot(out), -1, -1, 0.0});
+}
+
+void Tape::backward(const Tensor& loss) {
+    TensorImpl* root = loss.getImpl().get();
+    if (!root || !root->requires_grad) return;
+    profiler::OpScope prof("backward", profiler::Pass::Backward, "");
+
+    auto& seed = root->grad;
+    if (std::all_of(seed.begin(), seed.end(), [](double g) { return g == 0.0; })) {
+        std::fill(seed.begin(), seed.end(), 1.0);
+    }
+
+    // Closures (e.g. checkpoint) may run ops while we iterate; keep them off this tape.
+    struct Pause {
+        Tape* prev = detail::active_tape;
+        Pause() { detail::active_tape = nullptr; }
+        ~Pause() { detail::active_tape = prev; }
+    } pause;
+
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+        const TapeNode& node = *it;
+        TensorImpl& out = *values[node.out];
+        const auto& og = out.grad;
+
+        if (node.op == TapeOp::Closure) {
+            if (out.backward_fn) out.backward_fn();
+            continue;
+        }
+        TensorImpl& a = *values[node.in0];
+        const auto& da = a.data;
+        const auto& dout = out.data;
+
+        switch (node.op) {
+        case TapeOp::Add:
+            addGrad(a, og, 1.0);
+            addGrad(*values[node.in1], og, 1.0);
+            break;
+        case TapeOp::Sub:
+            addGrad(a, og, 1.0);
+            addGrad(*values[node.in1], og, -1.0);
+            break;
+        case TapeOp::Mul: {
+            TensorImpl& b = *values[node.in1];
+            mulGrad(a, b, og);
+            mulGrad(b, a, og);
+            break;
+        }
+        case TapeOp::Div:
+            divGrad(a, *values[node.in1], og);
+            break;
+        case TapeOp::AddScalar:
+            addGrad(a, og, 1.0);
+            break;
+        case TapeOp::MulScalar:
+            unaryGrad(a, og, [c = node.scalar](size_t) { return c; });
+            break;
+        case TapeOp::DivScalar:
+            if (a.requires_grad) {
+                for (size_t i = 0; i < og.size(); ++i) a.grad[i] += og[i] / node.scalar;
+            }
+            break;
+        case TapeOp::Neg:
+            addGrad(a, og, -1.0);
+            break;
+        case TapeOp::Exp:
+            unaryGrad(a, og, [&](size_t i) { return dout[i]; });
+            break;
+        case TapeOp::Log:
+            if (a.requires_grad) {
+                for (size_t i = 0; i < og.size(); ++i) a.grad[i] += og[i] / da[i];
+            }
+            break;
+        case TapeOp::Sin:
+            unaryGrad(a, og, [&](size_t i) { return std::cos(da[i]); });
+            break;
+        case TapeOp::Cos:
+            unaryGrad(a, og, [&](size_t i) { return -std::sin(da[i]); });
+            break;
+        case TapeOp::Tanh:
+            unaryGrad(a, og, [&](size_t i) { return 1.0 - dout[i] * dout[i]; });
+            break;
+        case TapeOp::Sigmoid:
+            if (a.requires_grad) {
+                for (size_t i = 0; i < og.size(); ++i) a.grad[i] += og[i] * dout[i] * (1.0 - dout[i]);
+            }
+            break;
+        case TapeOp::Relu:
+            if (a.requires_grad) {
+                for (size_t i = 0; i < og.size(); ++i) if (da[i] > 0.0) a.grad[i] += og[i];
+            }
+            break;
+        case TapeOp::Sum:
+        case TapeOp::Mean: {
+            if (!a.requires_grad) break;
+            double g = og[0];
+            if (node.op == TapeOp::Mean) g /= (a.total_size > 0 ? a.total_size : 1.0);
+            for (double& v : a.grad) v += g;
+            break;
+        }
+        case TapeOp::Dot: {
+            TensorImpl& b = *values[node.in1];
+            double g = og[0];
+            if (a.requires_grad) {
+                for (size_t i = 0; i < a.grad.size(); ++i) a.grad[i] += g * b.data[i];
+            }
+            if (b.requires_grad) {
+                for (size_t i = 0; i < b.grad.size(); ++i) b.grad[i] += g * da[i];
+            }
+            break;
+        }
+        case TapeOp::Matmul:
+            matmulGrad(out, a, *values[node.in1]);
+            break;
+        case TapeOp::Closure:
+            break;
+        }
+    }
+}
+
+void Tape::clear() {
+    nodes.clear();
+    values.clear();
+}
+
+size_t Tape::bytes() const {
+    return nodes.capacity() * sizeof(TapeNode) + values.capacity() * sizeof(std::shared_ptr<TensorImpl>);
+}
+
+} // namespace autograd
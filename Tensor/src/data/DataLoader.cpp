@@ -0,0 +1,251 @@
+#include "../../include/data/DataLoader.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace data {
+
+namespace {
+
+// Failed try_push / try_pop attempts before a side goes to sleep.
+constexpr int kSpins = 64;
+
+int sampleSize(const std::vector<int>& shape) {
+    return std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<int>());
+}
+
+std::vector<int> withBatchDim(int batch, const std::vector<int>& shape) {
+    std::vector<int> out;
+    out.reserve(shape.size() + 1);
+    out.push_back(batch);
+    out.insert(out.end(), shape.begin(), shape.end());
+    return out;
+}
+
+} // namespace
+
+// ==========================================
+// Construction & Epoch Control
+// ==========================================
+
+DataLoader::DataLoader(const Dataset& dataset, const DataLoaderOptions& options)
+    : dataset(dataset), options(options), num_batches(0), next_batch(0) {
+    if (options.batch_size <= 0) throw std::invalid_argument("DataLoader: batch_size must be positive!");
+    if (options.num_workers < 0) throw std::invalid_argument("DataLoader: num_workers must be >= 0!");
+    if (options.prefetch_depth <= 0) throw std::invalid_argument("DataLoader: prefetch_depth must be positive!");
+
+    auto input_shape = dataset.inputShape();
+    auto target_shape = dataset.targetShape();
+    input_size = sampleSize(input_shape);
+    target_size = sampleSize(target_shape);
+    batch_input_shape = withBatchDim(options.batch_size, input_shape);
+    batch_target_shape = withBatchDim(options.batch_size, target_shape);
+
+    size_t n = dataset.size();
+    size_t bs = static_cast<size_t>(options.batch_size);
+    num_batches = static_cast<int>(options.drop_last ? n / bs : (n + bs - 1) / bs);
+
+    startEpoch(0);
+}
+
+DataLoader::~DataLoader() {
+    stopWorkers();
+}
+
+void DataLoader::startEpoch(int epoch) {
+    stopWorkers();
+    {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        error = nullptr;
+    }
+
+    size_t n = dataset.size();
+    perm.resize(n);
+    std::iota(perm.begin(), perm.end(), size_t{0});
+    if (options.shuffle && n > 1) {
+        // Fisher-Yates on a fixed engine so the order is identical across standard libraries.
+        std::mt19937_64 gen(options.seed + 0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(epoch));
+        for (size_t i = n - 1; i > 0; --i) {
+            size_t j = static_cast<size_t>(gen() % (i + 1));
+            std::swap(perm[i], perm[j]);
+        }
+    }
+    next_batch = 0;
+
+    int w = options.num_workers;
+    queues.clear();
+    if (w == 0) return;
+
+    size_t per_queue = static_cast<size_t>(std::max(1, (options.prefetch_depth + w - 1) / w));
+    for (int i = 0; i < w; ++i) {
+        queues.push_back(std::make_unique<SpscQueue<Batch>>(per_queue));
+    }
+    for (int i = 0; i < w; ++i) {
+        workers.emplace_back(&DataLoader::workerLoop, this, i);
+    }
+}
+
+void DataLoader::stopWorkers() {
+    stop.store(true, std::memory_order_relaxed);
+    signal(slot_free);
+    for (auto& t : workers) {
+        if (t.joinable()) t.join();
+    }
+    workers.clear();
+    stop.store(false, std::memory_order_relaxed);
+}
+
+// ==========================================
+// Buffer Pool
+// ==========================================
+
+DataLoader::Slot* DataLoader::acquireSlot() {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    for (auto& slot : pool) {
+        if (!slot->reserved && slot->inputs.use_count() == 1 && slot->targets.use_count() == 1) {
+            // Pair with the consumer's last reference drop before overwriting its data.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            slot->reserved = true;
+            for (auto* impl : {slot->inputs.get(), slot->targets.get()}) {
+                if (impl->requires_grad) {
+                    impl->requires_grad = false;
+                    std::fill(impl->grad.begin(), impl->grad.end(), 0.0);
+                }
+                impl->releaseGraph();
+            }
+            return slot.get();
+        }
+    }
+    auto slot = std::make_unique<Slot>();
+    slot->inputs = std::make_shared<TensorImpl>(batch_input_shape);
+    slot->targets = std::make_shared<TensorImpl>(batch_target_shape);
+    slot->reserved = true;
+    pool.push_back(std::move(slot));
+    return pool.back().get();
+}
+
+void DataLoader::releaseSlot(Slot* slot) {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    slot->reserved = false;
+}
+
+size_t DataLoader::poolSize() {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    return pool.size();
+}
+
+// ==========================================
+// Batch Assembly
+// ==========================================
+
+Batch DataLoader::assemble(int batch_index) {
+    size_t start = static_cast<size_t>(batch_index) * options.batch_size;
+    int count = static_cast<int>(std::min<size_t>(options.batch_size, perm.size() - start));
+
+    Batch batch;
+    batch.index = batch_index;
+    Slot* slot = nullptr;
+    if (count == options.batch_size) {
+        slot = acquireSlot();
+        batch.inputs = Tensor(slot->inputs);
+        batch.targets = Tensor(slot->targets);
+    } else {
+        // The ragged tail batch has its own shape, so it is not pooled.
+        batch.inputs = Tensor(withBatchDim(count, dataset.inputShape()));
+        batch.targets = Tensor(withBatchDim(count, dataset.targetShape()));
+    }
+
+    try {
+        double* in = batch.inputs.getMutableData().data();
+        double* tg = batch.targets.getMutableData().data();
+        for (int j = 0; j < count; ++j) {
+            dataset.load(perm[start + j], in + static_cast<size_t>(j) * input_size,
+                         tg + static_cast<size_t>(j) * target_size);
+        }
+    } catch (...) {
+        if (slot) releaseSlot(slot);
+        throw;
+    }
+    if (slot) releaseSlot(slot);
+    return batch;
+}
+
+// Taking the mutex orders the notify after a waiter's check of its condition, so the
+// waiter either sees the change or is already asleep and gets woken.
+void DataLoader::signal(std::condition_variable& cv) {
+    { std::lock_guard<std::mutex> lock(wait_mutex); }
+    cv.notify_all();
+}
+
+void DataLoader::workerLoop(int worker_id) {
+    int stride = options.num_workers;
+    auto& queue = *queues[worker_id];
+    try {
+        for (int b = worker_id; b < num_batches; b += stride) {
+            if (stop.load(std::memory_order_relaxed)) return;
+            Batch batch = assemble(b);
+            bool pushed = false;
+            for (int spin = 0; spin < kSpins && !(pushed = queue.try_push(batch)); ++spin) {
+                if (stop.load(std::memory_order_relaxed)) return;
+                std::this_thread::yield();
+            }
+            if (!pushed) {
+                std::unique_lock<std::mutex> lock(wait_mutex);
+                slot_free.wait(lock, [&] { return stop.load(std::memory_order_relaxed) || queue.try_push(batch); });
+                if (stop.load(std::memory_order_relaxed)) return;
+            }
+            signal(batch_ready);
+        }
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+        signal(batch_ready);
+    }
+}
+
+bool DataLoader::hasWorkerError() {
+    std::lock_guard<std::mutex> lock(error_mutex);
+    return error != nullptr;
+}
+
+void DataLoader::rethrowWorkerError() {
+    std::exception_ptr e;
+    {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        e = error;
+    }
+    if (e) std::rethrow_exception(e);
+}
+
+// ==========================================
+// Consumer
+// ==========================================
+
+bool DataLoader::next(Batch& batch) {
+    if (next_batch >= num_batches) return false;
+
+    if (options.num_workers == 0) {
+        batch = assemble(next_batch++);
+        return true;
+    }
+
+    auto& queue = *queues[next_batch % options.num_workers];
+    bool popped = false;
+    for (int spin = 0; spin < kSpins && !(popped = queue.try_pop(batch)); ++spin) {
+        rethrowWorkerError();
+        std::this_thread::yield();
+    }
+    if (!popped) {
+        std::unique_lock<std::mutex> lock(wait_mutex);
+        batch_ready.wait(lock, [&] { return (popped = queue.try_pop(batch)) || hasWorkerError(); });
+    }
+    if (!popped) rethrowWorkerError();
+    signal(slot_free);
+    ++next_batch;
+    return true;
+}
+
+} // namespace data
@@ -0,0 +1,90 @@
+#include "../../include/dist/DataParallel.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace dist {
+
+DataParallel::DataParallel(ProcessGroup& group, const std::vector<Tensor>& parameters, const DataParallelOptions& options)
+    : group(group), params(parameters), options(options), bucket_of(parameters.size(), -1),
+      marked(parameters.size(), 0) {
+    for (const Tensor& p : params) {
+        if (p.isEmpty() || !p.requiresGrad() || p.getData().empty()) {
+            throw std::invalid_argument("dist::DataParallel: parameters must be float64 tensors that require grad!");
+        }
+    }
+    // Start identical on every rank.
+    for (const Tensor& p : params) group.broadcast(p.getMutableData().data(), p.getData().size(), 0);
+
+    size_t cap = std::max<size_t>(1, options.bucket_bytes / sizeof(double));
+    size_t filled = 0;
+    for (int i = static_cast<int>(params.size()) - 1; i >= 0; --i) {
+        size_t n = params[i].getGrad().size();
+        if (buckets.empty() || (filled > 0 && filled + n > cap)) {
+            buckets.emplace_back();
+            filled = 0;
+        }
+        buckets.back().params.push_back(i);
+        bucket_of[i] = static_cast<int>(buckets.size()) - 1;
+        filled += n;
+    }
+    for (auto& b : buckets) {
+        size_t total = 0;
+        for (int i : b.params) total += params[i].getGrad().size();
+        b.flat.resize(total);
+    }
+
+    if (group.size() > 1) comm = std::make_unique<stream::Stream>();
+    for (size_t i = 0; i < params.size(); ++i) {
+        params[i].setGradReadyHook([this, i] { markReady(static_cast<int>(i)); });
+    }
+}
+
+DataParallel::~DataParallel() {
+    if (comm) comm->synchronize();
+    for (Tensor& p : params) p.setGradReadyHook(nullptr);
+}
+
+void DataParallel::markReady(int param) {
+    if (marked[param]) return;
+    marked[param] = 1;
+    --buckets[bucket_of[param]].pending;
+    while (next_launch < static_cast<int>(buckets.size()) && buckets[next_launch].pending == 0) launch(next_launch++);
+}
+
+void DataParallel::launch(int bucket) {
+    Bucket& b = buckets[bucket];
+    double scale = options.average ? 1.0 / group.size() : 1.0;
+    auto reduce = [this, &b, scale] {
+        size_t off = 0;
+        for (int i : b.params) {
+            const auto& g = params[i].getGrad();
+            std::copy(g.begin(), g.end(), b.flat.begin() + off);
+            off += g.size();
+        }
+        group.allReduce(b.flat.data(), b.flat.size());
+        off = 0;
+        for (int i : b.params) {
+            auto& g = params[i].getMutableGrad();
+            for (double& v : g) v = b.flat[off++] * scale;
+        }
+    };
+    if (comm) inflight.push_back(comm->enqueue(reduce));
+    else reduce();
+}
+
+void DataParallel::backward(const Tensor& loss) {
+    for (auto& b : buckets) b.pending = static_cast<int>(b.params.size());
+    std::fill(marked.begin(), marked.end(), 0);
+    next_launch = 0;
+    inflight.clear();
+    Tensor root = loss;
+    root.backward();
+    // Buckets holding parameters that backward did not reach.
+    while (next_launch < static_cast<int>(buckets.size())) {
+        buckets[next_launch].pending = 0;
+        launch(next_launch++);
+    }
+    for (const auto& f : inflight) f.get();
+}
+
+} // namespace dist
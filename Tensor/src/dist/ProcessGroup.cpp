@@ -0,0 +1,217 @@
+#include "../../include/dist/ProcessGroup.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace dist {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x54445354;   // "TDST"
+constexpr size_t kHeaderBytes = 128;
+
+static_assert(std::atomic<int>::is_always_lock_free, "process-shared atomics must be lock free");
+
+int envInt(const char* name, int fallback) {
+    const char* v = std::getenv(name);
+    return v ? std::atoi(v) : fallback;
+}
+
+void spinUntil(const std::atomic<int>& value, int differs_from) {
+    for (int spins = 0; value.load(std::memory_order_acquire) == differs_from; ++spins) {
+        if (spins > 64) std::this_thread::yield();
+    }
+}
+
+} // namespace
+
+struct ProcessGroup::Header {
+    std::atomic<uint32_t> magic;
+    std::atomic<int> arrived;
+    std::atomic<int> generation;
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) + 2 * sizeof(std::atomic<int>) <= kHeaderBytes, "header too large");
+
+LaunchInfo launchInfo() {
+    LaunchInfo info;
+    info.rank = envInt("TENSOR_DIST_RANK", 0);
+    info.world_size = envInt("TENSOR_DIST_WORLD_SIZE", 1);
+    if (const char* name = std::getenv("TENSOR_DIST_NAME")) info.name = name;
+    return info;
+}
+
+std::vector<int> spawnWorkers(int world_size, char** argv) {
+    if (world_size < 1) throw std::invalid_argument("dist::spawnWorkers: world_size must be positive!");
+    std::string name = "/tensor_dist_" + std::to_string(getpid());
+    std::vector<std::string> vars;
+    for (char** e = environ; *e; ++e) {
+        if (std::strncmp(*e, "TENSOR_DIST_", 12) != 0) vars.push_back(*e);
+    }
+    size_t base = vars.size();
+    vars.push_back("TENSOR_DIST_WORLD_SIZE=" + std::to_string(world_size));
+    vars.push_back("TENSOR_DIST_NAME=" + name);
+    vars.push_back("");
+
+    std::vector<int> pids;
+    for (int r = 1; r < world_size; ++r) {
+        vars[base + 2] = "TENSOR_DIST_RANK=" + std::to_string(r);
+        std::vector<char*> envp;
+        for (auto& v : vars) envp.push_back(v.data());
+        envp.push_back(nullptr);
+        pid_t pid;
+#ifdef __linux__
+        const char* exe = "/proc/self/exe";
+#else
+        const char* exe = argv[0];
+#endif
+        if (posix_spawn(&pid, exe, nullptr, nullptr, argv, envp.data()) != 0) {
+            throw std::runtime_error("dist::spawnWorkers: cannot start rank " + std::to_string(r));
+        }
+        pids.push_back(static_cast<int>(pid));
+    }
+    setenv("TENSOR_DIST_RANK", "0", 1);
+    setenv("TENSOR_DIST_WORLD_SIZE", std::to_string(world_size).c_str(), 1);
+    setenv("TENSOR_DIST_NAME", name.c_str(), 1);
+    return pids;
+}
+
+bool waitWorkers(const std::vector<int>& pids) {
+    bool ok = true;
+    for (int pid : pids) {
+        int status = 0;
+        if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) ok = false;
+    }
+    return ok;
+}
+
+ProcessGroup::ProcessGroup(const LaunchInfo& info, size_t slot_elements)
+    : rank_(info.rank), world_(info.world_size), slot_elements_(slot_elements), name_(info.name) {
+    if (world_ < 1 || rank_ < 0 || rank_ >= world_) throw std::invalid_argument("dist::ProcessGroup: bad rank or world size!");
+    if (slot_elements_ == 0) throw std::invalid_argument("dist::ProcessGroup: slot_elements must be positive!");
+    if (world_ == 1) return;
+    if (name_.empty()) throw std::invalid_argument("dist::ProcessGroup: a multi-rank group needs a segment name!");
+
+    mapping_bytes = kHeaderBytes + static_cast<size_t>(world_) * 2 * slot_elements_ * sizeof(double);
+    int fd;
+    if (rank_ == 0) {
+        shm_unlink(name_.c_str());
+        fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0 || ftruncate(fd, static_cast<off_t>(mapping_bytes)) != 0) {
+            if (fd >= 0) close(fd);
+            throw std::runtime_error("dist::ProcessGroup: cannot create shared memory " + name_);
+        }
+    } else {
+        // Rank 0 may not have created (or sized) the segment yet.
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+        struct stat st {};
+        while (true) {
+            fd = shm_open(name_.c_str(), O_RDWR, 0600);
+            if (fd >= 0 && fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) == mapping_bytes) break;
+            if (fd >= 0) close(fd);
+            if (std::chrono::steady_clock::now() > deadline) {
+                throw std::runtime_error("dist::ProcessGroup: rank 0 never created " + name_);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    mapping = mmap(nullptr, mapping_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::runtime_error("dist::ProcessGroup: cannot map " + name_);
+    }
+    header = static_cast<Header*>(mapping);
+    if (rank_ == 0) {
+        // ftruncate zero-filled the segment, which is a valid state for the atomics.
+        header->magic.store(kMagic, std::memory_order_release);
+    } else {
+        while (header->magic.load(std::memory_order_acquire) != kMagic) std::this_thread::yield();
+    }
+    barrier();
+    // Everyone is mapped; the name is no longer needed.
+    if (rank_ == 0) shm_unlink(name_.c_str());
+}
+
+ProcessGroup::~ProcessGroup() {
+    if (mapping) munmap(mapping, mapping_bytes);
+}
+
+double* ProcessGroup::slot(int rank, int parity) const {
+    char* base = static_cast<char*>(mapping) + kHeaderBytes;
+    return reinterpret_cast<double*>(base) + (static_cast<size_t>(rank) * 2 + parity) * slot_elements_;
+}
+
+// Sense by generation: the last rank to arrive resets the count, then opens the next generation.
+void ProcessGroup::barrier() {
+    if (world_ == 1) return;
+    int gen = header->generation.load(std::memory_order_acquire);
+    if (header->arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == world_) {
+        header->arrived.store(0, std::memory_order_relaxed);
+        header->generation.fetch_add(1, std::memory_order_release);
+    } else {
+        spinUntil(header->generation, gen);
+    }
+}
+
+void ProcessGroup::allReduce(double* data, size_t n) {
+    if (world_ == 1) return;
+    int W = world_;
+    int prev = (rank_ + W - 1) % W;
+    size_t piece = slot_elements_ * W;
+    for (size_t off = 0; off < n; off += piece) {
+        double* x = data + off;
+        size_t len = std::min(piece, n - off);
+        auto lo = [&](int k) { return len * static_cast<size_t>(k) / W; };
+        auto hi = [&](int k) { return len * static_cast<size_t>(k + 1) / W; };
+
+        // Reduce-scatter: after W - 1 steps this rank holds the full sum of chunk rank + 1.
+        for (int s = 0; s + 1 < W; ++s) {
+            int send = (rank_ - s + W) % W;
+            int recv = (rank_ - s - 1 + 2 * W) % W;
+            int p = step++ & 1;
+            std::memcpy(slot(rank_, p), x + lo(send), (hi(send) - lo(send)) * sizeof(double));
+            barrier();
+            const double* in = slot(prev, p);
+            double* out = x + lo(recv);
+            for (size_t i = 0, m = hi(recv) - lo(recv); i < m; ++i) out[i] += in[i];
+        }
+        // All-gather: pass the finished chunks around the ring.
+        for (int s = 0; s + 1 < W; ++s) {
+            int send = (rank_ + 1 - s + W) % W;
+            int recv = (rank_ - s + W) % W;
+            int p = step++ & 1;
+            std::memcpy(slot(rank_, p), x + lo(send), (hi(send) - lo(send)) * sizeof(double));
+            barrier();
+            std::memcpy(x + lo(recv), slot(prev, p), (hi(recv) - lo(recv)) * sizeof(double));
+        }
+    }
+}
+
+void ProcessGroup::broadcast(double* data, size_t n, int root) {
+    if (root < 0 || root >= world_) throw std::out_of_range("dist::ProcessGroup::broadcast: bad root!");
+    if (world_ == 1) return;
+    for (size_t off = 0; off < n; off += slot_elements_) {
+        size_t len = std::min(slot_elements_, n - off);
+        int p = step++ & 1;
+        if (rank_ == root) std::memcpy(slot(root, p), data + off, len * sizeof(double));
+        barrier();
+        if (rank_ != root) std::memcpy(data + off, slot(root, p), len * sizeof(double));
+    }
+}
+
+} // namespace dist
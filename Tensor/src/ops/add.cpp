@@ -1,27 +1,52 @@
 #include "../../include/ops/add.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
+#include "../../include/utils/Reduce.hpp"
 #include <stdexcept>
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> add_vjp(const Tensor&, const std::vector<Tensor>& in, const Tensor& g) {
+    return {in[0].requiresGrad() ? unbroadcast(in[0], g) : Tensor(),
+            in[1].requiresGrad() ? unbroadcast(in[1], g) : Tensor()};
+}
+
+} // namespace
+
 Tensor add(const Tensor& a, const Tensor& b) {
+    profiler::OpScope prof("add", {&a, &b});
     bool req_grad = a.requiresGrad() || b.requiresGrad();
+
+    if (isLowPrecision(a) || isLowPrecision(b)) {
+        Tensor out = zipLowPrecision("add", a, b, req_grad, [](float x, float y) { return x + y; });
+        auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+        attach_binary_backward(out, a, b, [out_weak, a, b]() mutable {
+            auto out_impl = out_weak.lock(); if (!out_impl) return;
+            if (a.requiresGrad()) accumulateLowPrecisionGrad(a, out_impl->grad, 1.0);
+            if (b.requiresGrad()) accumulateLowPrecisionGrad(b, out_impl->grad, 1.0);
+        });
+        return out;
+    }
     
     if (a.isScalar() && !b.isScalar()) {
-        Tensor out(b.getShape(), req_grad);
+        Tensor out(b.shapeView(), req_grad);
         double val_a = a.at({0});
         const auto& data_b = b.getData();
         auto& data_out = out.getMutableData();
         for (size_t i = 0; i < data_b.size(); ++i) {
             data_out[i] = val_a + data_b[i];
         }
+        binary_tangent(out, a, b, [](int) { return 1.0; }, [](int) { return 1.0; });
+        if (record_on_tape(out, autograd::TapeOp::Add, a, &b)) return out;
         auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
         attach_binary_backward(out, a, b, [out_weak, a, b]() mutable {
             auto out_impl = out_weak.lock(); if (!out_impl) return;
             const auto& og = out_impl->grad;
             if (a.requiresGrad()) {
-                double sum_g = 0.0;
-                for (double g : og) sum_g += g;
+                double sum_g = reduce::sum(og.data(), og.size());
                 a.getMutableGrad()[0] += sum_g;
             }
             if (b.requiresGrad()) {
@@ -29,17 +54,20 @@ Tensor add(const Tensor& a, const Tensor& b) {
                 for (size_t i = 0; i < og.size(); ++i) bg[i] += og[i];
             }
         });
+        attach_vjp(out, add_vjp);
         return out;
     }
     
     if (!a.isScalar() && b.isScalar()) {
-        Tensor out(a.getShape(), req_grad);
+        Tensor out(a.shapeView(), req_grad);
         const auto& data_a = a.getData();
         double val_b = b.at({0});
         auto& data_out = out.getMutableData();
         for (size_t i = 0; i < data_a.size(); ++i) {
             data_out[i] = data_a[i] + val_b;
         }
+        binary_tangent(out, a, b, [](int) { return 1.0; }, [](int) { return 1.0; });
+        if (record_on_tape(out, autograd::TapeOp::Add, a, &b)) return out;
         auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
         attach_binary_backward(out, a, b, [out_weak, a, b]() mutable {
             auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -49,19 +77,19 @@ Tensor add(const Tensor& a, const Tensor& b) {
                 for (size_t i = 0; i < og.size(); ++i) ag[i] += og[i];
             }
             if (b.requiresGrad()) {
-                double sum_g = 0.0;
-                for (double g : og) sum_g += g;
+                double sum_g = reduce::sum(og.data(), og.size());
                 b.getMutableGrad()[0] += sum_g;
             }
         });
+        attach_vjp(out, add_vjp);
         return out;
     }
 
-    if (a.getShape() != b.getShape()) {
+    if (a.shapeView() != b.shapeView()) {
         throw std::invalid_argument("Shape mismatch in ops::add!");
     }
 
-    Tensor out(a.getShape(), req_grad);
+    Tensor out(a.shapeView(), req_grad);
     const auto& da = a.getData();
     const auto& db = b.getData();
     auto& dout = out.getMutableData();
@@ -69,6 +97,8 @@ Tensor add(const Tensor& a, const Tensor& b) {
         dout[i] = da[i] + db[i];
     }
 
+    binary_tangent(out, a, b, [](int) { return 1.0; }, [](int) { return 1.0; });
+    if (record_on_tape(out, autograd::TapeOp::Add, a, &b)) return out;
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_binary_backward(out, a, b, [out_weak, a, b]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -82,7 +112,44 @@ Tensor add(const Tensor& a, const Tensor& b) {
             for (size_t i = 0; i < og.size(); ++i) bg[i] += og[i];
         }
     });
+    attach_vjp(out, add_vjp);
+
+    return out;
+}
+
+Tensor add(const Tensor& a, double b) {
+    profiler::OpScope prof("add", {&a});
 
+    if (isLowPrecision(a)) {
+        float bf = static_cast<float>(b);
+        Tensor out = mapLowPrecision(a, a.requiresGrad(), [bf](float x) { return x + bf; });
+        auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+        attach_unary_backward(out, a, [out_weak, a]() mutable {
+            auto out_impl = out_weak.lock(); if (!out_impl) return;
+            if (a.requiresGrad()) accumulateLowPrecisionGrad(a, out_impl->grad, 1.0);
+        });
+        return out;
+    }
+
+    Tensor out(a.shapeView(), a.requiresGrad());
+    const auto& da = a.getData();
+    auto& dout = out.getMutableData();
+    for (size_t i = 0; i < da.size(); ++i) dout[i] = da[i] + b;
+
+    unary_tangent(out, a, [](int) { return 1.0; });
+    if (record_on_tape(out, autograd::TapeOp::AddScalar, a)) return out;
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_unary_backward(out, a, [out_weak, a]() mutable {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        const auto& og = out_impl->grad;
+        if (a.requiresGrad()) {
+            auto& ag = a.getMutableGrad();
+            for (size_t i = 0; i < og.size(); ++i) ag[i] += og[i];
+        }
+    });
+    attach_vjp(out, [](const Tensor&, const std::vector<Tensor>&, const Tensor& g) {
+        return std::vector<Tensor>{g};
+    });
     return out;
 }
 
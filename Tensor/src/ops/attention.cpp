@@ -0,0 +1,321 @@
+#include "../../include/ops/attention.hpp"
+#include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
+#include "../../include/ops/matmul.hpp"
+#include "../../include/ops/softmax.hpp"
+#include "../../include/ops/transpose.hpp"
+#include "../../include/utils/Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace ops {
+
+namespace {
+
+constexpr int kQueryTile = 64;
+constexpr int kKeyTile = 64;
+constexpr double kNegInf = -std::numeric_limits<double>::infinity();
+
+struct AttentionShape {
+    int heads;
+    int lq;
+    int lk;
+    int d;
+    int dv;
+    double scale;
+    bool causal;
+};
+
+// Pointers to one head's rows.
+struct HeadData {
+    const double* Q;
+    const double* K;
+    const double* V;
+    const double* M;    // shared mask or null
+};
+
+HeadData head(const AttentionShape& s, const double* Q, const double* K, const double* V, const double* M, int h) {
+    return {Q + static_cast<size_t>(h) * s.lq * s.d, K + static_cast<size_t>(h) * s.lk * s.d,
+            V + static_cast<size_t>(h) * s.lk * s.dv, M};
+}
+
+// S[r - q0][c - k0] = scale * q_r . k_c + mask(r, c), or -inf where the causal rule hides c.
+void scoreTile(const AttentionShape& s, const HeadData& hd, int q0, int q1, int k0, int k1, double* S) {
+    for (int r = q0; r < q1; ++r) {
+        const double* qrow = hd.Q + static_cast<size_t>(r) * s.d;
+        double* srow = S + static_cast<size_t>(r - q0) * kKeyTile;
+        int end = s.causal ? std::min(k1, r + 1) : k1;
+        int c = k0;
+        // Four keys per pass: independent sums keep the FPU busy, each still in order over e.
+        for (; c + 4 <= end; c += 4) {
+            const double* k0row = hd.K + static_cast<size_t>(c) * s.d;
+            const double* k1row = k0row + s.d;
+            const double* k2row = k1row + s.d;
+            const double* k3row = k2row + s.d;
+            double d0 = 0.0, d1 = 0.0, d2 = 0.0, d3 = 0.0;
+            for (int e = 0; e < s.d; ++e) {
+                double qe = qrow[e];
+                d0 += qe * k0row[e];
+                d1 += qe * k1row[e];
+                d2 += qe * k2row[e];
+                d3 += qe * k3row[e];
+            }
+            srow[c - k0] = d0 * s.scale;
+            srow[c + 1 - k0] = d1 * s.scale;
+            srow[c + 2 - k0] = d2 * s.scale;
+            srow[c + 3 - k0] = d3 * s.scale;
+        }
+        for (; c < end; ++c) {
+            const double* krow = hd.K + static_cast<size_t>(c) * s.d;
+            double dot = 0.0;
+            for (int e = 0; e < s.d; ++e) dot += qrow[e] * krow[e];
+            srow[c - k0] = dot * s.scale;
+        }
+        for (; c < k1; ++c) srow[c - k0] = kNegInf;
+        if (hd.M) {
+            const double* mrow = hd.M + static_cast<size_t>(r) * s.lk;
+            for (int j = k0; j < end; ++j) srow[j - k0] += mrow[j];
+        }
+    }
+}
+
+// Query rows [q0, q1) of one head. Output rows hold the unnormalized sum of p * v while
+// the key tiles stream by; the running max m and denominator l rescale it on the way.
+void forwardTile(const AttentionShape& s, const HeadData& hd, int q0, int q1, double* O, double* lse) {
+    std::vector<double> S(static_cast<size_t>(kQueryTile) * kKeyTile);
+    std::vector<double> m(q1 - q0, kNegInf), l(q1 - q0, 0.0);
+    for (int k0 = 0; k0 < s.lk; k0 += kKeyTile) {
+        if (s.causal && k0 >= q1) break;
+        int k1 = std::min(s.lk, k0 + kKeyTile);
+        scoreTile(s, hd, q0, q1, k0, k1, S.data());
+        for (int r = q0; r < q1; ++r) {
+            const double* srow = S.data() + static_cast<size_t>(r - q0) * kKeyTile;
+            double mx = m[r - q0];
+            for (int c = 0; c < k1 - k0; ++c) mx = std::max(mx, srow[c]);
+            if (mx == kNegInf) continue;
+            double* orow = O + static_cast<size_t>(r) * s.dv;
+            double corr = std::exp(m[r - q0] - mx);
+            if (corr != 1.0) {
+                for (int e = 0; e < s.dv; ++e) orow[e] *= corr;
+            }
+            double sum = 0.0;
+            for (int c = 0; c < k1 - k0; ++c) {
+                double p = std::exp(srow[c] - mx);
+                if (p == 0.0) continue;
+                sum += p;
+                const double* vrow = hd.V + static_cast<size_t>(k0 + c) * s.dv;
+                for (int e = 0; e < s.dv; ++e) orow[e] += p * vrow[e];
+            }
+            l[r - q0] = l[r - q0] * corr + sum;
+            m[r - q0] = mx;
+        }
+    }
+    for (int r = q0; r < q1; ++r) {
+        double lr = l[r - q0];
+        if (lr == 0.0) {
+            lse[r] = kNegInf;
+            continue;
+        }
+        double* orow = O + static_cast<size_t>(r) * s.dv;
+        double inv = 1.0 / lr;
+        for (int e = 0; e < s.dv; ++e) orow[e] *= inv;
+        lse[r] = m[r - q0] + std::log(lr);
+    }
+}
+
+struct HeadGrads {
+    double* dQ;
+    double* dK;
+    double* dV;
+    double* dM;
+};
+
+// One head, FlashAttention-2 style: P = exp(S - lse) is rebuilt tile by tile, and with
+// D_r = dO_r . O_r, dS = P * (dO V^T - D) feeds dQ, dK (and the mask); dV += P^T dO.
+void backwardHead(const AttentionShape& s, const HeadData& hd, const double* O, const double* lse, const double* dO,
+                  const HeadGrads& g) {
+    std::vector<double> S(static_cast<size_t>(kQueryTile) * kKeyTile);
+    std::vector<double> D(s.lq);
+    for (int r = 0; r < s.lq; ++r) {
+        const double* orow = O + static_cast<size_t>(r) * s.dv;
+        const double* grow = dO + static_cast<size_t>(r) * s.dv;
+        double sum = 0.0;
+        for (int e = 0; e < s.dv; ++e) sum += grow[e] * orow[e];
+        D[r] = sum;
+    }
+    bool need_ds = g.dQ || g.dK || g.dM;
+
+    for (int q0 = 0; q0 < s.lq; q0 += kQueryTile) {
+        int q1 = std::min(s.lq, q0 + kQueryTile);
+        for (int k0 = 0; k0 < s.lk; k0 += kKeyTile) {
+            if (s.causal && k0 >= q1) break;
+            int k1 = std::min(s.lk, k0 + kKeyTile);
+            scoreTile(s, hd, q0, q1, k0, k1, S.data());
+            for (int r = q0; r < q1; ++r) {
+                if (lse[r] == kNegInf) continue;
+                const double* srow = S.data() + static_cast<size_t>(r - q0) * kKeyTile;
+                const double* qrow = hd.Q + static_cast<size_t>(r) * s.d;
+                const double* grow = dO + static_cast<size_t>(r) * s.dv;
+                for (int c = k0; c < k1; ++c) {
+                    double p = std::exp(srow[c - k0] - lse[r]);
+                    if (p == 0.0) continue;
+                    const double* vrow = hd.V + static_cast<size_t>(c) * s.dv;
+                    if (g.dV) {
+                        double* dvrow = g.dV + static_cast<size_t>(c) * s.dv;
+                        for (int e = 0; e < s.dv; ++e) dvrow[e] += p * grow[e];
+                    }
+                    if (!need_ds) continue;
+                    double dp = 0.0;
+                    for (int e = 0; e < s.dv; ++e) dp += grow[e] * vrow[e];
+                    double ds = p * (dp - D[r]);
+                    if (g.dM) g.dM[static_cast<size_t>(r) * s.lk + c] += ds;
+                    ds *= s.scale;
+                    const double* krow = hd.K + static_cast<size_t>(c) * s.d;
+                    if (g.dQ) {
+                        double* dqrow = g.dQ + static_cast<size_t>(r) * s.d;
+                        for (int e = 0; e < s.d; ++e) dqrow[e] += ds * krow[e];
+                    }
+                    if (g.dK) {
+                        double* dkrow = g.dK + static_cast<size_t>(c) * s.d;
+                        for (int e = 0; e < s.d; ++e) dkrow[e] += ds * qrow[e];
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Additive mask with -inf above the diagonal, for the op-built double backward.
+Tensor causalMask(int lq, int lk) {
+    Tensor m({lq, lk});
+    auto& data = m.getMutableData();
+    for (int r = 0; r < lq; ++r) {
+        for (int c = r + 1; c < lk; ++c) data[static_cast<size_t>(r) * lk + c] = kNegInf;
+    }
+    return m;
+}
+
+// Differentiable backward: the probabilities are rebuilt with matmul + softmax (so the
+// L x L matrix is materialized here), then dS = P * (dP - rowsum(dP * P)).
+std::vector<Tensor> attention_vjp(bool causal, const Tensor&, const std::vector<Tensor>& in, const Tensor& g) {
+    const Tensor& q = in[0];
+    const Tensor& k = in[1];
+    const Tensor& v = in[2];
+    if (q.rank() != 2) throw std::runtime_error("scaled_dot_product_attention double backward supports 2D inputs only!");
+    int lq = q.shapeView()[0], lk = k.shapeView()[0];
+    double scale = 1.0 / std::sqrt(static_cast<double>(q.shapeView()[1]));
+    Tensor S = ops::matmul(q, ops::transpose(k)) * scale;
+    if (in.size() > 3) S = S + in[3];
+    if (causal) S = S + causalMask(lq, lk);
+    Tensor P = ops::softmax(S);
+    Tensor dP = ops::matmul(g, ops::transpose(v));
+    Tensor rows = ops::matmul(ops::matmul(dP * P, Tensor::ones({lk, 1})), Tensor::ones({1, lk}));
+    Tensor dS = P * (dP - rows);
+    std::vector<Tensor> grads = {q.requiresGrad() ? ops::matmul(dS, k) * scale : Tensor(),
+                                 k.requiresGrad() ? ops::matmul(ops::transpose(dS), q) * scale : Tensor(),
+                                 v.requiresGrad() ? ops::matmul(ops::transpose(P), g) : Tensor()};
+    if (in.size() > 3) grads.push_back(in[3].requiresGrad() ? dS : Tensor());
+    return grads;
+}
+
+} // namespace
+
+Tensor scaled_dot_product_attention(const Tensor& q, const Tensor& k, const Tensor& v, const Tensor& mask,
+                                    bool causal) {
+    profiler::OpScope prof("scaled_dot_product_attention", {&q, &k, &v, &mask});
+    bool has_mask = !mask.isEmpty();
+    for (const Tensor* t : {&q, &k, &v, &mask}) {
+        if (t->isEmpty()) continue;
+        if (isLowPrecision(*t)) {
+            throw std::runtime_error("scaled_dot_product_attention requires float64 tensors; convert with to(DType::Float64) first");
+        }
+        if (has_tangent(*t)) throw std::runtime_error("scaled_dot_product_attention does not propagate forward-mode tangents");
+    }
+    const auto& sq = q.shapeView();
+    const auto& sk = k.shapeView();
+    const auto& sv = v.shapeView();
+    size_t rank = sq.size();
+    if (rank < 2 || sk.size() != rank || sv.size() != rank) {
+        throw std::invalid_argument("scaled_dot_product_attention: q, k, v must have the same rank (>= 2)!");
+    }
+    int heads = 1;
+    for (size_t i = 0; i + 2 < rank; ++i) {
+        if (sk[i] != sq[i] || sv[i] != sq[i]) {
+            throw std::invalid_argument("scaled_dot_product_attention: leading dims of q, k, v differ!");
+        }
+        heads *= sq[i];
+    }
+    int lq = sq[rank - 2], d = sq[rank - 1], lk = sk[rank - 2], dv = sv[rank - 1];
+    if (sk[rank - 1] != d) throw std::invalid_argument("scaled_dot_product_attention: q and k feature dims differ!");
+    if (sv[rank - 2] != lk) throw std::invalid_argument("scaled_dot_product_attention: k and v lengths differ!");
+    if (d == 0) throw std::invalid_argument("scaled_dot_product_attention: zero feature dim!");
+    if (has_mask && (mask.rank() != 2 || mask.shapeView()[0] != lq || mask.shapeView()[1] != lk)) {
+        throw std::invalid_argument("scaled_dot_product_attention: mask must be [Lq, Lk]!");
+    }
+
+    AttentionShape s{heads, lq, lk, d, dv, 1.0 / std::sqrt(static_cast<double>(d)), causal};
+    DimVector out_shape = sq;
+    out_shape[rank - 1] = dv;
+    bool req_grad = q.requiresGrad() || k.requiresGrad() || v.requiresGrad() || (has_mask && mask.requiresGrad());
+    Tensor out(out_shape, req_grad);
+    auto lse = std::make_shared<std::vector<double>>(static_cast<size_t>(heads) * lq);
+
+    const double* Q = q.getData().data();
+    const double* K = k.getData().data();
+    const double* V = v.getData().data();
+    const double* M = has_mask ? mask.getData().data() : nullptr;
+    double* O = out.getMutableData().data();
+    int tiles = (lq + kQueryTile - 1) / kQueryTile;
+    parallel::parallel_for(0, static_cast<int64_t>(heads) * tiles, 1, [&](int64_t lo, int64_t hi) {
+        for (int64_t idx = lo; idx < hi; ++idx) {
+            int h = static_cast<int>(idx / tiles);
+            int q0 = static_cast<int>(idx % tiles) * kQueryTile;
+            forwardTile(s, head(s, Q, K, V, M, h), q0, std::min(lq, q0 + kQueryTile),
+                        O + static_cast<size_t>(h) * lq * dv, lse->data() + static_cast<size_t>(h) * lq);
+        }
+    });
+
+    if (!should_record(out)) return out;
+    auto& parents = out.getImpl()->parents;
+    parents.reserve(4);
+    parents.push_back(q);
+    parents.push_back(k);
+    parents.push_back(v);
+    if (has_mask) parents.push_back(mask);
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_backward_fn(out, [out_weak, s, q, k, v, mask, has_mask, lse]() {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        auto grad = [](const Tensor& t) { return t.requiresGrad() ? t.getMutableGrad().data() : nullptr; };
+        double* dQ = grad(q);
+        double* dK = grad(k);
+        double* dV = grad(v);
+        double* dM = has_mask ? grad(mask) : nullptr;
+        const double* M = has_mask ? mask.getData().data() : nullptr;
+        auto run = [&](int h) {
+            HeadData hd = head(s, q.getData().data(), k.getData().data(), v.getData().data(), M, h);
+            size_t qo = static_cast<size_t>(h) * s.lq, ko = static_cast<size_t>(h) * s.lk;
+            HeadGrads g{dQ ? dQ + qo * s.d : nullptr, dK ? dK + ko * s.d : nullptr, dV ? dV + ko * s.dv : nullptr, dM};
+            backwardHead(s, hd, out_impl->data.data() + qo * s.dv, lse->data() + qo, out_impl->grad.data() + qo * s.dv, g);
+        };
+        // Heads write disjoint rows, except for the shared mask gradient.
+        if (dM) {
+            for (int h = 0; h < s.heads; ++h) run(h);
+        } else {
+            parallel::parallel_for(0, s.heads, 1, [&](int64_t lo, int64_t hi) {
+                for (int64_t h = lo; h < hi; ++h) run(static_cast<int>(h));
+            });
+        }
+    });
+    attach_vjp(out, [causal](const Tensor& o, const std::vector<Tensor>& in, const Tensor& g) {
+        return attention_vjp(causal, o, in, g);
+    });
+    memory::onGraphAttach(*out.getImpl(), lse->size() * sizeof(double));
+    return out;
+}
+
+} // namespace ops
@@ -0,0 +1,45 @@
+#include "../../include/ops/cast.hpp"
+#include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
+#include <stdexcept>
+
+namespace ops {
+
+Tensor cast(const Tensor& t, DType dtype) {
+    profiler::OpScope prof("cast", {&t});
+    DType src = t.dtype();
+    if (src == dtype) return t;
+    if (t.hasTangent()) throw std::runtime_error("Forward-mode AD requires float64 tensors!");
+
+    Tensor out(t.shapeView(), dtype, t.requiresGrad());
+    if (src == DType::Float64) {
+        const auto& dt = t.getData();
+        auto& dout = out.getMutableHalfData();
+        for (size_t i = 0; i < dt.size(); ++i) dout[i] = half::encode(dtype, static_cast<float>(dt[i]));
+    } else if (dtype == DType::Float64) {
+        const auto& dt = t.getHalfData();
+        auto& dout = out.getMutableData();
+        for (size_t i = 0; i < dt.size(); ++i) dout[i] = half::decode(src, dt[i]);
+    } else {
+        const auto& dt = t.getHalfData();
+        auto& dout = out.getMutableHalfData();
+        for (size_t i = 0; i < dt.size(); ++i) dout[i] = half::encode(dtype, half::decode(src, dt[i]));
+    }
+
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_unary_backward(out, t, [out_weak, t]() mutable {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        if (!t.requiresGrad()) return;
+        const auto& og = out_impl->grad;
+        if (isLowPrecision(t)) {
+            accumulateLowPrecisionGrad(t, og, 1.0);
+        } else {
+            auto& tg = t.getMutableGrad();
+            for (size_t i = 0; i < og.size(); ++i) tg[i] += og[i];
+        }
+    });
+    return out;
+}
+
+} // namespace ops
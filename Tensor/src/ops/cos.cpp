@@ -1,15 +1,28 @@
 #include "../../include/ops/cos.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/sin.hpp"
 #include <cmath>
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> cos_vjp(const Tensor&, const std::vector<Tensor>& in, const Tensor& g) {
+    return {-(g * ops::sin(in[0]))};
+}
+
+} // namespace
+
 Tensor cos(const Tensor& t) {
-    Tensor out(t.getShape(), t.requiresGrad());
+    profiler::OpScope prof("cos", {&t});
+    Tensor out(t.shapeView(), t.requiresGrad());
     const auto& dt = t.getData();
     auto& dout = out.getMutableData();
     for (size_t i = 0; i < dt.size(); ++i) dout[i] = std::cos(dt[i]);
 
+    unary_tangent(out, t, [&](int i) { return -std::sin(dt[i]); });
+    if (record_on_tape(out, autograd::TapeOp::Cos, t)) return out;
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_unary_backward(out, t, [out_weak, t]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -20,6 +33,7 @@ Tensor cos(const Tensor& t) {
             for (size_t i = 0; i < og.size(); ++i) tg[i] += og[i] * (-std::sin(dt[i]));
         }
     });
+    attach_vjp(out, cos_vjp);
     return out;
 }
 
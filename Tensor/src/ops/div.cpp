@@ -1,19 +1,37 @@
 #include "../../include/ops/div.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
+#include "../../include/utils/Reduce.hpp"
 #include <stdexcept>
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> div_vjp(const Tensor&, const std::vector<Tensor>& in, const Tensor& g) {
+    const Tensor& a = in[0];
+    const Tensor& b = in[1];
+    return {a.requiresGrad() ? unbroadcast(a, g / b) : Tensor(),
+            b.requiresGrad() ? unbroadcast(b, -(g * a) / (b * b)) : Tensor()};
+}
+
+} // namespace
+
 Tensor div(const Tensor& a, const Tensor& b) {
+    profiler::OpScope prof("div", {&a, &b});
     bool req_grad = a.requiresGrad() || b.requiresGrad();
     
     if (!a.isScalar() && b.isScalar()) {
-        Tensor out(a.getShape(), req_grad);
+        Tensor out(a.shapeView(), req_grad);
         const auto& da = a.getData();
         double val_b = b.at({0});
         auto& dout = out.getMutableData();
         for (size_t i = 0; i < da.size(); ++i) dout[i] = da[i] / val_b;
 
+        binary_tangent(out, a, b, [&](int) { return 1.0 / val_b; },
+                       [&](int i) { return -da[i] / (val_b * val_b); });
+        if (record_on_tape(out, autograd::TapeOp::Div, a, &b)) return out;
         auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
         attach_binary_backward(out, a, b, [out_weak, a, b]() mutable {
             auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -25,24 +43,27 @@ Tensor div(const Tensor& a, const Tensor& b) {
                 for (size_t i = 0; i < og.size(); ++i) ag[i] += og[i] / val_b;
             }
             if (b.requiresGrad()) {
-                double sum_g = 0.0;
-                for (size_t i = 0; i < og.size(); ++i) sum_g += og[i] * (-da[i] / (val_b * val_b));
+                double sum_g = -reduce::dot(og.data(), da.data(), og.size()) / (val_b * val_b);
                 b.getMutableGrad()[0] += sum_g;
             }
         });
+        attach_vjp(out, div_vjp);
         return out;
     }
 
-    if (a.getShape() != b.getShape()) {
+    if (a.shapeView() != b.shapeView()) {
         throw std::invalid_argument("Shape mismatch in ops::div!");
     }
 
-    Tensor out(a.getShape(), req_grad);
+    Tensor out(a.shapeView(), req_grad);
     const auto& da = a.getData();
     const auto& db = b.getData();
     auto& dout = out.getMutableData();
     for (size_t i = 0; i < da.size(); ++i) dout[i] = da[i] / db[i];
 
+    binary_tangent(out, a, b, [&](int i) { return 1.0 / db[i]; },
+                   [&](int i) { return -da[i] / (db[i] * db[i]); });
+    if (record_on_tape(out, autograd::TapeOp::Div, a, &b)) return out;
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_binary_backward(out, a, b, [out_weak, a, b]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -58,7 +79,44 @@ Tensor div(const Tensor& a, const Tensor& b) {
             for (size_t i = 0; i < og.size(); ++i) bg[i] += og[i] * (-da[i] / (db[i] * db[i]));
         }
     });
+    attach_vjp(out, div_vjp);
+
+    return out;
+}
 
+Tensor div(const Tensor& a, double b) {
+    profiler::OpScope prof("div", {&a});
+
+    if (isLowPrecision(a)) {
+        float bf = static_cast<float>(b);
+        Tensor out = mapLowPrecision(a, a.requiresGrad(), [bf](float x) { return x / bf; });
+        auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+        attach_unary_backward(out, a, [out_weak, a, b]() mutable {
+            auto out_impl = out_weak.lock(); if (!out_impl) return;
+            if (a.requiresGrad()) accumulateLowPrecisionGrad(a, out_impl->grad, 1.0 / b);
+        });
+        return out;
+    }
+
+    Tensor out(a.shapeView(), a.requiresGrad());
+    const auto& da = a.getData();
+    auto& dout = out.getMutableData();
+    for (size_t i = 0; i < da.size(); ++i) dout[i] = da[i] / b;
+
+    unary_tangent(out, a, [b](int) { return 1.0 / b; });
+    if (record_on_tape(out, autograd::TapeOp::DivScalar, a, nullptr, b)) return out;
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_unary_backward(out, a, [out_weak, a, b]() mutable {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        const auto& og = out_impl->grad;
+        if (a.requiresGrad()) {
+            auto& ag = a.getMutableGrad();
+            for (size_t i = 0; i < og.size(); ++i) ag[i] += og[i] / b;
+        }
+    });
+    attach_vjp(out, [b](const Tensor&, const std::vector<Tensor>&, const Tensor& g) {
+        return std::vector<Tensor>{g / b};
+    });
     return out;
 }
 
@@ -0,0 +1,66 @@
+#include "../../include/ops/dropout.hpp"
+#include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/utils/Parallel.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ops {
+
+namespace {
+
+constexpr int64_t kPerBatch = 4 * rng::kLanes;
+
+// dst[i] = src[i] * mask[i] (or +=), where mask[i] = scale if value i of the Philox
+// stream at `at` is below keep_prob, else 0: the same draws as rng::bernoulli.
+template <bool Accumulate>
+void applyMask(const double* src, double* dst, int64_t n, rng::PhiloxState at, double keep_prob, double scale) {
+    int64_t batches = (n + kPerBatch - 1) / kPerBatch;
+    parallel::parallel_for(0, batches, 512, [&](int64_t lo, int64_t hi) {
+        uint32_t r[4][rng::kLanes];
+        for (int64_t b = lo; b < hi; ++b) {
+            rng::philoxBatch(at.seed, at.offset + static_cast<uint64_t>(b) * rng::kLanes, r);
+            int64_t first = b * kPerBatch;
+            int64_t count = std::min(kPerBatch, n - first);
+            for (int64_t i = 0; i < count; ++i) {
+                double m = rng::toUnitFloat(r[i % 4][i / 4]) < keep_prob ? scale : 0.0;
+                if (Accumulate) dst[first + i] += src[first + i] * m;
+                else dst[first + i] = src[first + i] * m;
+            }
+        }
+    });
+}
+
+Tensor dropoutAt(const Tensor& t, rng::PhiloxState at, double keep_prob) {
+    Tensor out(t.shapeView(), t.requiresGrad());
+    double scale = keep_prob > 0.0 ? 1.0 / keep_prob : 0.0;
+    int64_t n = t.size();
+    applyMask<false>(t.getData().data(), out.getMutableData().data(), n, at, keep_prob, scale);
+    if (const double* tt = tangent_of(t)) applyMask<false>(tt, make_tangent(out), n, at, keep_prob, scale);
+
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_unary_backward(out, t, [out_weak, t, at, keep_prob, scale]() mutable {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        if (!t.requiresGrad()) return;
+        applyMask<true>(out_impl->grad.data(), t.getMutableGrad().data(), t.size(), at, keep_prob, scale);
+    });
+    attach_vjp(out, [at, keep_prob](const Tensor&, const std::vector<Tensor>&, const Tensor& g) -> std::vector<Tensor> {
+        return {dropoutAt(g, at, keep_prob)};
+    });
+    return out;
+}
+
+} // namespace
+
+Tensor dropout(const Tensor& t, double p, bool training, rng::Generator* gen) {
+    profiler::OpScope prof("dropout", {&t});
+    if (p < 0.0 || p > 1.0) throw std::invalid_argument("Dropout probability must be in [0, 1]!");
+    if (!training || p == 0.0) return t;
+    if (t.dtype() != DType::Float64) throw std::runtime_error("dropout requires a float64 tensor!");
+
+    int64_t batches = (static_cast<int64_t>(t.size()) + kPerBatch - 1) / kPerBatch;
+    rng::Generator& g = gen ? *gen : rng::defaultGenerator();
+    return dropoutAt(t, g.reserve(static_cast<uint64_t>(batches) * rng::kLanes), 1.0 - p);
+}
+
+} // namespace ops
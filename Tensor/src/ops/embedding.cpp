@@ -0,0 +1,166 @@
+#include "../../include/ops/embedding.hpp"
+#include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
+#include "../../include/utils/Parallel.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace ops {
+
+namespace {
+
+// Roughly 16K elements of work per chunk.
+int64_t grainFor(int64_t width) { return std::max<int64_t>(1, 16384 / std::max<int64_t>(1, width)); }
+
+// Positions of `indices` grouped by row: order[start[k] .. start[k + 1]) all look up the
+// same row, in increasing position, so each group can be summed by one thread.
+struct RowGroups {
+    std::vector<int> order;
+    std::vector<int> start;
+};
+
+RowGroups groupByRow(const std::vector<int>& indices) {
+    RowGroups groups;
+    groups.order.resize(indices.size());
+    std::iota(groups.order.begin(), groups.order.end(), 0);
+    std::stable_sort(groups.order.begin(), groups.order.end(),
+                     [&](int a, int b) { return indices[a] < indices[b]; });
+    for (size_t i = 0; i < groups.order.size(); ++i) {
+        if (i == 0 || indices[groups.order[i]] != indices[groups.order[i - 1]]) {
+            groups.start.push_back(static_cast<int>(i));
+        }
+    }
+    groups.start.push_back(static_cast<int>(groups.order.size()));
+    return groups;
+}
+
+// dst(row) += sum of g rows looking it up, one group per iteration.
+template <typename Dst>
+void scatterRows(const RowGroups& groups, const std::vector<int>& indices, const double* g, int dim, Dst&& dst) {
+    int64_t num_groups = static_cast<int64_t>(groups.start.size()) - 1;
+    parallel::parallel_for(0, num_groups, grainFor(dim), [&](int64_t lo, int64_t hi) {
+        for (int64_t k = lo; k < hi; ++k) {
+            double* out = dst(indices[groups.order[groups.start[k]]]);
+            for (int i = groups.start[k]; i < groups.start[k + 1]; ++i) {
+                const double* grow = g + static_cast<size_t>(groups.order[i]) * dim;
+                for (int j = 0; j < dim; ++j) out[j] += grow[j];
+            }
+        }
+    });
+}
+
+} // namespace
+
+size_t RowSparseGrad::bytes() const {
+    return rows_.capacity() * sizeof(int) + values_.capacity() * sizeof(double) +
+           slot_.size() * (sizeof(int) * 2 + sizeof(void*));
+}
+
+void RowSparseGrad::accumulate(const std::vector<int>& indices, const double* g, int dim) {
+    if (dim_ != 0 && dim_ != dim) {
+        throw std::invalid_argument("RowSparseGrad: row width " + std::to_string(dim) + " does not match " +
+                                    std::to_string(dim_) + "!");
+    }
+    dim_ = dim;
+    // New rows get their slots serially, in first-touch order.
+    for (int r : indices) {
+        if (slot_.emplace(r, static_cast<int>(rows_.size())).second) rows_.push_back(r);
+    }
+    values_.resize(rows_.size() * static_cast<size_t>(dim_), 0.0);
+    RowGroups groups = groupByRow(indices);
+    double* base = values_.data();
+    scatterRows(groups, indices, g, dim_,
+                [&](int r) { return base + static_cast<size_t>(slot_.find(r)->second) * dim_; });
+}
+
+void RowSparseGrad::clear() {
+    rows_.clear();
+    values_.clear();
+    slot_.clear();
+}
+
+void RowSparseGrad::sgdStep(const Tensor& table, double lr) {
+    if (isLowPrecision(table)) {
+        throw std::runtime_error("RowSparseGrad::sgdStep requires a float64 table; convert with to(DType::Float64) first");
+    }
+    const auto& shape = table.shapeView();
+    if (shape.size() != 2 || (!rows_.empty() && shape[1] != dim_)) {
+        throw std::invalid_argument("RowSparseGrad::sgdStep: table must be [num_rows, " + std::to_string(dim_) + "]!");
+    }
+    int num_rows = shape[0];
+    for (int r : rows_) {
+        if (r < 0 || r >= num_rows) throw std::out_of_range("RowSparseGrad::sgdStep: row index out of range!");
+    }
+    double* W = table.getMutableData().data();
+    const double* V = values_.data();
+    int dim = dim_;
+    parallel::parallel_for(0, static_cast<int64_t>(rows_.size()), grainFor(dim), [&](int64_t lo, int64_t hi) {
+        for (int64_t k = lo; k < hi; ++k) {
+            double* wrow = W + static_cast<size_t>(rows_[k]) * dim;
+            const double* grow = V + static_cast<size_t>(k) * dim;
+            for (int j = 0; j < dim; ++j) wrow[j] -= lr * grow[j];
+        }
+    });
+    clear();
+}
+
+Tensor RowSparseGrad::toDense(int num_rows) const {
+    Tensor out({num_rows, std::max(dim_, 1)});
+    auto& d = out.getMutableData();
+    for (size_t k = 0; k < rows_.size(); ++k) {
+        if (rows_[k] < 0 || rows_[k] >= num_rows) throw std::out_of_range("RowSparseGrad::toDense: row index out of range!");
+        std::copy_n(values_.begin() + k * dim_, dim_, d.begin() + static_cast<size_t>(rows_[k]) * dim_);
+    }
+    return out;
+}
+
+Tensor embedding(const Tensor& table, const std::vector<int>& indices, const std::shared_ptr<RowSparseGrad>& sparse_grad) {
+    profiler::OpScope prof("embedding", {&table});
+    if (isLowPrecision(table)) {
+        throw std::runtime_error("ops::embedding requires a float64 table; convert with to(DType::Float64) first");
+    }
+    if (has_tangent(table)) throw std::runtime_error("ops::embedding does not propagate forward-mode tangents");
+    const auto& shape = table.shapeView();
+    if (shape.size() != 2) throw std::invalid_argument("ops::embedding requires a 2D [num_rows, dim] table!");
+    int num_rows = shape[0], dim = shape[1];
+    int n = static_cast<int>(indices.size());
+    for (int r : indices) {
+        if (r < 0 || r >= num_rows) {
+            throw std::out_of_range("ops::embedding: index " + std::to_string(r) + " out of range for " +
+                                    std::to_string(num_rows) + " rows!");
+        }
+    }
+
+    bool dense_grad = table.requiresGrad() && !sparse_grad;
+    Tensor out({n, dim}, dense_grad || sparse_grad != nullptr);
+    const double* W = table.getData().data();
+    double* O = out.getMutableData().data();
+    parallel::parallel_for(0, n, grainFor(dim), [&](int64_t lo, int64_t hi) {
+        for (int64_t i = lo; i < hi; ++i) {
+            std::copy_n(W + static_cast<size_t>(indices[i]) * dim, dim, O + static_cast<size_t>(i) * dim);
+        }
+    });
+
+    if (!should_record(out)) return out;
+    // The sparse path keeps the table off the graph: its gradient goes to sparse_grad only.
+    if (dense_grad) out.getImpl()->parents.push_back(table);
+    auto ids = std::make_shared<std::vector<int>>(indices);
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_backward_fn(out, [out_weak, table, ids, sparse_grad, dim]() {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        const double* g = out_impl->grad.data();
+        if (sparse_grad) {
+            sparse_grad->accumulate(*ids, g, dim);
+            return;
+        }
+        double* dW = table.getMutableGrad().data();
+        scatterRows(groupByRow(*ids), *ids, g, dim, [&](int r) { return dW + static_cast<size_t>(r) * dim; });
+    });
+    memory::onGraphAttach(*out.getImpl(), ids->size() * sizeof(int));
+    return out;
+}
+
+} // namespace ops
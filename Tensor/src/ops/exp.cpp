@@ -1,15 +1,27 @@
 #include "../../include/ops/exp.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
 #include <cmath>
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> exp_vjp(const Tensor& out, const std::vector<Tensor>&, const Tensor& g) {
+    return {g * out};
+}
+
+} // namespace
+
 Tensor exp(const Tensor& a) {
-    Tensor out(a.getShape(), a.requiresGrad());
+    profiler::OpScope prof("exp", {&a});
+    Tensor out(a.shapeView(), a.requiresGrad());
     const auto& da = a.getData();
     auto& dout = out.getMutableData();
     for (size_t i = 0; i < da.size(); ++i) dout[i] = std::exp(da[i]);
 
+    unary_tangent(out, a, [&](int i) { return dout[i]; });
+    if (record_on_tape(out, autograd::TapeOp::Exp, a)) return out;
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_unary_backward(out, a, [out_weak, a]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -20,6 +32,7 @@ Tensor exp(const Tensor& a) {
             for (size_t i = 0; i < og.size(); ++i) ag[i] += og[i] * dout[i];
         }
     });
+    attach_vjp(out, exp_vjp);
     return out;
 }
 
@@ -1,5 +1,8 @@
 #include "../../include/ops/inverse.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/matmul.hpp"
+#include "../../include/ops/transpose.hpp"
 #include <vector>
 #include <cmath>
 #include <algorithm>
@@ -7,65 +10,127 @@
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> inverse_vjp(const Tensor& out, const std::vector<Tensor>&, const Tensor& g) {
+    Tensor yt = ops::transpose(out);
+    return {-ops::matmul(ops::matmul(yt, g), yt)};
+}
+
+} // namespace
+
 Tensor inverse(const Tensor& t) {
-    auto shape = t.getShape();
+    profiler::OpScope prof("inverse", {&t});
+    const auto& shape = t.shapeView();
     if (shape.size() != 2 || shape[0] != shape[1]) {
         throw std::invalid_argument("Inverse requires a square 2D matrix!");
     }
     int n = shape[0];
     Tensor out({n, n}, t.requiresGrad());
 
-    std::vector<std::vector<double>> aug(n, std::vector<double>(2 * n, 0.0));
+    // Gauss-Jordan on a flat [n, 2n] augmented buffer.
+    std::vector<double> aug_buf(static_cast<size_t>(n) * 2 * n, 0.0);
+    TensorAccessor<double, 2> aug(aug_buf.data(), {n, 2 * n});
+    auto T = t.accessor<2>();
     for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) aug[i][j] = t.at({i, j});
-        aug[i][n + i] = 1.0;
+        const double* trow = T.row(i);
+        double* arow = aug.row(i);
+        for (int j = 0; j < n; ++j) arow[j] = trow[j];
+        arow[n + i] = 1.0;
     }
 
     for (int i = 0; i < n; ++i) {
-        double max_el = std::abs(aug[i][i]);
+        double max_el = std::abs(aug(i, i));
         int pivot = i;
         for (int k = i + 1; k < n; ++k) {
-            if (std::abs(aug[k][i]) > max_el) {
-                max_el = std::abs(aug[k][i]);
+            if (std::abs(aug(k, i)) > max_el) {
+                max_el = std::abs(aug(k, i));
                 pivot = k;
             }
         }
         if (max_el < 1e-12) throw std::runtime_error("Matrix is singular or nearly singular!");
-        if (pivot != i) std::swap(aug[i], aug[pivot]);
+        double* irow = aug.row(i);
+        if (pivot != i) std::swap_ranges(irow, irow + 2 * n, aug.row(pivot));
 
-        double div_val = aug[i][i];
-        for (int j = 0; j < 2 * n; ++j) aug[i][j] /= div_val;
+        double div_val = irow[i];
+        for (int j = 0; j < 2 * n; ++j) irow[j] /= div_val;
 
         for (int k = 0; k < n; ++k) {
             if (k != i) {
-                double factor = aug[k][i];
-                for (int j = 0; j < 2 * n; ++j) aug[k][j] -= factor * aug[i][j];
+                double* krow = aug.row(k);
+                double factor = krow[i];
+                for (int j = 0; j < 2 * n; ++j) krow[j] -= factor * irow[j];
             }
         }
     }
 
+    auto O = out.accessor<2>();
     for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            out.set({i, j}, aug[i][n + j]);
-        }
+        const double* arow = aug.row(i);
+        double* orow = O.row(i);
+        for (int j = 0; j < n; ++j) orow[j] = arow[n + j];
     }
 
+    // Tangent: dY = -Y * dT * Y.
+    if (const double* tt = tangent_of(t)) {
+        std::vector<double> tmp_buf(static_cast<size_t>(n) * n, 0.0);
+        TensorAccessor<double, 2> tmp(tmp_buf.data(), {n, n});
+        TensorAccessor<const double, 2> dT(tt, {n, n});
+        TensorAccessor<double, 2> dY(make_tangent(out), {n, n});
+        // tmp = Y * dT
+        for (int i = 0; i < n; ++i) {
+            const double* orow = O.row(i);
+            double* trow = tmp.row(i);
+            for (int k = 0; k < n; ++k) {
+                double yik = orow[k];
+                const double* drow = dT.row(k);
+                for (int j = 0; j < n; ++j) trow[j] += yik * drow[j];
+            }
+        }
+        // dY = -tmp * Y
+        for (int i = 0; i < n; ++i) {
+            const double* trow = tmp.row(i);
+            double* yrow = dY.row(i);
+            for (int k = 0; k < n; ++k) {
+                double tik = trow[k];
+                const double* orow = O.row(k);
+                for (int j = 0; j < n; ++j) yrow[j] -= tik * orow[j];
+            }
+        }
+    }
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
-    attach_unary_backward(out, t, [out_weak, t, out, n]() mutable {
+    attach_unary_backward(out, t, [out_weak, t, n]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
         if (!t.requiresGrad()) return;
+        // dT = -Y^T * G * Y^T with Y = inverse(T), evaluated as two passes over rows.
+        auto Y = out_impl->dataAccessor<2>();
+        auto G = out_impl->gradAccessor<2>();
+        auto dT = t.gradAccessor<2>();
+        std::vector<double> tmp_buf(static_cast<size_t>(n) * n, 0.0);
+        TensorAccessor<double, 2> tmp(tmp_buf.data(), {n, n});
+        // tmp = Y^T * G
+        for (int k = 0; k < n; ++k) {
+            const double* yrow = Y.row(k);
+            const double* grow = G.row(k);
+            for (int i = 0; i < n; ++i) {
+                double yki = yrow[i];
+                double* trow = tmp.row(i);
+                for (int l = 0; l < n; ++l) trow[l] += yki * grow[l];
+            }
+        }
+        // dT(i, j) -= tmp.row(i) . Y.row(j)
         for (int i = 0; i < n; ++i) {
+            const double* trow = tmp.row(i);
+            double* drow = dT.row(i);
             for (int j = 0; j < n; ++j) {
-                double temp = 0.0;
-                for (int k = 0; k < n; ++k) {
-                    for (int l = 0; l < n; ++l) {
-                        temp += -out.at({k, i}) * out_impl->grad[k * n + l] * out.at({j, l});
-                    }
-                }
-                t.gradAt({i, j}) += temp;
+                const double* yrow = Y.row(j);
+                double sum = 0.0;
+                for (int l = 0; l < n; ++l) sum += trow[l] * yrow[l];
+                drow[j] -= sum;
             }
         }
     });
+    attach_vjp(out, inverse_vjp);
 
     return out;
 }
@@ -0,0 +1,261 @@
+#include "../../include/ops/linear.hpp"
+#include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
+#include "../../include/ops/matmul.hpp"
+#include "../../include/ops/transpose.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace ops {
+
+namespace {
+
+// Per-activation pieces, written as the standalone ops compute them so the fused
+// layer matches matmul + bias + activation bit for bit.
+template <Activation A>
+struct Act {
+    static double forward(double z) {
+        if constexpr (A == Activation::ReLU) return std::max(0.0, z);
+        else if constexpr (A == Activation::Sigmoid) return 1.0 / (1.0 + std::exp(-z));
+        else if constexpr (A == Activation::Tanh) return std::tanh(z);
+        else return z;
+    }
+    // Gradient wrt the pre-activation, from the output gradient g and output y.
+    static double backward(double g, double y) {
+        if constexpr (A == Activation::ReLU) return y > 0.0 ? g : 0.0;
+        else if constexpr (A == Activation::Sigmoid) return g * y * (1.0 - y);
+        else if constexpr (A == Activation::Tanh) return g * (1.0 - y * y);
+        else return g;
+    }
+};
+
+// out = act(x W + b), row by row: each output row is finished (bias + activation)
+// while it is still in cache from its GEMM accumulation.
+template <Activation A>
+void linearForward(const double* X, const double* W, const double* bias, double* out, int m, int n, int p) {
+    for (int i = 0; i < m; ++i) {
+        double* orow = out + static_cast<size_t>(i) * p;
+        for (int k = 0; k < n; ++k) {
+            double xik = X[static_cast<size_t>(i) * n + k];
+            const double* wrow = W + static_cast<size_t>(k) * p;
+            for (int j = 0; j < p; ++j) orow[j] += xik * wrow[j];
+        }
+        if (bias) {
+            for (int j = 0; j < p; ++j) orow[j] = Act<A>::forward(orow[j] + bias[j]);
+        } else if (A != Activation::None) {
+            for (int j = 0; j < p; ++j) orow[j] = Act<A>::forward(orow[j]);
+        }
+    }
+}
+
+// One pass over the output gradient: per row, the pre-activation gradient dz feeds the
+// bias sum, dx = dz W^T and dW += x^T dz before moving on.
+template <Activation A>
+void linearBackward(const TensorImpl& out, const Tensor& x, const Tensor& W, const Tensor* b, int m, int n, int p) {
+    auto X = x.accessor<2>();
+    auto Wa = W.accessor<2>();
+    std::vector<double> dz(p);
+    double* db = b && b->requiresGrad() ? b->getMutableGrad().data() : nullptr;
+    bool need_dx = x.requiresGrad(), need_dw = W.requiresGrad();
+    auto dX = need_dx ? x.gradAccessor<2>() : X;
+    auto dW = need_dw ? W.gradAccessor<2>() : Wa;
+
+    for (int i = 0; i < m; ++i) {
+        const double* grow = out.grad.data() + static_cast<size_t>(i) * p;
+        const double* yrow = out.data.data() + static_cast<size_t>(i) * p;
+        for (int j = 0; j < p; ++j) dz[j] = Act<A>::backward(grow[j], yrow[j]);
+        if (db) {
+            for (int j = 0; j < p; ++j) db[j] += dz[j];
+        }
+        if (need_dx) {
+            double* dxrow = dX.row(i);
+            for (int k = 0; k < n; ++k) {
+                const double* wrow = Wa.row(k);
+                double sum = 0.0;
+                for (int j = 0; j < p; ++j) sum += dz[j] * wrow[j];
+                dxrow[k] += sum;
+            }
+        }
+        if (need_dw) {
+            const double* xrow = X.row(i);
+            for (int k = 0; k < n; ++k) {
+                double xik = xrow[k];
+                double* dwrow = dW.row(k);
+                for (int j = 0; j < p; ++j) dwrow[j] += xik * dz[j];
+            }
+        }
+    }
+}
+
+template <typename F>
+void dispatch(Activation act, F&& f) {
+    switch (act) {
+    case Activation::None: f(std::integral_constant<Activation, Activation::None>()); break;
+    case Activation::ReLU: f(std::integral_constant<Activation, Activation::ReLU>()); break;
+    case Activation::Sigmoid: f(std::integral_constant<Activation, Activation::Sigmoid>()); break;
+    case Activation::Tanh: f(std::integral_constant<Activation, Activation::Tanh>()); break;
+    }
+}
+
+// O += A * B for row-major [m, n] x [n, p] buffers (tangent products).
+void accumulateProduct(const double* A, const double* B, double* O, int m, int n, int p) {
+    for (int i = 0; i < m; ++i) {
+        double* orow = O + static_cast<size_t>(i) * p;
+        for (int k = 0; k < n; ++k) {
+            double aik = A[static_cast<size_t>(i) * n + k];
+            const double* brow = B + static_cast<size_t>(k) * p;
+            for (int j = 0; j < p; ++j) orow[j] += aik * brow[j];
+        }
+    }
+}
+
+// Differentiable [m, p] -> [p] column sums and their adjoint, [p] -> [m, p] row copies,
+// for the gradient of a 1-D bias.
+Tensor repeatRows(const Tensor& v, int m);
+
+Tensor sumRows(const Tensor& t) {
+    int m = t.shapeView()[0], p = t.shapeView()[1];
+    Tensor out({p}, t.requiresGrad());
+    auto T = t.accessor<2>();
+    double* o = out.getMutableData().data();
+    for (int i = 0; i < m; ++i) {
+        const double* trow = T.row(i);
+        for (int j = 0; j < p; ++j) o[j] += trow[j];
+    }
+    if (const double* tt = tangent_of(t)) {
+        double* to = make_tangent(out);
+        for (int i = 0; i < m; ++i)
+            for (int j = 0; j < p; ++j) to[j] += tt[static_cast<size_t>(i) * p + j];
+    }
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_unary_backward(out, t, [out_weak, t, m, p]() mutable {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        if (!t.requiresGrad()) return;
+        auto dT = t.gradAccessor<2>();
+        for (int i = 0; i < m; ++i) {
+            double* dtrow = dT.row(i);
+            for (int j = 0; j < p; ++j) dtrow[j] += out_impl->grad[j];
+        }
+    });
+    attach_vjp(out, [m](const Tensor&, const std::vector<Tensor>&, const Tensor& g) {
+        return std::vector<Tensor>{repeatRows(g, m)};
+    });
+    return out;
+}
+
+Tensor repeatRows(const Tensor& v, int m) {
+    int p = static_cast<int>(v.size());
+    Tensor out({m, p}, v.requiresGrad());
+    auto O = out.accessor<2>();
+    const double* vd = v.getData().data();
+    for (int i = 0; i < m; ++i) std::copy(vd, vd + p, O.row(i));
+    if (const double* tv = tangent_of(v)) {
+        double* to = make_tangent(out);
+        for (int i = 0; i < m; ++i) std::copy(tv, tv + p, to + static_cast<size_t>(i) * p);
+    }
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_unary_backward(out, v, [out_weak, v, m, p]() mutable {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        if (!v.requiresGrad()) return;
+        auto& dv = v.getMutableGrad();
+        for (int i = 0; i < m; ++i)
+            for (int j = 0; j < p; ++j) dv[j] += out_impl->grad[static_cast<size_t>(i) * p + j];
+    });
+    attach_vjp(out, [](const Tensor&, const std::vector<Tensor>&, const Tensor& g) {
+        return std::vector<Tensor>{sumRows(g)};
+    });
+    return out;
+}
+
+std::vector<Tensor> linear_vjp(Activation act, const Tensor& out, const std::vector<Tensor>& in, const Tensor& g) {
+    Tensor dz = g;
+    if (act == Activation::ReLU) {
+        Tensor mask(out.shapeView());
+        const auto& y = out.getData();
+        auto& mk = mask.getMutableData();
+        for (size_t i = 0; i < y.size(); ++i) mk[i] = y[i] > 0.0 ? 1.0 : 0.0;
+        dz = g * mask;
+    } else if (act == Activation::Sigmoid) {
+        dz = g * (out - out * out);
+    } else if (act == Activation::Tanh) {
+        dz = g - g * out * out;
+    }
+    const Tensor& x = in[0];
+    const Tensor& W = in[1];
+    std::vector<Tensor> grads = {x.requiresGrad() ? ops::matmul(dz, ops::transpose(W)) : Tensor(),
+                                 W.requiresGrad() ? ops::matmul(ops::transpose(x), dz) : Tensor()};
+    if (in.size() > 2) {
+        const Tensor& b = in[2];
+        if (!b.requiresGrad()) grads.push_back(Tensor());
+        else if (b.rank() == 1) grads.push_back(sumRows(dz));
+        else grads.push_back(ops::matmul(Tensor::ones({1, x.shapeView()[0]}), dz));
+    }
+    return grads;
+}
+
+} // namespace
+
+Tensor linear(const Tensor& x, const Tensor& W, const Tensor& b, Activation act) {
+    profiler::OpScope prof("linear", {&x, &W, &b});
+    bool has_bias = !b.isEmpty();
+    if (isLowPrecision(x) || isLowPrecision(W) || (has_bias && isLowPrecision(b))) {
+        throw std::runtime_error("ops::linear requires float64 tensors; convert with to(DType::Float64) first");
+    }
+    const auto& sx = x.shapeView();
+    const auto& sw = W.shapeView();
+    if (sx.size() != 2 || sw.size() != 2) throw std::invalid_argument("ops::linear requires a 2D input and weight!");
+    if (sx[1] != sw[0]) throw std::invalid_argument("ops::linear dimension mismatch!");
+    int m = sx[0], n = sx[1], p = sw[1];
+    if (has_bias && (b.size() != p || b.rank() > 2 || (b.rank() == 2 && b.shapeView()[0] != 1))) {
+        throw std::invalid_argument("ops::linear bias must have shape [out] or [1, out]!");
+    }
+
+    bool req_grad = x.requiresGrad() || W.requiresGrad() || (has_bias && b.requiresGrad());
+    Tensor out({m, p}, req_grad);
+    const double* bias = has_bias ? b.getData().data() : nullptr;
+    double* dout = out.getMutableData().data();
+    dispatch(act, [&](auto a) { linearForward<decltype(a)::value>(x.getData().data(), W.getData().data(), bias, dout, m, n, p); });
+
+    // Tangent: act'(y) * (dx W + x dW + db).
+    const double* tx = tangent_of(x);
+    const double* tw = tangent_of(W);
+    const double* tb = has_bias ? tangent_of(b) : nullptr;
+    if (tx || tw || tb) {
+        double* to = make_tangent(out);
+        if (tx) accumulateProduct(tx, W.getData().data(), to, m, n, p);
+        if (tw) accumulateProduct(x.getData().data(), tw, to, m, n, p);
+        for (int i = 0; i < m; ++i) {
+            double* trow = to + static_cast<size_t>(i) * p;
+            const double* yrow = dout + static_cast<size_t>(i) * p;
+            if (tb) {
+                for (int j = 0; j < p; ++j) trow[j] += tb[j];
+            }
+            dispatch(act, [&](auto a) {
+                for (int j = 0; j < p; ++j) trow[j] = Act<decltype(a)::value>::backward(trow[j], yrow[j]);
+            });
+        }
+    }
+
+    if (!should_record(out)) return out;
+    auto& parents = out.getImpl()->parents;
+    parents.reserve(3);
+    parents.push_back(x);
+    parents.push_back(W);
+    if (has_bias) parents.push_back(b);
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_backward_fn(out, [out_weak, x, W, b, has_bias, act, m, n, p]() {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        dispatch(act, [&](auto a) {
+            linearBackward<decltype(a)::value>(*out_impl, x, W, has_bias ? &b : nullptr, m, n, p);
+        });
+    });
+    attach_vjp(out, [act](const Tensor& o, const std::vector<Tensor>& in, const Tensor& g) {
+        return linear_vjp(act, o, in, g);
+    });
+    return out;
+}
+
+} // namespace ops
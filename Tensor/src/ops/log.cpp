@@ -1,15 +1,27 @@
 #include "../../include/ops/log.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
 #include <cmath>
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> log_vjp(const Tensor&, const std::vector<Tensor>& in, const Tensor& g) {
+    return {g / in[0]};
+}
+
+} // namespace
+
 Tensor log(const Tensor& a) {
-    Tensor out(a.getShape(), a.requiresGrad());
+    profiler::OpScope prof("log", {&a});
+    Tensor out(a.shapeView(), a.requiresGrad());
     const auto& da = a.getData();
     auto& dout = out.getMutableData();
     for (size_t i = 0; i < da.size(); ++i) dout[i] = std::log(da[i]);
 
+    unary_tangent(out, a, [&](int i) { return 1.0 / da[i]; });
+    if (record_on_tape(out, autograd::TapeOp::Log, a)) return out;
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_unary_backward(out, a, [out_weak, a]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -20,6 +32,7 @@ Tensor log(const Tensor& a) {
             for (size_t i = 0; i < og.size(); ++i) ag[i] += og[i] / da[i];
         }
     });
+    attach_vjp(out, log_vjp);
     return out;
 }
 
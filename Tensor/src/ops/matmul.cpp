@@ -1,24 +1,136 @@
 #include "../../include/ops/matmul.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
+#include "../../include/ops/transpose.hpp"
+#include "../../include/utils/Reduce.hpp"
+#include <algorithm>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace ops {
 
+namespace {
+
+// O += A * B for row-major [m, n] x [n, p] buffers.
+void matmulAccumulate(const double* A, const double* B, double* O, int m, int n, int p) {
+    for (int i = 0; i < m; ++i) {
+        double* orow = O + static_cast<size_t>(i) * p;
+        for (int k = 0; k < n; ++k) {
+            double aik = A[static_cast<size_t>(i) * n + k];
+            const double* brow = B + static_cast<size_t>(k) * p;
+            for (int j = 0; j < p; ++j) orow[j] += aik * brow[j];
+        }
+    }
+}
+
+// [m, n] x [n, p] on 16-bit storage. B is widened to float once, each row of A
+// is widened as it is used, and out rows accumulate in float before rounding.
+Tensor matmulLowPrecision(const Tensor& a, const Tensor& b, int m, int n, int p) {
+    if (a.dtype() != b.dtype()) {
+        throw std::invalid_argument(std::string("dtype mismatch in ops::matmul (") + dtypeName(a.dtype()) + " vs " +
+                                    dtypeName(b.dtype()) + "); use to() first");
+    }
+    DType d = a.dtype();
+    bool req_grad = a.requiresGrad() || b.requiresGrad();
+    Tensor out({m, p}, d, req_grad);
+
+    std::vector<float> B = widen(b);
+    std::vector<float> arow(n), acc(p);
+    const uint16_t* A = a.getHalfData().data();
+    uint16_t* O = out.getMutableHalfData().data();
+    for (int i = 0; i < m; ++i) {
+        half::decodeRow(d, A + static_cast<size_t>(i) * n, arow.data(), n);
+        std::fill(acc.begin(), acc.end(), 0.0f);
+        for (int k = 0; k < n; ++k) {
+            float aik = arow[k];
+            const float* brow = B.data() + static_cast<size_t>(k) * p;
+            for (int j = 0; j < p; ++j) acc[j] += aik * brow[j];
+        }
+        half::encodeRow(d, acc.data(), O + static_cast<size_t>(i) * p, p);
+    }
+
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_binary_backward(out, a, b, [out_weak, a, b, m, n, p, d]() mutable {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        auto G = out_impl->gradAccessor<2>();
+        if (a.requiresGrad()) {
+            // dA = G * B^T, as row axpys over a float copy of B^T so the inner loop vectorizes
+            std::vector<float> B = widen(b);
+            std::vector<float> Bt(B.size()), acc(n);
+            for (int k = 0; k < n; ++k) {
+                for (int j = 0; j < p; ++j) Bt[static_cast<size_t>(j) * n + k] = B[static_cast<size_t>(k) * p + j];
+            }
+            auto dA = a.gradAccessor<2>();
+            for (int i = 0; i < m; ++i) {
+                std::fill(acc.begin(), acc.end(), 0.0f);
+                for (int j = 0; j < p; ++j) {
+                    float g = static_cast<float>(G(i, j));
+                    const float* btrow = Bt.data() + static_cast<size_t>(j) * n;
+                    for (int k = 0; k < n; ++k) acc[k] += g * btrow[k];
+                }
+                double* darow = dA.row(i);
+                for (int k = 0; k < n; ++k) darow[k] += roundTo(d, acc[k]);
+            }
+        }
+        if (b.requiresGrad()) {
+            // dB = A^T * G, accumulated in a float buffer and rounded once
+            std::vector<float> A = widen(a);
+            std::vector<float> dB(static_cast<size_t>(n) * p, 0.0f), grow(p);
+            for (int i = 0; i < m; ++i) {
+                for (int j = 0; j < p; ++j) grow[j] = static_cast<float>(G(i, j));
+                for (int k = 0; k < n; ++k) {
+                    float aik = A[static_cast<size_t>(i) * n + k];
+                    float* dbrow = dB.data() + static_cast<size_t>(k) * p;
+                    for (int j = 0; j < p; ++j) dbrow[j] += aik * grow[j];
+                }
+            }
+            auto& bg = b.getMutableGrad();
+            for (size_t q = 0; q < dB.size(); ++q) bg[q] += roundTo(d, dB[q]);
+        }
+    });
+    return out;
+}
+
+// Vector dot: g is [1] and broadcasts over the other operand.
+std::vector<Tensor> matmul_vjp(const Tensor&, const std::vector<Tensor>& in, const Tensor& g) {
+    const Tensor& a = in[0];
+    const Tensor& b = in[1];
+    if (a.rank() == 1) return {a.requiresGrad() ? g * b : Tensor(), b.requiresGrad() ? g * a : Tensor()};
+    return {a.requiresGrad() ? ops::matmul(g, ops::transpose(b)) : Tensor(),
+            b.requiresGrad() ? ops::matmul(ops::transpose(a), g) : Tensor()};
+}
+
+} // namespace
+
 Tensor dot(const Tensor& a, const Tensor& b) {
+    profiler::OpScope prof("dot", {&a, &b});
     return ops::matmul(a, b);
 }
 
 Tensor matmul(const Tensor& a, const Tensor& b) {
-    auto shapeA = a.getShape();
-    auto shapeB = b.getShape();
+    profiler::OpScope prof("matmul", {&a, &b});
+    const auto& shapeA = a.shapeView();
+    const auto& shapeB = b.shapeView();
 
     if (shapeA.size() == 1 && shapeB.size() == 1) {
         if (a.size() != b.size()) throw std::invalid_argument("Vector dot mismatch!");
         bool req_grad = a.requiresGrad() || b.requiresGrad();
-        double sum = 0.0;
-        for (int i = 0; i < a.size(); ++i) sum += a.at({i}) * b.at({i});
+        auto A = a.accessor<1>();
+        auto B = b.accessor<1>();
+        double sum = reduce::dot(A.data(), B.data(), a.size());
         Tensor out({1}, {sum}, req_grad);
 
+        if (has_tangent(a) || has_tangent(b)) {
+            const double* ta = tangent_of(a);
+            const double* tb = tangent_of(b);
+            double t = 0.0;
+            if (ta) t += reduce::dot(ta, B.data(), a.size());
+            if (tb) t += reduce::dot(A.data(), tb, a.size());
+            make_tangent(out)[0] = t;
+        }
+        if (record_on_tape(out, autograd::TapeOp::Dot, a, &b)) return out;
         auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
         attach_binary_backward(out, a, b, [out_weak, a, b]() mutable {
             auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -34,51 +146,72 @@ Tensor matmul(const Tensor& a, const Tensor& b) {
                 for (size_t i = 0; i < bg.size(); ++i) bg[i] += og * da[i];
             }
         });
+        attach_vjp(out, matmul_vjp);
         return out;
     }
 
     if (shapeA.size() == 2 && shapeB.size() == 2) {
         if (shapeA[1] != shapeB[0]) throw std::invalid_argument("2D Matmul dimension mismatch!");
         int m = shapeA[0], n = shapeA[1], p = shapeB[1];
+        if (isLowPrecision(a) || isLowPrecision(b)) return matmulLowPrecision(a, b, m, n, p);
         bool req_grad = a.requiresGrad() || b.requiresGrad();
         Tensor out({m, p}, req_grad);
 
+        // i-k-j order keeps the inner loop on contiguous rows of B and out;
+        // each out(i, j) still accumulates over k in ascending order.
+        auto A = a.accessor<2>();
+        auto B = b.accessor<2>();
+        auto O = out.accessor<2>();
         for (int i = 0; i < m; ++i) {
-            for (int j = 0; j < p; ++j) {
-                double sum = 0.0;
-                for (int k = 0; k < n; ++k) {
-                    sum += a.at({i, k}) * b.at({k, j});
-                }
-                out.set({i, j}, sum);
+            double* orow = O.row(i);
+            for (int k = 0; k < n; ++k) {
+                double aik = A(i, k);
+                const double* brow = B.row(k);
+                for (int j = 0; j < p; ++j) orow[j] += aik * brow[j];
             }
         }
 
+        // Tangent: dO = dA * B + A * dB.
+        if (has_tangent(a) || has_tangent(b)) {
+            double* to = make_tangent(out);
+            if (const double* ta = tangent_of(a)) matmulAccumulate(ta, B.data(), to, m, n, p);
+            if (const double* tb = tangent_of(b)) matmulAccumulate(A.data(), tb, to, m, n, p);
+        }
+        if (record_on_tape(out, autograd::TapeOp::Matmul, a, &b)) return out;
         auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
         attach_binary_backward(out, a, b, [out_weak, a, b, m, n, p]() mutable {
             auto out_impl = out_weak.lock(); if (!out_impl) return;
+            auto G = out_impl->gradAccessor<2>();
+            auto A = a.accessor<2>();
+            auto B = b.accessor<2>();
             if (a.requiresGrad()) {
+                // dA = G * B^T: row i of G dotted with row k of B
+                auto dA = a.gradAccessor<2>();
                 for (int i = 0; i < m; ++i) {
+                    const double* grow = G.row(i);
+                    double* darow = dA.row(i);
                     for (int k = 0; k < n; ++k) {
+                        const double* brow = B.row(k);
                         double sum = 0.0;
-                        for (int j = 0; j < p; ++j) {
-                            sum += out_impl->grad[i * p + j] * b.at({k, j});
-                        }
-                        a.gradAt({i, k}) += sum;
+                        for (int j = 0; j < p; ++j) sum += grow[j] * brow[j];
+                        darow[k] += sum;
                     }
                 }
             }
             if (b.requiresGrad()) {
-                for (int k = 0; k < n; ++k) {
-                    for (int j = 0; j < p; ++j) {
-                        double sum = 0.0;
-                        for (int i = 0; i < m; ++i) {
-                            sum += a.at({i, k}) * out_impl->grad[i * p + j];
-                        }
-                        b.gradAt({k, j}) += sum;
+                // dB = A^T * G, accumulated row-wise into dB
+                auto dB = b.gradAccessor<2>();
+                for (int i = 0; i < m; ++i) {
+                    const double* grow = G.row(i);
+                    for (int k = 0; k < n; ++k) {
+                        double aik = A(i, k);
+                        double* dbrow = dB.row(k);
+                        for (int j = 0; j < p; ++j) dbrow[j] += aik * grow[j];
                     }
                 }
             }
         });
+        attach_vjp(out, matmul_vjp);
         return out;
     }
 
@@ -1,24 +1,47 @@
 #include "../../include/ops/mean.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
+#include "../../include/ops/mul.hpp"
+#include "../../include/utils/Reduce.hpp"
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> mean_vjp(const Tensor&, const std::vector<Tensor>& in, const Tensor& g) {
+    int n = in[0].size();
+    return {ops::mul(g, Tensor(in[0].shapeView(), std::vector<double>(n, 1.0 / (n > 0 ? n : 1))))};
+}
+
+} // namespace
+
 Tensor mean(const Tensor& t) {
+    profiler::OpScope prof("mean", {&t});
     bool req_grad = t.requiresGrad();
-    double s = 0.0;
-    const auto& dt = t.getData();
-    for (double val : dt) s += val;
-    double N = static_cast<double>(dt.size());
+    double s = isLowPrecision(t) ? reduce::sum(t.dtype(), t.getHalfData().data(), t.size())
+                                 : reduce::sum(t.getData().data(), t.size());
+    double N = static_cast<double>(t.size());
     Tensor out({1}, {s / (N > 0 ? N : 1.0)}, req_grad);
 
+    if (const double* tt = tangent_of(t)) {
+        double ts = reduce::sum(tt, t.size());
+        make_tangent(out)[0] = ts / (N > 0 ? N : 1.0);
+    }
+    if (!isLowPrecision(t) && record_on_tape(out, autograd::TapeOp::Mean, t)) return out;
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_unary_backward(out, t, [out_weak, t, N]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
         if (!t.requiresGrad()) return;
         double og = out_impl->grad[0] / (N > 0 ? N : 1.0);
+        if (isLowPrecision(t)) {
+            accumulateLowPrecisionGrad(t, std::vector<double>(t.size(), og), 1.0);
+            return;
+        }
         auto& tg = t.getMutableGrad();
         for (size_t i = 0; i < tg.size(); ++i) tg[i] += og;
     });
+    if (!isLowPrecision(t)) attach_vjp(out, mean_vjp);
     return out;
 }
 
@@ -1,27 +1,53 @@
 #include "../../include/ops/mul.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
+#include "../../include/utils/Reduce.hpp"
 #include <stdexcept>
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> mul_vjp(const Tensor&, const std::vector<Tensor>& in, const Tensor& g) {
+    return {in[0].requiresGrad() ? unbroadcast(in[0], g * in[1]) : Tensor(),
+            in[1].requiresGrad() ? unbroadcast(in[1], g * in[0]) : Tensor()};
+}
+
+} // namespace
+
 Tensor mul(const Tensor& a, const Tensor& b) {
+    profiler::OpScope prof("mul", {&a, &b});
     bool req_grad = a.requiresGrad() || b.requiresGrad();
+
+    if (isLowPrecision(a) || isLowPrecision(b)) {
+        Tensor out = zipLowPrecision("mul", a, b, req_grad, [](float x, float y) { return x * y; });
+        auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+        attach_binary_backward(out, a, b, [out_weak, a, b]() mutable {
+            auto out_impl = out_weak.lock(); if (!out_impl) return;
+            std::vector<float> wa = widen(a), wb = widen(b);
+            if (a.requiresGrad()) accumulateLowPrecisionGrad(a, out_impl->grad, 1.0, &wb);
+            if (b.requiresGrad()) accumulateLowPrecisionGrad(b, out_impl->grad, 1.0, &wa);
+        });
+        return out;
+    }
     
     if (a.isScalar() && !b.isScalar()) {
-        Tensor out(b.getShape(), req_grad);
+        Tensor out(b.shapeView(), req_grad);
         double val_a = a.at({0});
         const auto& db = b.getData();
         auto& dout = out.getMutableData();
         for (size_t i = 0; i < db.size(); ++i) dout[i] = val_a * db[i];
         
+        binary_tangent(out, a, b, [&](int i) { return db[i]; }, [&](int) { return val_a; });
+        if (record_on_tape(out, autograd::TapeOp::Mul, a, &b)) return out;
         auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
         attach_binary_backward(out, a, b, [out_weak, a, b]() mutable {
             auto out_impl = out_weak.lock(); if (!out_impl) return;
             const auto& og = out_impl->grad;
             const auto& db = b.getData();
             if (a.requiresGrad()) {
-                double sum_g = 0.0;
-                for (size_t i = 0; i < og.size(); ++i) sum_g += og[i] * db[i];
+                double sum_g = reduce::dot(og.data(), db.data(), og.size());
                 a.getMutableGrad()[0] += sum_g;
             }
             if (b.requiresGrad()) {
@@ -30,6 +56,7 @@ Tensor mul(const Tensor& a, const Tensor& b) {
                 for (size_t i = 0; i < og.size(); ++i) bg[i] += og[i] * val_a;
             }
         });
+        attach_vjp(out, mul_vjp);
         return out;
     }
     
@@ -37,16 +64,18 @@ Tensor mul(const Tensor& a, const Tensor& b) {
         return ops::mul(b, a);
     }
 
-    if (a.getShape() != b.getShape()) {
+    if (a.shapeView() != b.shapeView()) {
         throw std::invalid_argument("Shape mismatch in ops::mul!");
     }
 
-    Tensor out(a.getShape(), req_grad);
+    Tensor out(a.shapeView(), req_grad);
     const auto& da = a.getData();
     const auto& db = b.getData();
     auto& dout = out.getMutableData();
     for (size_t i = 0; i < da.size(); ++i) dout[i] = da[i] * db[i];
 
+    binary_tangent(out, a, b, [&](int i) { return db[i]; }, [&](int i) { return da[i]; });
+    if (record_on_tape(out, autograd::TapeOp::Mul, a, &b)) return out;
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_binary_backward(out, a, b, [out_weak, a, b]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -62,7 +91,44 @@ Tensor mul(const Tensor& a, const Tensor& b) {
             for (size_t i = 0; i < og.size(); ++i) bg[i] += og[i] * da[i];
         }
     });
+    attach_vjp(out, mul_vjp);
+
+    return out;
+}
+
+Tensor mul(const Tensor& a, double b) {
+    profiler::OpScope prof("mul", {&a});
+
+    if (isLowPrecision(a)) {
+        float bf = static_cast<float>(b);
+        Tensor out = mapLowPrecision(a, a.requiresGrad(), [bf](float x) { return x * bf; });
+        auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+        attach_unary_backward(out, a, [out_weak, a, b]() mutable {
+            auto out_impl = out_weak.lock(); if (!out_impl) return;
+            if (a.requiresGrad()) accumulateLowPrecisionGrad(a, out_impl->grad, b);
+        });
+        return out;
+    }
+
+    Tensor out(a.shapeView(), a.requiresGrad());
+    const auto& da = a.getData();
+    auto& dout = out.getMutableData();
+    for (size_t i = 0; i < da.size(); ++i) dout[i] = da[i] * b;
 
+    unary_tangent(out, a, [b](int) { return b; });
+    if (record_on_tape(out, autograd::TapeOp::MulScalar, a, nullptr, b)) return out;
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_unary_backward(out, a, [out_weak, a, b]() mutable {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        const auto& og = out_impl->grad;
+        if (a.requiresGrad()) {
+            auto& ag = a.getMutableGrad();
+            for (size_t i = 0; i < og.size(); ++i) ag[i] += og[i] * b;
+        }
+    });
+    attach_vjp(out, [b](const Tensor&, const std::vector<Tensor>&, const Tensor& g) {
+        return std::vector<Tensor>{g * b};
+    });
     return out;
 }
 
@@ -1,14 +1,26 @@
 #include "../../include/ops/neg.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> neg_vjp(const Tensor&, const std::vector<Tensor>&, const Tensor& g) {
+    return {-g};
+}
+
+} // namespace
+
 Tensor neg(const Tensor& a) {
-    Tensor out(a.getShape(), a.requiresGrad());
+    profiler::OpScope prof("neg", {&a});
+    Tensor out(a.shapeView(), a.requiresGrad());
     const auto& da = a.getData();
     auto& dout = out.getMutableData();
     for (size_t i = 0; i < da.size(); ++i) dout[i] = -da[i];
 
+    unary_tangent(out, a, [](int) { return -1.0; });
+    if (record_on_tape(out, autograd::TapeOp::Neg, a)) return out;
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_unary_backward(out, a, [out_weak, a]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -18,6 +30,7 @@ Tensor neg(const Tensor& a) {
             for (size_t i = 0; i < og.size(); ++i) ag[i] -= og[i];
         }
     });
+    attach_vjp(out, neg_vjp);
     return out;
 }
 
@@ -0,0 +1,290 @@
+#include "../../include/ops/norm.hpp"
+#include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
+#include "../../include/utils/Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ops {
+
+namespace {
+
+struct Welford {
+    double mean = 0.0;
+    double m2 = 0.0;
+    long long count = 0;
+
+    void add(double v) {
+        ++count;
+        double delta = v - mean;
+        mean += delta / static_cast<double>(count);
+        m2 += delta * (v - mean);
+    }
+    double variance() const { return count ? m2 / static_cast<double>(count) : 0.0; }   // biased
+};
+
+void checkOperands(const char* op, std::initializer_list<const Tensor*> ts) {
+    for (const Tensor* t : ts) {
+        if (t->isEmpty()) continue;
+        if (isLowPrecision(*t)) {
+            throw std::runtime_error(std::string(op) + " requires float64 tensors; convert with to(DType::Float64) first");
+        }
+        if (has_tangent(*t)) throw std::runtime_error(std::string(op) + " does not propagate forward-mode tangents");
+    }
+}
+
+void checkVector(const char* op, const Tensor& t, int n, const char* name) {
+    if (t.isEmpty()) return;
+    if (t.rank() != 1 || t.size() != n) {
+        throw std::invalid_argument(std::string(op) + ": " + name + " must be [" + std::to_string(n) + "]!");
+    }
+}
+
+const double* dataOrNull(const Tensor& t) { return t.isEmpty() ? nullptr : t.getData().data(); }
+
+double* gradOrNull(const Tensor& t) {
+    return !t.isEmpty() && t.requiresGrad() ? t.getMutableGrad().data() : nullptr;
+}
+
+bool anyRequiresGrad(std::initializer_list<const Tensor*> ts) {
+    for (const Tensor* t : ts) {
+        if (!t->isEmpty() && t->requiresGrad()) return true;
+    }
+    return false;
+}
+
+// Roughly 16K elements of work per chunk.
+int64_t grainFor(int64_t width) { return std::max<int64_t>(1, 16384 / std::max<int64_t>(1, width)); }
+
+} // namespace
+
+Tensor layer_norm(const Tensor& x, const Tensor& gamma, const Tensor& beta, double eps) {
+    profiler::OpScope prof("layer_norm", {&x, &gamma, &beta});
+    checkOperands("ops::layer_norm", {&x, &gamma, &beta});
+    const auto& shape = x.shapeView();
+    if (shape.empty() || x.size() == 0) throw std::invalid_argument("ops::layer_norm cannot apply to empty Tensor");
+    int N = shape.back();
+    int R = x.size() / N;
+    checkVector("ops::layer_norm", gamma, N, "gamma");
+    checkVector("ops::layer_norm", beta, N, "beta");
+
+    Tensor out(shape, anyRequiresGrad({&x, &gamma, &beta}));
+    // Per row: mean, 1 / sqrt(var + eps)
+    auto stats = std::make_shared<std::vector<double>>(static_cast<size_t>(R) * 2);
+    const double* X = x.getData().data();
+    const double* G = dataOrNull(gamma);
+    const double* B = dataOrNull(beta);
+    double* Y = out.getMutableData().data();
+    double* S = stats->data();
+    parallel::parallel_for(0, R, grainFor(N), [&](int64_t lo, int64_t hi) {
+        for (int64_t r = lo; r < hi; ++r) {
+            const double* xrow = X + r * N;
+            double* yrow = Y + r * N;
+            Welford w;
+            for (int j = 0; j < N; ++j) w.add(xrow[j]);
+            double mean = w.mean, rstd = 1.0 / std::sqrt(w.variance() + eps);
+            S[2 * r] = mean;
+            S[2 * r + 1] = rstd;
+            for (int j = 0; j < N; ++j) {
+                double v = (xrow[j] - mean) * rstd;
+                if (G) v *= G[j];
+                if (B) v += B[j];
+                yrow[j] = v;
+            }
+        }
+    });
+
+    if (!should_record(out)) return out;
+    auto& parents = out.getImpl()->parents;
+    parents.reserve(3);
+    for (const Tensor* t : {&x, &gamma, &beta}) {
+        if (!t->isEmpty()) parents.push_back(*t);
+    }
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_backward_fn(out, [out_weak, x, gamma, beta, stats, R, N]() {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        const double* X = x.getData().data();
+        const double* G = dataOrNull(gamma);
+        const double* dY = out_impl->grad.data();
+        const double* S = stats->data();
+        // dx = rstd * (g - mean(g) - xhat * mean(g * xhat)) with g = dy * gamma, per row
+        if (double* dX = gradOrNull(x)) {
+            parallel::parallel_for(0, R, grainFor(N), [&](int64_t lo, int64_t hi) {
+                for (int64_t r = lo; r < hi; ++r) {
+                    const double* xrow = X + r * N;
+                    const double* grow = dY + r * N;
+                    double mean = S[2 * r], rstd = S[2 * r + 1];
+                    double sum_g = 0.0, sum_gx = 0.0;
+                    for (int j = 0; j < N; ++j) {
+                        double g = G ? grow[j] * G[j] : grow[j];
+                        sum_g += g;
+                        sum_gx += g * (xrow[j] - mean) * rstd;
+                    }
+                    double mg = sum_g / N, mgx = sum_gx / N;
+                    double* dxrow = dX + r * N;
+                    for (int j = 0; j < N; ++j) {
+                        double g = G ? grow[j] * G[j] : grow[j];
+                        dxrow[j] += rstd * (g - mg - (xrow[j] - mean) * rstd * mgx);
+                    }
+                }
+            });
+        }
+        // dgamma = sum over rows of dy * xhat, dbeta = sum of dy; split by columns
+        double* dG = gradOrNull(gamma);
+        double* dB = gradOrNull(beta);
+        if (dG || dB) {
+            parallel::parallel_for(0, N, 64, [&](int64_t lo, int64_t hi) {
+                for (int r = 0; r < R; ++r) {
+                    const double* xrow = X + static_cast<size_t>(r) * N;
+                    const double* grow = dY + static_cast<size_t>(r) * N;
+                    double mean = S[2 * r], rstd = S[2 * r + 1];
+                    for (int64_t j = lo; j < hi; ++j) {
+                        if (dG) dG[j] += grow[j] * (xrow[j] - mean) * rstd;
+                        if (dB) dB[j] += grow[j];
+                    }
+                }
+            });
+        }
+    });
+    memory::onGraphAttach(*out.getImpl(), stats->size() * sizeof(double));
+    return out;
+}
+
+Tensor batch_norm(const Tensor& x, const Tensor& running_mean, const Tensor& running_var, const Tensor& gamma,
+                  const Tensor& beta, bool training, double momentum, double eps) {
+    profiler::OpScope prof("batch_norm", {&x, &gamma, &beta});
+    const char* op = "ops::batch_norm";
+    checkOperands(op, {&x, &running_mean, &running_var, &gamma, &beta});
+    const auto& shape = x.shapeView();
+    if (shape.size() < 2) throw std::invalid_argument("ops::batch_norm expects x as [batch, C, ...]!");
+    int C = shape[1];
+    int spatial = 1;
+    for (size_t i = 2; i < shape.size(); ++i) spatial *= shape[i];
+    int batch = shape[0];
+    long long count = static_cast<long long>(batch) * spatial;
+    for (const auto& [t, name] : {std::pair<const Tensor*, const char*>{&running_mean, "running_mean"},
+                                  {&running_var, "running_var"}, {&gamma, "gamma"}, {&beta, "beta"}}) {
+        checkVector(op, *t, C, name);
+    }
+    if (running_mean.isEmpty() != running_var.isEmpty()) {
+        throw std::invalid_argument("ops::batch_norm: pass both running_mean and running_var, or neither!");
+    }
+    if (!training && running_mean.isEmpty()) {
+        throw std::invalid_argument("ops::batch_norm: inference mode needs running_mean and running_var!");
+    }
+    if (training && count < 2) throw std::invalid_argument("ops::batch_norm: training needs more than one value per channel!");
+
+    Tensor out(shape, anyRequiresGrad({&x, &gamma, &beta}));
+    // Per channel: mean, 1 / sqrt(var + eps) as used for this call
+    auto stats = std::make_shared<std::vector<double>>(static_cast<size_t>(C) * 2);
+    const double* X = x.getData().data();
+    const double* G = dataOrNull(gamma);
+    const double* B = dataOrNull(beta);
+    double* RM = running_mean.isEmpty() ? nullptr : running_mean.getMutableData().data();
+    double* RV = running_var.isEmpty() ? nullptr : running_var.getMutableData().data();
+    double* Y = out.getMutableData().data();
+    double* S = stats->data();
+    size_t plane = static_cast<size_t>(C) * spatial;
+    // Each chunk owns a channel range and walks the batch in memory order, so rows of a
+    // [batch, C] input are read contiguously rather than down columns.
+    int64_t grain = std::max<int64_t>(8, grainFor(count));
+    parallel::parallel_for(0, C, grain, [&](int64_t lo, int64_t hi) {
+        if (training) {
+            std::vector<Welford> w(hi - lo);
+            for (int n = 0; n < batch; ++n) {
+                for (int64_t c = lo; c < hi; ++c) {
+                    const double* xs = X + n * plane + c * spatial;
+                    for (int s = 0; s < spatial; ++s) w[c - lo].add(xs[s]);
+                }
+            }
+            for (int64_t c = lo; c < hi; ++c) {
+                double mean = w[c - lo].mean, var = w[c - lo].variance();
+                if (RM) {
+                    RM[c] = (1.0 - momentum) * RM[c] + momentum * mean;
+                    RV[c] = (1.0 - momentum) * RV[c] + momentum * var * count / (count - 1);
+                }
+                S[2 * c] = mean;
+                S[2 * c + 1] = 1.0 / std::sqrt(var + eps);
+            }
+        } else {
+            for (int64_t c = lo; c < hi; ++c) {
+                S[2 * c] = RM[c];
+                S[2 * c + 1] = 1.0 / std::sqrt(RV[c] + eps);
+            }
+        }
+        for (int n = 0; n < batch; ++n) {
+            for (int64_t c = lo; c < hi; ++c) {
+                double mean = S[2 * c];
+                double scale = G ? G[c] * S[2 * c + 1] : S[2 * c + 1];
+                double shift = B ? B[c] : 0.0;
+                const double* xs = X + n * plane + c * spatial;
+                double* ys = Y + n * plane + c * spatial;
+                for (int s = 0; s < spatial; ++s) ys[s] = (xs[s] - mean) * scale + shift;
+            }
+        }
+    });
+
+    if (!should_record(out)) return out;
+    auto& parents = out.getImpl()->parents;
+    parents.reserve(3);
+    for (const Tensor* t : {&x, &gamma, &beta}) {
+        if (!t->isEmpty()) parents.push_back(*t);
+    }
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_backward_fn(out, [out_weak, x, gamma, beta, stats, training, batch, C, spatial, count]() {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        const double* X = x.getData().data();
+        const double* G = dataOrNull(gamma);
+        const double* dY = out_impl->grad.data();
+        const double* S = stats->data();
+        double* dX = gradOrNull(x);
+        double* dG = gradOrNull(gamma);
+        double* dB = gradOrNull(beta);
+        size_t plane = static_cast<size_t>(C) * spatial;
+        int64_t grain = std::max<int64_t>(8, grainFor(count));
+        parallel::parallel_for(0, C, grain, [&](int64_t lo, int64_t hi) {
+            std::vector<double> sum_dy(hi - lo, 0.0), sum_dyx(hi - lo, 0.0);
+            for (int n = 0; n < batch; ++n) {
+                for (int64_t c = lo; c < hi; ++c) {
+                    double mean = S[2 * c], rstd = S[2 * c + 1];
+                    const double* xs = X + n * plane + c * spatial;
+                    const double* gs = dY + n * plane + c * spatial;
+                    double a = 0.0, b = 0.0;
+                    for (int s = 0; s < spatial; ++s) {
+                        a += gs[s];
+                        b += gs[s] * (xs[s] - mean) * rstd;
+                    }
+                    sum_dy[c - lo] += a;
+                    sum_dyx[c - lo] += b;
+                }
+            }
+            for (int64_t c = lo; c < hi; ++c) {
+                if (dG) dG[c] += sum_dyx[c - lo];
+                if (dB) dB[c] += sum_dy[c - lo];
+            }
+            if (!dX) return;
+            // Training: the batch statistics depend on x too. Inference: they are constants.
+            for (int n = 0; n < batch; ++n) {
+                for (int64_t c = lo; c < hi; ++c) {
+                    double mean = S[2 * c], rstd = S[2 * c + 1];
+                    double k = G ? G[c] * rstd : rstd;
+                    double mdy = training ? sum_dy[c - lo] / count : 0.0;
+                    double mdyx = training ? sum_dyx[c - lo] / count : 0.0;
+                    const double* xs = X + n * plane + c * spatial;
+                    const double* gs = dY + n * plane + c * spatial;
+                    double* dxs = dX + n * plane + c * spatial;
+                    for (int s = 0; s < spatial; ++s) dxs[s] += k * (gs[s] - mdy - (xs[s] - mean) * rstd * mdyx);
+                }
+            }
+        });
+    });
+    memory::onGraphAttach(*out.getImpl(), stats->size() * sizeof(double));
+    return out;
+}
+
+} // namespace ops
@@ -1,15 +1,18 @@
 #include "../../include/ops/pow.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
 #include <cmath>
 
 namespace ops {
 
 Tensor pow(const Tensor& a, double exponent) {
-    Tensor out(a.getShape(), a.requiresGrad());
+    profiler::OpScope prof("pow", {&a});
+    Tensor out(a.shapeView(), a.requiresGrad());
     const auto& da = a.getData();
     auto& dout = out.getMutableData();
     for (size_t i = 0; i < da.size(); ++i) dout[i] = std::pow(da[i], exponent);
 
+    unary_tangent(out, a, [&](int i) { return exponent * std::pow(da[i], exponent - 1.0); });
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_unary_backward(out, a, [out_weak, a, exponent]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -22,6 +25,9 @@ Tensor pow(const Tensor& a, double exponent) {
             }
         }
     });
+    attach_vjp(out, [exponent](const Tensor&, const std::vector<Tensor>& in, const Tensor& g) -> std::vector<Tensor> {
+        return {g * ops::pow(in[0], exponent - 1.0) * exponent};
+    });
     return out;
 }
 
@@ -1,15 +1,46 @@
 #include "../../include/ops/relu.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
 #include <algorithm>
 
 namespace ops {
 
+namespace {
+
+// The mask is a constant: relu has zero second derivative almost everywhere.
+std::vector<Tensor> relu_vjp(const Tensor&, const std::vector<Tensor>& in, const Tensor& g) {
+    Tensor mask(in[0].shapeView());
+    const auto& dt = in[0].getData();
+    auto& m = mask.getMutableData();
+    for (size_t i = 0; i < dt.size(); ++i) m[i] = dt[i] > 0.0 ? 1.0 : 0.0;
+    return {g * mask};
+}
+
+} // namespace
+
 Tensor relu(const Tensor& t) {
-    Tensor out(t.getShape(), t.requiresGrad());
+    profiler::OpScope prof("relu", {&t});
+    if (isLowPrecision(t)) {
+        Tensor out = mapLowPrecision(t, t.requiresGrad(), [](float x) { return x > 0.0f ? x : 0.0f; });
+        auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+        attach_unary_backward(out, t, [out_weak, t]() mutable {
+            auto out_impl = out_weak.lock(); if (!out_impl) return;
+            if (!t.requiresGrad()) return;
+            std::vector<float> mask = widen(t);
+            for (float& m : mask) m = m > 0.0f ? 1.0f : 0.0f;
+            accumulateLowPrecisionGrad(t, out_impl->grad, 1.0, &mask);
+        });
+        return out;
+    }
+
+    Tensor out(t.shapeView(), t.requiresGrad());
     const auto& dt = t.getData();
     auto& dout = out.getMutableData();
     for (size_t i = 0; i < dt.size(); ++i) dout[i] = std::max(0.0, dt[i]);
 
+    unary_tangent(out, t, [&](int i) { return dt[i] > 0.0 ? 1.0 : 0.0; });
+    if (record_on_tape(out, autograd::TapeOp::Relu, t)) return out;
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_unary_backward(out, t, [out_weak, t]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -22,6 +53,7 @@ Tensor relu(const Tensor& t) {
             }
         }
     });
+    attach_vjp(out, relu_vjp);
     return out;
 }
 
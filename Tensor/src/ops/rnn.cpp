@@ -0,0 +1,413 @@
+#include "../../include/ops/rnn.hpp"
+#include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ops {
+
+namespace {
+
+double sigmoid(double z) { return 1.0 / (1.0 + std::exp(-z)); }
+
+// O += A * B for A [m, n], B [n, p].
+void gemmAccumulate(const double* A, const double* B, double* O, int m, int n, int p) {
+    for (int i = 0; i < m; ++i) {
+        double* orow = O + static_cast<size_t>(i) * p;
+        for (int k = 0; k < n; ++k) {
+            double aik = A[static_cast<size_t>(i) * n + k];
+            const double* brow = B + static_cast<size_t>(k) * p;
+            for (int j = 0; j < p; ++j) orow[j] += aik * brow[j];
+        }
+    }
+}
+
+// O += A * B^T for A [m, p], B [n, p].
+void gemmAccumulateBT(const double* A, const double* B, double* O, int m, int n, int p) {
+    for (int i = 0; i < m; ++i) {
+        const double* arow = A + static_cast<size_t>(i) * p;
+        double* orow = O + static_cast<size_t>(i) * n;
+        for (int k = 0; k < n; ++k) {
+            const double* brow = B + static_cast<size_t>(k) * p;
+            double sum = 0.0;
+            for (int j = 0; j < p; ++j) sum += arow[j] * brow[j];
+            orow[k] += sum;
+        }
+    }
+}
+
+// O += A^T * B for A [m, n], B [m, p].
+void gemmAccumulateAT(const double* A, const double* B, double* O, int m, int n, int p) {
+    for (int i = 0; i < m; ++i) {
+        const double* brow = B + static_cast<size_t>(i) * p;
+        for (int k = 0; k < n; ++k) {
+            double aik = A[static_cast<size_t>(i) * n + k];
+            double* orow = O + static_cast<size_t>(k) * p;
+            for (int j = 0; j < p; ++j) orow[j] += aik * brow[j];
+        }
+    }
+}
+
+void addColumnSums(const double* A, double* O, int m, int p) {
+    for (int i = 0; i < m; ++i) {
+        const double* arow = A + static_cast<size_t>(i) * p;
+        for (int j = 0; j < p; ++j) O[j] += arow[j];
+    }
+}
+
+const double* dataOrNull(const Tensor& t) { return t.isEmpty() ? nullptr : t.getData().data(); }
+
+double* gradOrNull(const Tensor& t) {
+    return !t.isEmpty() && t.requiresGrad() ? t.getMutableGrad().data() : nullptr;
+}
+
+bool anyRequiresGrad(std::initializer_list<const Tensor*> ts) {
+    for (const Tensor* t : ts) {
+        if (!t->isEmpty() && t->requiresGrad()) return true;
+    }
+    return false;
+}
+
+void checkOperands(const char* op, std::initializer_list<const Tensor*> ts) {
+    for (const Tensor* t : ts) {
+        if (t->isEmpty()) continue;
+        if (isLowPrecision(*t)) {
+            throw std::runtime_error(std::string(op) + " requires float64 tensors; convert with to(DType::Float64) first");
+        }
+        if (has_tangent(*t)) throw std::runtime_error(std::string(op) + " does not propagate forward-mode tangents");
+    }
+}
+
+void checkMatrix(const char* op, const Tensor& t, int rows, int cols, const char* name) {
+    const auto& s = t.shapeView();
+    if (s.size() != 2 || s[0] != rows || s[1] != cols) {
+        throw std::invalid_argument(std::string(op) + ": " + name + " must be [" + std::to_string(rows) + ", " +
+                                    std::to_string(cols) + "]!");
+    }
+}
+
+void checkBias(const char* op, const Tensor& b, int width, const char* name) {
+    if (b.isEmpty()) return;
+    if (b.size() != width || b.rank() > 2 || (b.rank() == 2 && b.shapeView()[0] != 1)) {
+        throw std::invalid_argument(std::string(op) + ": " + name + " must have shape [" + std::to_string(width) +
+                                    "] or [1, " + std::to_string(width) + "]!");
+    }
+}
+
+// Gate width of a [rows, gates * hidden] weight.
+int hiddenSize(const char* op, const Tensor& W, int gates) {
+    const auto& s = W.shapeView();
+    if (s.size() != 2 || s[1] == 0 || s[1] % gates != 0) {
+        throw std::invalid_argument(std::string(op) + ": W_ih must be [in, " + std::to_string(gates) + " * hidden]!");
+    }
+    return s[1] / gates;
+}
+
+struct LSTMShape {
+    int steps;
+    int batch;
+    int in;
+    int hidden;
+};
+
+// Row (t, b) of hc holds h | c after step t; the same row of gates holds i, f, g, o
+// after activation. h0 / c0 may be null (zeros).
+void lstmForward(const LSTMShape& s, const double* X, const double* h0, const double* c0, const double* Wih,
+                 const double* Whh, const double* bias, double* gates, double* hc) {
+    int H = s.hidden, G = 4 * H, rows = s.steps * s.batch;
+    if (bias) {
+        for (int r = 0; r < rows; ++r) std::copy(bias, bias + G, gates + static_cast<size_t>(r) * G);
+    }
+    // Input projection for every step in one GEMM; only h W_hh is left for the recurrence.
+    gemmAccumulate(X, Wih, gates, rows, s.in, G);
+
+    for (int t = 0; t < s.steps; ++t) {
+        size_t row0 = static_cast<size_t>(t) * s.batch;
+        for (int bi = 0; bi < s.batch; ++bi) {
+            size_t row = row0 + bi;
+            const double* hprev = t ? hc + (row - s.batch) * 2 * H : (h0 ? h0 + static_cast<size_t>(bi) * H : nullptr);
+            const double* cprev = t ? hprev + H : (c0 ? c0 + static_cast<size_t>(bi) * H : nullptr);
+            double* z = gates + row * G;
+            if (hprev) gemmAccumulate(hprev, Whh, z, 1, H, G);
+            double* h = hc + row * 2 * H;
+            double* c = h + H;
+            for (int j = 0; j < H; ++j) {
+                double i = sigmoid(z[j]);
+                double f = sigmoid(z[H + j]);
+                double g = std::tanh(z[2 * H + j]);
+                double o = sigmoid(z[3 * H + j]);
+                z[j] = i;
+                z[H + j] = f;
+                z[2 * H + j] = g;
+                z[3 * H + j] = o;
+                c[j] = f * (cprev ? cprev[j] : 0.0) + i * g;
+                h[j] = o * std::tanh(c[j]);
+            }
+        }
+    }
+}
+
+// Null where no gradient is needed.
+struct LSTMGrads {
+    double* dX;
+    double* dh0;
+    double* dc0;
+    double* dWih;
+    double* dWhh;
+    double* db;
+};
+
+// Backward through time. One reverse sweep turns dhc (gradients of every h and c) into
+// pre-activation gate gradients dz, carrying dh and dc between steps; dh needs one
+// [batch, 4H] x [4H, H] product per step. dX, dW_ih, dW_hh and db are then batched over
+// all steps.
+void lstmBackward(const LSTMShape& s, const double* X, const double* h0, const double* c0, const double* Wih,
+                  const double* Whh, const double* gates, const double* hc, const double* dhc, const LSTMGrads& d) {
+    int H = s.hidden, G = 4 * H, B = s.batch, rows = s.steps * B;
+    std::vector<double> dz(static_cast<size_t>(rows) * G);
+    std::vector<double> dh(static_cast<size_t>(B) * H, 0.0), dc(static_cast<size_t>(B) * H, 0.0);
+
+    for (int t = s.steps - 1; t >= 0; --t) {
+        for (int bi = 0; bi < B; ++bi) {
+            size_t row = static_cast<size_t>(t) * B + bi;
+            const double* z = gates + row * G;
+            const double* c = hc + row * 2 * H + H;
+            const double* cprev = t ? c - static_cast<size_t>(B) * 2 * H : (c0 ? c0 + static_cast<size_t>(bi) * H : nullptr);
+            const double* gh = dhc + row * 2 * H;
+            const double* gc = gh + H;
+            double* dzrow = dz.data() + row * G;
+            double* dhb = dh.data() + static_cast<size_t>(bi) * H;
+            double* dcb = dc.data() + static_cast<size_t>(bi) * H;
+            for (int j = 0; j < H; ++j) {
+                double i = z[j], f = z[H + j], g = z[2 * H + j], o = z[3 * H + j];
+                double tc = std::tanh(c[j]);
+                double dhj = gh[j] + dhb[j];
+                double dcj = gc[j] + dcb[j] + dhj * o * (1.0 - tc * tc);
+                double cp = cprev ? cprev[j] : 0.0;
+                dzrow[j] = dcj * g * i * (1.0 - i);
+                dzrow[H + j] = dcj * cp * f * (1.0 - f);
+                dzrow[2 * H + j] = dcj * i * (1.0 - g * g);
+                dzrow[3 * H + j] = dhj * tc * o * (1.0 - o);
+                dcb[j] = dcj * f;
+            }
+        }
+        if (t > 0 || d.dh0) {
+            std::fill(dh.begin(), dh.end(), 0.0);
+            gemmAccumulateBT(dz.data() + static_cast<size_t>(t) * B * G, Whh, dh.data(), B, H, G);
+        }
+    }
+    if (d.dh0) {
+        for (size_t q = 0; q < dh.size(); ++q) d.dh0[q] += dh[q];
+    }
+    if (d.dc0) {
+        for (size_t q = 0; q < dc.size(); ++q) d.dc0[q] += dc[q];
+    }
+
+    if (d.dX) gemmAccumulateBT(dz.data(), Wih, d.dX, rows, s.in, G);
+    if (d.dWih) gemmAccumulateAT(X, dz.data(), d.dWih, rows, s.in, G);
+    if (d.dWhh) {
+        // dz of step t pairs with h of step t - 1 (h0 for step 0)
+        for (int t = 0; t < s.steps; ++t) {
+            for (int bi = 0; bi < B; ++bi) {
+                size_t row = static_cast<size_t>(t) * B + bi;
+                const double* hprev = t ? hc + (row - B) * 2 * H : (h0 ? h0 + static_cast<size_t>(bi) * H : nullptr);
+                if (hprev) gemmAccumulateAT(hprev, dz.data() + row * G, d.dWhh, 1, H, G);
+            }
+        }
+    }
+    if (d.db) addColumnSums(dz.data(), d.db, rows, G);
+}
+
+// out = rows [row0, row0 + rows) x columns [col0, col0 + width) of the 2D src.
+Tensor takeBlock(const Tensor& src, int row0, int rows, int col0, int width, const DimVector& shape) {
+    int cols = src.shapeView()[1];
+    Tensor out(shape, src.requiresGrad());
+    const double* S = src.getData().data();
+    double* O = out.getMutableData().data();
+    for (int r = 0; r < rows; ++r) {
+        const double* srow = S + static_cast<size_t>(row0 + r) * cols + col0;
+        std::copy(srow, srow + width, O + static_cast<size_t>(r) * width);
+    }
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_unary_backward(out, src, [out_weak, src, row0, rows, col0, width, cols]() {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        double* dS = src.getMutableGrad().data();
+        const double* g = out_impl->grad.data();
+        for (int r = 0; r < rows; ++r) {
+            double* drow = dS + static_cast<size_t>(row0 + r) * cols + col0;
+            const double* grow = g + static_cast<size_t>(r) * width;
+            for (int j = 0; j < width; ++j) drow[j] += grow[j];
+        }
+    });
+    return out;
+}
+
+LSTMShape checkLSTM(const char* op, const Tensor& x, const LSTMState& state, const Tensor& W_ih, const Tensor& W_hh,
+                    const Tensor& b, bool sequence) {
+    checkOperands(op, {&x, &state.h, &state.c, &W_ih, &W_hh, &b});
+    const auto& sx = x.shapeView();
+    if (sx.size() != (sequence ? 3u : 2u)) {
+        throw std::invalid_argument(std::string(op) + (sequence ? " expects x as [steps, batch, in]!" : " expects x as [batch, in]!"));
+    }
+    LSTMShape s{sequence ? sx[0] : 1, sx[sx.size() - 2], sx[sx.size() - 1], hiddenSize(op, W_ih, 4)};
+    if (s.steps == 0 || s.batch == 0) throw std::invalid_argument(std::string(op) + ": empty input!");
+    checkMatrix(op, W_ih, s.in, 4 * s.hidden, "W_ih");
+    checkMatrix(op, W_hh, s.hidden, 4 * s.hidden, "W_hh");
+    checkBias(op, b, 4 * s.hidden, "b");
+    if (!state.h.isEmpty()) checkMatrix(op, state.h, s.batch, s.hidden, "state.h");
+    if (!state.c.isEmpty()) checkMatrix(op, state.c, s.batch, s.hidden, "state.c");
+    return s;
+}
+
+// Runs the LSTM kernel and returns the [steps * batch, 2 * hidden] (h | c) node the
+// outputs are cut from.
+Tensor lstmNode(const LSTMShape& s, const Tensor& x, const LSTMState& state, const Tensor& W_ih, const Tensor& W_hh,
+                const Tensor& b) {
+    int rows = s.steps * s.batch;
+    bool req_grad = anyRequiresGrad({&x, &state.h, &state.c, &W_ih, &W_hh, &b});
+    Tensor hc({rows, 2 * s.hidden}, req_grad);
+    auto gates = std::make_shared<std::vector<double>>(static_cast<size_t>(rows) * 4 * s.hidden, 0.0);
+    lstmForward(s, x.getData().data(), dataOrNull(state.h), dataOrNull(state.c), W_ih.getData().data(),
+                W_hh.getData().data(), dataOrNull(b), gates->data(), hc.getMutableData().data());
+
+    if (!should_record(hc)) return hc;
+    auto& parents = hc.getImpl()->parents;
+    parents.reserve(6);
+    for (const Tensor* t : {&x, &state.h, &state.c, &W_ih, &W_hh, &b}) {
+        if (!t->isEmpty()) parents.push_back(*t);
+    }
+    auto out_weak = std::weak_ptr<TensorImpl>(hc.getImpl());
+    attach_backward_fn(hc, [out_weak, s, x, h0 = state.h, c0 = state.c, W_ih, W_hh, b, gates]() {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        LSTMGrads d{gradOrNull(x), gradOrNull(h0), gradOrNull(c0), gradOrNull(W_ih), gradOrNull(W_hh), gradOrNull(b)};
+        lstmBackward(s, x.getData().data(), dataOrNull(h0), dataOrNull(c0), W_ih.getData().data(),
+                     W_hh.getData().data(), gates->data(), out_impl->data.data(), out_impl->grad.data(), d);
+    });
+    memory::onGraphAttach(*hc.getImpl(), gates->size() * sizeof(double));
+    return hc;
+}
+
+// Per row of saved: r, z, n, h W_hn + b_hn.
+void gruForward(int B, int in, int H, const double* X, const double* h, const double* Wih, const double* Whh,
+                const double* bih, const double* bhh, double* saved, double* out) {
+    int G = 3 * H;
+    std::vector<double> gi(static_cast<size_t>(B) * G, 0.0), gh(static_cast<size_t>(B) * G, 0.0);
+    for (int bi = 0; bi < B; ++bi) {
+        if (bih) std::copy(bih, bih + G, gi.begin() + static_cast<size_t>(bi) * G);
+        if (bhh) std::copy(bhh, bhh + G, gh.begin() + static_cast<size_t>(bi) * G);
+    }
+    gemmAccumulate(X, Wih, gi.data(), B, in, G);
+    gemmAccumulate(h, Whh, gh.data(), B, H, G);
+    for (int bi = 0; bi < B; ++bi) {
+        const double* a = gi.data() + static_cast<size_t>(bi) * G;
+        const double* c = gh.data() + static_cast<size_t>(bi) * G;
+        const double* hrow = h + static_cast<size_t>(bi) * H;
+        double* srow = saved + static_cast<size_t>(bi) * 4 * H;
+        double* orow = out + static_cast<size_t>(bi) * H;
+        for (int j = 0; j < H; ++j) {
+            double r = sigmoid(a[j] + c[j]);
+            double z = sigmoid(a[H + j] + c[H + j]);
+            double n = std::tanh(a[2 * H + j] + r * c[2 * H + j]);
+            srow[j] = r;
+            srow[H + j] = z;
+            srow[2 * H + j] = n;
+            srow[3 * H + j] = c[2 * H + j];
+            orow[j] = (1.0 - z) * n + z * hrow[j];
+        }
+    }
+}
+
+void gruBackward(int B, int in, int H, const double* X, const double* h, const double* Wih, const double* Whh,
+                 const double* saved, const double* dout, double* dX, double* dh, double* dWih, double* dWhh,
+                 double* dbih, double* dbhh) {
+    int G = 3 * H;
+    std::vector<double> dgi(static_cast<size_t>(B) * G), dgh(static_cast<size_t>(B) * G);
+    for (int bi = 0; bi < B; ++bi) {
+        const double* srow = saved + static_cast<size_t>(bi) * 4 * H;
+        const double* hrow = h + static_cast<size_t>(bi) * H;
+        const double* grow = dout + static_cast<size_t>(bi) * H;
+        double* di = dgi.data() + static_cast<size_t>(bi) * G;
+        double* dhh = dgh.data() + static_cast<size_t>(bi) * G;
+        for (int j = 0; j < H; ++j) {
+            double r = srow[j], z = srow[H + j], n = srow[2 * H + j], hn = srow[3 * H + j];
+            double g = grow[j];
+            double dn = g * (1.0 - z) * (1.0 - n * n);
+            double dr = dn * hn * r * (1.0 - r);
+            double dzp = g * (hrow[j] - n) * z * (1.0 - z);
+            di[j] = dhh[j] = dr;
+            di[H + j] = dhh[H + j] = dzp;
+            di[2 * H + j] = dn;
+            dhh[2 * H + j] = dn * r;
+            if (dh) dh[static_cast<size_t>(bi) * H + j] += g * z;
+        }
+    }
+    if (dX) gemmAccumulateBT(dgi.data(), Wih, dX, B, in, G);
+    if (dh) gemmAccumulateBT(dgh.data(), Whh, dh, B, H, G);
+    if (dWih) gemmAccumulateAT(X, dgi.data(), dWih, B, in, G);
+    if (dWhh) gemmAccumulateAT(h, dgh.data(), dWhh, B, H, G);
+    if (dbih) addColumnSums(dgi.data(), dbih, B, G);
+    if (dbhh) addColumnSums(dgh.data(), dbhh, B, G);
+}
+
+} // namespace
+
+LSTMOutput lstm(const Tensor& x, const LSTMState& state, const Tensor& W_ih, const Tensor& W_hh, const Tensor& b) {
+    profiler::OpScope prof("lstm", {&x, &state.h, &state.c, &W_ih, &W_hh, &b});
+    LSTMShape s = checkLSTM("ops::lstm", x, state, W_ih, W_hh, b, true);
+    Tensor hc = lstmNode(s, x, state, W_ih, W_hh, b);
+    int rows = s.steps * s.batch, H = s.hidden;
+    return {takeBlock(hc, 0, rows, 0, H, {s.steps, s.batch, H}),
+            {takeBlock(hc, rows - s.batch, s.batch, 0, H, {s.batch, H}),
+             takeBlock(hc, rows - s.batch, s.batch, H, H, {s.batch, H})}};
+}
+
+LSTMState lstm_cell(const Tensor& x, const LSTMState& state, const Tensor& W_ih, const Tensor& W_hh, const Tensor& b) {
+    profiler::OpScope prof("lstm_cell", {&x, &state.h, &state.c, &W_ih, &W_hh, &b});
+    LSTMShape s = checkLSTM("ops::lstm_cell", x, state, W_ih, W_hh, b, false);
+    Tensor hc = lstmNode(s, x, state, W_ih, W_hh, b);
+    return {takeBlock(hc, 0, s.batch, 0, s.hidden, {s.batch, s.hidden}),
+            takeBlock(hc, 0, s.batch, s.hidden, s.hidden, {s.batch, s.hidden})};
+}
+
+Tensor gru_cell(const Tensor& x, const Tensor& h, const Tensor& W_ih, const Tensor& W_hh, const Tensor& b_ih,
+                const Tensor& b_hh) {
+    profiler::OpScope prof("gru_cell", {&x, &h, &W_ih, &W_hh, &b_ih, &b_hh});
+    const char* op = "ops::gru_cell";
+    checkOperands(op, {&x, &h, &W_ih, &W_hh, &b_ih, &b_hh});
+    if (x.rank() != 2) throw std::invalid_argument("ops::gru_cell expects x as [batch, in]!");
+    int B = x.shapeView()[0], in = x.shapeView()[1], H = hiddenSize(op, W_ih, 3);
+    checkMatrix(op, W_ih, in, 3 * H, "W_ih");
+    checkMatrix(op, W_hh, H, 3 * H, "W_hh");
+    checkMatrix(op, h, B, H, "h");
+    checkBias(op, b_ih, 3 * H, "b_ih");
+    checkBias(op, b_hh, 3 * H, "b_hh");
+
+    bool req_grad = anyRequiresGrad({&x, &h, &W_ih, &W_hh, &b_ih, &b_hh});
+    Tensor out({B, H}, req_grad);
+    auto saved = std::make_shared<std::vector<double>>(static_cast<size_t>(B) * 4 * H);
+    gruForward(B, in, H, x.getData().data(), h.getData().data(), W_ih.getData().data(), W_hh.getData().data(),
+               dataOrNull(b_ih), dataOrNull(b_hh), saved->data(), out.getMutableData().data());
+
+    if (!should_record(out)) return out;
+    auto& parents = out.getImpl()->parents;
+    parents.reserve(6);
+    for (const Tensor* t : {&x, &h, &W_ih, &W_hh, &b_ih, &b_hh}) {
+        if (!t->isEmpty()) parents.push_back(*t);
+    }
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_backward_fn(out, [out_weak, B, in, H, x, h, W_ih, W_hh, b_ih, b_hh, saved]() {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        gruBackward(B, in, H, x.getData().data(), h.getData().data(), W_ih.getData().data(), W_hh.getData().data(),
+                    saved->data(), out_impl->grad.data(), gradOrNull(x), gradOrNull(h), gradOrNull(W_ih),
+                    gradOrNull(W_hh), gradOrNull(b_ih), gradOrNull(b_hh));
+    });
+    memory::onGraphAttach(*out.getImpl(), saved->size() * sizeof(double));
+    return out;
+}
+
+} // namespace ops
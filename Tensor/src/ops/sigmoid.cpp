@@ -1,15 +1,41 @@
 #include "../../include/ops/sigmoid.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
 #include <cmath>
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> sigmoid_vjp(const Tensor& out, const std::vector<Tensor>&, const Tensor& g) {
+    return {g * (out - out * out)};
+}
+
+} // namespace
+
 Tensor sigmoid(const Tensor& t) {
-    Tensor out(t.getShape(), t.requiresGrad());
+    profiler::OpScope prof("sigmoid", {&t});
+    if (isLowPrecision(t)) {
+        Tensor out = mapLowPrecision(t, t.requiresGrad(), [](float x) { return 1.0f / (1.0f + std::exp(-x)); });
+        auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+        attach_unary_backward(out, t, [out_weak, t]() mutable {
+            auto out_impl = out_weak.lock(); if (!out_impl) return;
+            if (!t.requiresGrad()) return;
+            std::vector<float> dy = widen(Tensor(out_impl));
+            for (float& y : dy) y = y * (1.0f - y);
+            accumulateLowPrecisionGrad(t, out_impl->grad, 1.0, &dy);
+        });
+        return out;
+    }
+
+    Tensor out(t.shapeView(), t.requiresGrad());
     const auto& dt = t.getData();
     auto& dout = out.getMutableData();
     for (size_t i = 0; i < dt.size(); ++i) dout[i] = 1.0 / (1.0 + std::exp(-dt[i]));
 
+    unary_tangent(out, t, [&](int i) { return dout[i] * (1.0 - dout[i]); });
+    if (record_on_tape(out, autograd::TapeOp::Sigmoid, t)) return out;
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_unary_backward(out, t, [out_weak, t]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -20,6 +46,7 @@ Tensor sigmoid(const Tensor& t) {
             for (size_t i = 0; i < og.size(); ++i) tg[i] += og[i] * dout[i] * (1.0 - dout[i]);
         }
     });
+    attach_vjp(out, sigmoid_vjp);
     return out;
 }
 
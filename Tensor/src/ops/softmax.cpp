@@ -1,93 +1,92 @@
 #include "../../include/ops/softmax.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/matmul.hpp"
+#include "../../include/ops/sum.hpp"
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
 
 namespace ops {
 
+namespace {
+
+// dx = y * (g - rowsum(g * y)); for 2D inputs the row sums are broadcast back by
+// multiplying with ones, which keeps the expression differentiable.
+std::vector<Tensor> softmax_vjp(const Tensor& out, const std::vector<Tensor>&, const Tensor& g) {
+    Tensor gy = g * out;
+    const auto& shape = out.shapeView();
+    if (shape.size() == 1) return {out * (g - ops::sum(gy))};
+    if (shape.size() != 2) throw std::runtime_error("Softmax double backward supports 1D and 2D inputs!");
+    int last_dim = shape[1];
+    Tensor rows = ops::matmul(ops::matmul(gy, Tensor::ones({last_dim, 1})), Tensor::ones({1, last_dim}));
+    return {out * (g - rows)};
+}
+
+} // namespace
+
 Tensor softmax(const Tensor& t) {
-    auto shape = t.getShape();
+    profiler::OpScope prof("softmax", {&t});
+    const auto& shape = t.shapeView();
     if (shape.empty()) throw std::invalid_argument("Softmax cannot apply to empty Tensor");
 
     Tensor out(shape, t.requiresGrad());
-    
-    if (shape.size() == 1) {
-        double max_val = t.at({0});
-        for (int i = 1; i < shape[0]; ++i) max_val = std::max(max_val, t.at({i}));
-        
-        std::vector<double> exp_vals(shape[0]);
+
+    // Softmax runs over the last dimension: view the tensor as [outer, last] rows.
+    int last_dim = shape.back();
+    int outer_size = t.size() / last_dim;
+    TensorAccessor<double, 2> in(t.getMutableData().data(), {outer_size, last_dim});
+    TensorAccessor<double, 2> res(out.getMutableData().data(), {outer_size, last_dim});
+    for (int outer = 0; outer < outer_size; ++outer) {
+        const double* x = in.row(outer);
+        double* y = res.row(outer);
+        double max_val = x[0];
+        for (int i = 1; i < last_dim; ++i) max_val = std::max(max_val, x[i]);
         double sum_exp = 0.0;
-        for (int i = 0; i < shape[0]; ++i) {
-            exp_vals[i] = std::exp(t.at({i}) - max_val);
-            sum_exp += exp_vals[i];
+        for (int i = 0; i < last_dim; ++i) {
+            y[i] = std::exp(x[i] - max_val);
+            sum_exp += y[i];
         }
-        for (int i = 0; i < shape[0]; ++i) {
-            out.set({i}, exp_vals[i] / sum_exp);
-        }
-    } else {
-        int last_dim = shape.back();
-        int outer_size = t.size() / last_dim;
+        for (int i = 0; i < last_dim; ++i) y[i] /= sum_exp;
+    }
+
+    // Tangent: dy = y * (dx - sum(y * dx)) per row.
+    if (const double* tt = tangent_of(t)) {
+        TensorAccessor<const double, 2> tin(tt, {outer_size, last_dim});
+        TensorAccessor<double, 2> tres(make_tangent(out), {outer_size, last_dim});
         for (int outer = 0; outer < outer_size; ++outer) {
-            std::vector<int> idx(shape.size(), 0);
-            int rem = outer;
-            for (int j = static_cast<int>(shape.size()) - 2; j >= 0; --j) {
-                idx[j] = rem % shape[j];
-                rem /= shape[j];
-            }
-            double max_val = t.at(idx);
-            for (int i = 1; i < last_dim; ++i) {
-                idx.back() = i;
-                max_val = std::max(max_val, t.at(idx));
-            }
-            std::vector<double> exp_vals(last_dim);
-            double sum_exp = 0.0;
-            for (int i = 0; i < last_dim; ++i) {
-                idx.back() = i;
-                exp_vals[i] = std::exp(t.at(idx) - max_val);
-                sum_exp += exp_vals[i];
-            }
-            for (int i = 0; i < last_dim; ++i) {
-                idx.back() = i;
-                out.set(idx, exp_vals[i] / sum_exp);
-            }
+            const double* dx = tin.row(outer);
+            const double* y = res.row(outer);
+            double* dy = tres.row(outer);
+            double dot = 0.0;
+            for (int i = 0; i < last_dim; ++i) dot += y[i] * dx[i];
+            for (int i = 0; i < last_dim; ++i) dy[i] = y[i] * (dx[i] - dot);
         }
     }
-
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
-    attach_unary_backward(out, t, [out_weak, t, shape]() mutable {
+    attach_unary_backward(out, t, [out_weak, t, outer_size, last_dim]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
         if (!t.requiresGrad()) return;
-        const auto& og = out_impl->grad;
-        const auto& dout = out_impl->data;
-        auto& tg = t.getMutableGrad();
+        TensorAccessor<double, 2> og(out_impl->grad.data(), {outer_size, last_dim});
+        TensorAccessor<double, 2> dout(out_impl->data.data(), {outer_size, last_dim});
+        TensorAccessor<double, 2> tg(t.getMutableGrad().data(), {outer_size, last_dim});
 
-        if (shape.size() == 1) {
-            int n = shape[0];
-            for (int i = 0; i < n; ++i) {
+        for (int outer = 0; outer < outer_size; ++outer) {
+            const double* g = og.row(outer);
+            const double* y = dout.row(outer);
+            double* dx = tg.row(outer);
+            for (int i = 0; i < last_dim; ++i) {
+                double yi = y[i];
                 double sum = 0.0;
-                for (int j = 0; j < n; ++j) {
+                for (int j = 0; j < last_dim; ++j) {
                     double kronecker = (i == j) ? 1.0 : 0.0;
-                    sum += og[j] * dout[j] * (kronecker - dout[i]);
-                }
-                tg[i] += sum;
-            }
-        } else {
-            int last_dim = shape.back();
-            int outer_size = t.size() / last_dim;
-            for (int outer = 0; outer < outer_size; ++outer) {
-                int offset = outer * last_dim;
-                for (int i = 0; i < last_dim; ++i) {
-                    double sum = 0.0;
-                    for (int j = 0; j < last_dim; ++j) {
-                        double kronecker = (i == j) ? 1.0 : 0.0;
-                        sum += og[offset + j] * dout[offset + j] * (kronecker - dout[offset + i]);
-                    }
-                    tg[offset + i] += sum;
+                    sum += g[j] * y[j] * (kronecker - yi);
                 }
+                dx[i] += sum;
             }
         }
     });
+    attach_vjp(out, softmax_vjp);
 
     return out;
 }
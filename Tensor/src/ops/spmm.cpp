@@ -0,0 +1,71 @@
+#include "../../include/ops/spmm.hpp"
+#include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/utils/Parallel.hpp"
+#include <mutex>
+#include <stdexcept>
+
+namespace ops {
+
+namespace {
+
+// out[i, :] += sum_p values[p] * B[col_idx[p], :] for every CSR row, rows split across threads.
+void spmm_accumulate(const SparseImpl& s, TensorAccessor<double, 2> B, TensorAccessor<double, 2> out) {
+    int p = B.size(1);
+    int64_t avg_row_work = (static_cast<int64_t>(s.values.size()) * p) / std::max(1, s.rows) + 1;
+    int64_t grain = std::max<int64_t>(1, 32768 / avg_row_work);
+    parallel::parallel_for(0, s.rows, grain, [&](int64_t lo, int64_t hi) {
+        for (int64_t i = lo; i < hi; ++i) {
+            double* orow = out.row(static_cast<int>(i));
+            for (int q = s.indices[i]; q < s.indices[i + 1]; ++q) {
+                double v = s.values[q];
+                const double* brow = B.row(s.col_idx[q]);
+                for (int j = 0; j < p; ++j) orow[j] += v * brow[j];
+            }
+        }
+    });
+}
+
+// A's impl is shared by every copy of A, so backward passes on several threads may
+// reach the cached transpose at once.
+std::mutex transpose_mutex;
+
+std::shared_ptr<const SparseImpl> cachedTranspose(const SparseTensor& A) {
+    std::lock_guard<std::mutex> lock(transpose_mutex);
+    auto impl = A.getImpl();
+    if (!impl->transposed) impl->transposed = A.transpose().getImpl();
+    return impl->transposed;
+}
+
+} // namespace
+
+Tensor matmul(const SparseTensor& a, const Tensor& b) {
+    profiler::OpScope prof("spmm", {&b});
+    const auto& shapeB = b.shapeView();
+    if (shapeB.size() != 2) throw std::invalid_argument("Sparse matmul requires a 2D dense operand!");
+    if (a.cols() != shapeB[0]) throw std::invalid_argument("Sparse matmul dimension mismatch!");
+
+    SparseTensor A = a.toCSR();
+    int m = A.rows(), p = shapeB[1];
+    Tensor out({m, p}, b.requiresGrad());
+    spmm_accumulate(*A.getImpl(), b.accessor<2>(), out.accessor<2>());
+
+    if (has_tangent(b)) {
+        spmm_accumulate(*A.getImpl(), TensorAccessor<double, 2>(b.getImpl()->tangent.data(), {shapeB[0], p}),
+                        TensorAccessor<double, 2>(make_tangent(out), {m, p}));
+    }
+    auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+    attach_unary_backward(out, b, [out_weak, A, b]() mutable {
+        auto out_impl = out_weak.lock(); if (!out_impl) return;
+        if (!b.requiresGrad()) return;
+        // dB = A^T * G; the CSR transpose is cached on A for later steps.
+        auto At = cachedTranspose(A);
+        spmm_accumulate(*At, out_impl->gradAccessor<2>(), b.gradAccessor<2>());
+    });
+    attach_vjp(out, [A](const Tensor&, const std::vector<Tensor>&, const Tensor& g) -> std::vector<Tensor> {
+        return {ops::matmul(A.transpose(), g)};
+    });
+    return out;
+}
+
+} // namespace ops
@@ -1,23 +1,45 @@
 #include "../../include/ops/sum.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
+#include "../../include/ops/mul.hpp"
+#include "../../include/utils/Reduce.hpp"
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> sum_vjp(const Tensor&, const std::vector<Tensor>& in, const Tensor& g) {
+    return {ops::mul(g, Tensor::ones(in[0].shapeView()))};
+}
+
+} // namespace
+
 Tensor sum(const Tensor& t) {
+    profiler::OpScope prof("sum", {&t});
     bool req_grad = t.requiresGrad();
-    double s = 0.0;
-    const auto& dt = t.getData();
-    for (double val : dt) s += val;
+    double s = isLowPrecision(t) ? reduce::sum(t.dtype(), t.getHalfData().data(), t.size())
+                                 : reduce::sum(t.getData().data(), t.size());
     Tensor out({1}, {s}, req_grad);
 
+    if (const double* tt = tangent_of(t)) {
+        double ts = reduce::sum(tt, t.size());
+        make_tangent(out)[0] = ts;
+    }
+    if (!isLowPrecision(t) && record_on_tape(out, autograd::TapeOp::Sum, t)) return out;
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_unary_backward(out, t, [out_weak, t]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
         if (!t.requiresGrad()) return;
         double og = out_impl->grad[0];
+        if (isLowPrecision(t)) {
+            accumulateLowPrecisionGrad(t, std::vector<double>(t.size(), og), 1.0);
+            return;
+        }
         auto& tg = t.getMutableGrad();
         for (size_t i = 0; i < tg.size(); ++i) tg[i] += og;
     });
+    if (!isLowPrecision(t)) attach_vjp(out, sum_vjp);
     return out;
 }
 
@@ -1,15 +1,26 @@
 #include "../../include/ops/tan.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
 #include <cmath>
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> tan_vjp(const Tensor& out, const std::vector<Tensor>&, const Tensor& g) {
+    return {g * (out * out + 1.0)};
+}
+
+} // namespace
+
 Tensor tan(const Tensor& t) {
-    Tensor out(t.getShape(), t.requiresGrad());
+    profiler::OpScope prof("tan", {&t});
+    Tensor out(t.shapeView(), t.requiresGrad());
     const auto& dt = t.getData();
     auto& dout = out.getMutableData();
     for (size_t i = 0; i < dt.size(); ++i) dout[i] = std::tan(dt[i]);
 
+    unary_tangent(out, t, [&](int i) { return 1.0 + dout[i] * dout[i]; });
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_unary_backward(out, t, [out_weak, t]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -20,6 +31,7 @@ Tensor tan(const Tensor& t) {
             for (size_t i = 0; i < og.size(); ++i) tg[i] += og[i] * (1.0 + dout[i] * dout[i]);
         }
     });
+    attach_vjp(out, tan_vjp);
     return out;
 }
 
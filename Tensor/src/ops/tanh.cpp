@@ -1,15 +1,41 @@
 #include "../../include/ops/tanh.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
+#include "../../include/ops/LowPrecision.hpp"
 #include <cmath>
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> tanh_vjp(const Tensor& out, const std::vector<Tensor>&, const Tensor& g) {
+    return {g - g * out * out};
+}
+
+} // namespace
+
 Tensor tanh(const Tensor& t) {
-    Tensor out(t.getShape(), t.requiresGrad());
+    profiler::OpScope prof("tanh", {&t});
+    if (isLowPrecision(t)) {
+        Tensor out = mapLowPrecision(t, t.requiresGrad(), [](float x) { return std::tanh(x); });
+        auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
+        attach_unary_backward(out, t, [out_weak, t]() mutable {
+            auto out_impl = out_weak.lock(); if (!out_impl) return;
+            if (!t.requiresGrad()) return;
+            std::vector<float> dy = widen(Tensor(out_impl));
+            for (float& y : dy) y = 1.0f - y * y;
+            accumulateLowPrecisionGrad(t, out_impl->grad, 1.0, &dy);
+        });
+        return out;
+    }
+
+    Tensor out(t.shapeView(), t.requiresGrad());
     const auto& dt = t.getData();
     auto& dout = out.getMutableData();
     for (size_t i = 0; i < dt.size(); ++i) dout[i] = std::tanh(dt[i]);
 
+    unary_tangent(out, t, [&](int i) { return 1.0 - dout[i] * dout[i]; });
+    if (record_on_tape(out, autograd::TapeOp::Tanh, t)) return out;
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_unary_backward(out, t, [out_weak, t]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
@@ -20,6 +46,7 @@ Tensor tanh(const Tensor& t) {
             for (size_t i = 0; i < og.size(); ++i) tg[i] += og[i] * (1.0 - dout[i] * dout[i]);
         }
     });
+    attach_vjp(out, tanh_vjp);
     return out;
 }
 
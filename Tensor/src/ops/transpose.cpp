@@ -1,31 +1,49 @@
 #include "../../include/ops/transpose.hpp"
 #include "../../include/ops/AutodiffHelper.hpp"
+#include "../../include/ops/ForwardAD.hpp"
 #include <stdexcept>
 
 namespace ops {
 
+namespace {
+
+std::vector<Tensor> transpose_vjp(const Tensor&, const std::vector<Tensor>&, const Tensor& g) {
+    return {ops::transpose(g)};
+}
+
+} // namespace
+
 Tensor transpose(const Tensor& t) {
-    auto shape = t.getShape();
+    profiler::OpScope prof("transpose", {&t});
+    const auto& shape = t.shapeView();
     if (shape.size() != 2) throw std::invalid_argument("Transpose currently supports 2D matrices!");
     int rows = shape[0], cols = shape[1];
     Tensor out({cols, rows}, t.requiresGrad());
 
+    auto T = t.accessor<2>();
+    auto O = out.accessor<2>();
     for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            out.set({j, i}, t.at({i, j}));
-        }
+        const double* trow = T.row(i);
+        for (int j = 0; j < cols; ++j) O(j, i) = trow[j];
     }
 
+    if (const double* tt = tangent_of(t)) {
+        double* to = make_tangent(out);
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < cols; ++j) to[j * rows + i] = tt[i * cols + j];
+    }
     auto out_weak = std::weak_ptr<TensorImpl>(out.getImpl());
     attach_unary_backward(out, t, [out_weak, t, rows, cols]() mutable {
         auto out_impl = out_weak.lock(); if (!out_impl) return;
         if (!t.requiresGrad()) return;
+        auto G = out_impl->gradAccessor<2>();
+        auto dT = t.gradAccessor<2>();
         for (int i = 0; i < rows; ++i) {
-            for (int j = 0; j < cols; ++j) {
-                t.gradAt({i, j}) += out_impl->grad[j * rows + i];
-            }
+            double* dtrow = dT.row(i);
+            for (int j = 0; j < cols; ++j) dtrow[j] += G(j, i);
         }
     });
+    attach_vjp(out, transpose_vjp);
     return out;
 }
 
@@ -0,0 +1,72 @@
+#include "../../include/quant/QGemm.hpp"
+#include "../../include/utils/Parallel.hpp"
+#include <algorithm>
+
+namespace quant {
+
+namespace {
+
+constexpr int kBlockK = 32;
+
+// Raw dot products of one A row against four packed B rows.
+// K is walked in fixed-size blocks so the compiler can vectorize the inner loop.
+inline void dot4(const int8_t* a, const int8_t* b0, const int8_t* b1, const int8_t* b2, const int8_t* b3, int K,
+                 int32_t out[4]) {
+    int32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    int k = 0;
+    for (; k + kBlockK <= K; k += kBlockK) {
+        for (int t = 0; t < kBlockK; ++t) {
+            int32_t av = a[k + t];
+            s0 += av * b0[k + t];
+            s1 += av * b1[k + t];
+            s2 += av * b2[k + t];
+            s3 += av * b3[k + t];
+        }
+    }
+    for (; k < K; ++k) {
+        int32_t av = a[k];
+        s0 += av * b0[k];
+        s1 += av * b1[k];
+        s2 += av * b2[k];
+        s3 += av * b3[k];
+    }
+    out[0] = s0; out[1] = s1; out[2] = s2; out[3] = s3;
+}
+
+inline int32_t dot1(const int8_t* a, const int8_t* b, int K) {
+    int32_t s = 0;
+    for (int k = 0; k < K; ++k) s += static_cast<int32_t>(a[k]) * b[k];
+    return s;
+}
+
+} // namespace
+
+void gemm_s8s8s32(int M, int N, int K, const int8_t* A, int32_t a_zp, const int8_t* B, const int32_t* b_zp,
+                  const int32_t* b_colsum, int32_t* C) {
+    bool any_b_zp = std::any_of(b_zp, b_zp + N, [](int32_t z) { return z != 0; });
+    int64_t grain = std::max<int64_t>(1, 65536 / (static_cast<int64_t>(N) * K + 1));
+
+    parallel::parallel_for(0, M, grain, [&](int64_t lo, int64_t hi) {
+        for (int64_t i = lo; i < hi; ++i) {
+            const int8_t* a = A + i * K;
+            int32_t* c = C + i * N;
+
+            // (a - za)(b - zb) = ab - zb*sum(a) - za*sum(b) + K*za*zb
+            int32_t a_rowsum = 0;
+            if (any_b_zp) {
+                for (int k = 0; k < K; ++k) a_rowsum += a[k];
+            }
+            int j = 0;
+            for (; j + 4 <= N; j += 4) {
+                const int8_t* b = B + static_cast<int64_t>(j) * K;
+                dot4(a, b, b + K, b + 2 * K, b + 3 * K, K, c + j);
+            }
+            for (; j < N; ++j) c[j] = dot1(a, B + static_cast<int64_t>(j) * K, K);
+            for (j = 0; j < N; ++j) {
+                c[j] += -a_zp * b_colsum[j] - b_zp[j] * a_rowsum + K * a_zp * b_zp[j];
+            }
+        }
+    });
+}
+
+} // namespace quant
@@ -0,0 +1,185 @@
+#include "../../include/quant/Quantize.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace quant {
+
+namespace {
+
+constexpr int kQMin = -128;
+constexpr int kQMax = 127;
+
+bool isSymmetric(QScheme s) { return s == QScheme::PerTensorSymmetric || s == QScheme::PerChannelSymmetric; }
+bool isPerChannel(QScheme s) { return s == QScheme::PerChannelSymmetric || s == QScheme::PerChannelAffine; }
+
+// Views t as [outer, channels, inner] around `axis` and calls fn(channel, value) for every element.
+template <typename F>
+void forEachChannel(const std::vector<int>& shape, int axis, const double* data, F fn) {
+    int outer = 1, inner = 1;
+    for (int d = 0; d < axis; ++d) outer *= shape[d];
+    for (size_t d = axis + 1; d < shape.size(); ++d) inner *= shape[d];
+    int channels = shape[axis];
+    for (int o = 0; o < outer; ++o) {
+        for (int c = 0; c < channels; ++c) {
+            const double* p = data + (static_cast<size_t>(o) * channels + c) * inner;
+            for (int i = 0; i < inner; ++i) fn(c, p[i]);
+        }
+    }
+}
+
+int checkedAxis(int axis, int rank) {
+    if (axis < 0 || axis >= rank) {
+        throw std::invalid_argument("Quantization axis " + std::to_string(axis) + " out of range for rank " +
+                                    std::to_string(rank));
+    }
+    return axis;
+}
+
+inline int8_t quantizeValue(double v, double inv_scale, int32_t zp) {
+    long q = std::lround(v * inv_scale) + zp;
+    return static_cast<int8_t>(std::min<long>(kQMax, std::max<long>(kQMin, q)));
+}
+
+} // namespace
+
+// ==========================================
+// Parameter Selection
+// ==========================================
+
+QParams chooseParams(double min_val, double max_val, bool symmetric) {
+    if (min_val > max_val) throw std::invalid_argument("chooseParams: min > max!");
+    min_val = std::min(min_val, 0.0);
+    max_val = std::max(max_val, 0.0);
+
+    QParams p;
+    if (symmetric) {
+        double amax = std::max(-min_val, max_val);
+        p.scale.push_back(amax > 0.0 ? amax / kQMax : 1.0);
+        p.zero_point.push_back(0);
+        return p;
+    }
+    double scale = (max_val - min_val) / (kQMax - kQMin);
+    if (scale <= 0.0) scale = 1.0;
+    // Zero must be exactly representable so zero padding and ReLU outputs round-trip.
+    long zp = std::lround(kQMin - min_val / scale);
+    p.scale.push_back(scale);
+    p.zero_point.push_back(static_cast<int32_t>(std::min<long>(kQMax, std::max<long>(kQMin, zp))));
+    return p;
+}
+
+// ==========================================
+// Observer
+// ==========================================
+
+Observer::Observer(QScheme scheme, int axis) : scheme(scheme), axis(axis) {
+    if (isPerChannel(scheme) && axis < 0) throw std::invalid_argument("Per-channel Observer needs an axis!");
+}
+
+void Observer::observe(const Tensor& t) {
+    const auto& data = t.getData();
+    if (data.empty()) return;
+    auto shape = t.getShape();
+
+    if (!isPerChannel(scheme)) {
+        auto mm = std::minmax_element(data.begin(), data.end());
+        if (mins.empty()) {
+            mins.push_back(*mm.first);
+            maxs.push_back(*mm.second);
+        } else {
+            mins[0] = std::min(mins[0], *mm.first);
+            maxs[0] = std::max(maxs[0], *mm.second);
+        }
+        return;
+    }
+
+    int ax = checkedAxis(axis, static_cast<int>(shape.size()));
+    if (mins.empty()) {
+        mins.assign(shape[ax], std::numeric_limits<double>::infinity());
+        maxs.assign(shape[ax], -std::numeric_limits<double>::infinity());
+    } else if (static_cast<int>(mins.size()) != shape[ax]) {
+        throw std::invalid_argument("Observer: channel count changed between observations!");
+    }
+    forEachChannel(shape, ax, data.data(), [&](int c, double v) {
+        mins[c] = std::min(mins[c], v);
+        maxs[c] = std::max(maxs[c], v);
+    });
+}
+
+QParams Observer::calculate() const {
+    if (mins.empty()) throw std::runtime_error("Observer::calculate called before observe!");
+    QParams out;
+    out.axis = isPerChannel(scheme) ? axis : -1;
+    for (size_t c = 0; c < mins.size(); ++c) {
+        QParams p = chooseParams(mins[c], maxs[c], isSymmetric(scheme));
+        out.scale.push_back(p.scale[0]);
+        out.zero_point.push_back(p.zero_point[0]);
+    }
+    return out;
+}
+
+void Observer::reset() {
+    mins.clear();
+    maxs.clear();
+}
+
+QParams calibrate(const Tensor& t, QScheme scheme, int axis) {
+    Observer obs(scheme, axis);
+    obs.observe(t);
+    return obs.calculate();
+}
+
+// ==========================================
+// Quantize / Dequantize
+// ==========================================
+
+QTensor quantize(const Tensor& t, const QParams& params) {
+    if (params.scale.empty() || params.scale.size() != params.zero_point.size()) {
+        throw std::invalid_argument("quantize: malformed QParams!");
+    }
+    QTensor q;
+    q.shape = t.getShape();
+    q.params = params;
+    const auto& data = t.getData();
+    q.data.resize(data.size());
+
+    if (!params.perChannel()) {
+        double inv = 1.0 / params.scale[0];
+        int32_t zp = params.zero_point[0];
+        for (size_t i = 0; i < data.size(); ++i) q.data[i] = quantizeValue(data[i], inv, zp);
+        return q;
+    }
+
+    int ax = checkedAxis(params.axis, static_cast<int>(q.shape.size()));
+    if (q.shape[ax] != params.channels()) throw std::invalid_argument("quantize: channel count mismatch!");
+    std::vector<double> inv(params.scale.size());
+    for (size_t c = 0; c < inv.size(); ++c) inv[c] = 1.0 / params.scale[c];
+    size_t i = 0;
+    forEachChannel(q.shape, ax, data.data(), [&](int c, double v) {
+        q.data[i++] = quantizeValue(v, inv[c], params.zero_point[c]);
+    });
+    return q;
+}
+
+Tensor dequantize(const QTensor& q) {
+    Tensor out(q.shape);
+    auto& data = out.getMutableData();
+    const auto& p = q.params;
+
+    if (!p.perChannel()) {
+        for (size_t i = 0; i < q.data.size(); ++i) data[i] = p.scale[0] * (q.data[i] - p.zero_point[0]);
+        return out;
+    }
+
+    // forEachChannel walks the buffer in order, so a running index lines up with it.
+    size_t i = 0;
+    forEachChannel(q.shape, p.axis, data.data(), [&](int c, double) {
+        data[i] = p.scale[c] * (q.data[i] - p.zero_point[c]);
+        ++i;
+    });
+    return out;
+}
+
+} // namespace quant
@@ -0,0 +1,149 @@
+#include "../../include/quant/QuantizedLinear.hpp"
+#include "../../include/quant/QGemm.hpp"
+#include "../../include/utils/Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace quant {
+
+namespace {
+
+std::string describe(const std::vector<int>& shape) {
+    std::string s = "[";
+    for (size_t i = 0; i < shape.size(); ++i) {
+        if (i) s += "x";
+        s += std::to_string(shape[i]);
+    }
+    return s + "]";
+}
+
+} // namespace
+
+// ==========================================
+// Construction
+// ==========================================
+
+QuantizedLinear::QuantizedLinear(const Tensor& weight, const Tensor& b, const QParams& in_params, Activation act,
+                                 QScheme weight_scheme)
+    : act(act), input_params(in_params) {
+    auto shape = weight.getShape();
+    if (shape.size() != 2) throw std::invalid_argument("QuantizedLinear requires a 2D weight [in, out]!");
+    if (in_params.perChannel() || in_params.scale.size() != 1) {
+        throw std::invalid_argument("QuantizedLinear input params must be per-tensor!");
+    }
+    in_features = shape[0];
+    out_features = shape[1];
+
+    if (!b.isEmpty()) {
+        if (b.size() != out_features) throw std::invalid_argument("QuantizedLinear bias size mismatch!");
+        bias = b.getData();
+    } else {
+        bias.assign(out_features, 0.0);
+    }
+
+    bool per_channel = weight_scheme == QScheme::PerChannelSymmetric || weight_scheme == QScheme::PerChannelAffine;
+    weight_params = calibrate(weight, weight_scheme, per_channel ? 1 : -1);
+    QTensor qw = quantize(weight, weight_params);
+
+    // Pack [in, out] -> [out, in] so the GEMM reads both operands along `in`.
+    weight_packed.resize(qw.data.size());
+    weight_zp.assign(out_features, 0);
+    weight_colsum.assign(out_features, 0);
+    for (int j = 0; j < out_features; ++j) {
+        weight_zp[j] = weight_params.zero_point[per_channel ? j : 0];
+        for (int k = 0; k < in_features; ++k) {
+            int8_t v = qw.data[static_cast<size_t>(k) * out_features + j];
+            weight_packed[static_cast<size_t>(j) * in_features + k] = v;
+            weight_colsum[j] += v;
+        }
+    }
+}
+
+double QuantizedLinear::weightScale(int j) const {
+    return weight_params.perChannel() ? weight_params.scale[j] : weight_params.scale[0];
+}
+
+QTensor QuantizedLinear::quantizeInput(const Tensor& x) const { return quantize(x, input_params); }
+
+// ==========================================
+// Forward
+// ==========================================
+
+std::vector<int32_t> QuantizedLinear::accumulate(const QTensor& x, int& rows) const {
+    if (x.shape.size() != 2 || x.shape[1] != in_features) {
+        throw std::invalid_argument("QuantizedLinear expects input [batch, " + std::to_string(in_features) + "], got " +
+                                    describe(x.shape));
+    }
+    if (x.params.perChannel() || x.params.scale.empty()) {
+        throw std::invalid_argument("QuantizedLinear input must be quantized per-tensor!");
+    }
+    rows = x.shape[0];
+    std::vector<int32_t> acc(static_cast<size_t>(rows) * out_features);
+    gemm_s8s8s32(rows, out_features, in_features, x.data.data(), x.params.zero_point[0], weight_packed.data(),
+                 weight_zp.data(), weight_colsum.data(), acc.data());
+    return acc;
+}
+
+Tensor QuantizedLinear::forward(const Tensor& x) const {
+    return forward(quantizeInput(x));
+}
+
+Tensor QuantizedLinear::forward(const QTensor& x) const {
+    profiler::OpScope prof("qlinear", profiler::Pass::Forward, profiler::enabled() ? describe(x.shape) : std::string());
+    int rows = 0;
+    std::vector<int32_t> acc = accumulate(x, rows);
+
+    // Dequantize epilogue: y = sx * sw[j] * acc + b[j], then activation.
+    std::vector<double> mult(out_features);
+    for (int j = 0; j < out_features; ++j) mult[j] = x.params.scale[0] * weightScale(j);
+
+    Tensor out({rows, out_features});
+    auto O = out.accessor<2>();
+    for (int i = 0; i < rows; ++i) {
+        double* orow = O.row(i);
+        const int32_t* arow = acc.data() + static_cast<size_t>(i) * out_features;
+        for (int j = 0; j < out_features; ++j) {
+            double v = mult[j] * arow[j] + bias[j];
+            orow[j] = (act == Activation::ReLU && v < 0.0) ? 0.0 : v;
+        }
+    }
+    return out;
+}
+
+QTensor QuantizedLinear::forwardQuantized(const QTensor& x, const QParams& output_params) const {
+    profiler::OpScope prof("qlinear", profiler::Pass::Forward, profiler::enabled() ? describe(x.shape) : std::string());
+    if (output_params.perChannel() || output_params.scale.size() != 1) {
+        throw std::invalid_argument("QuantizedLinear output params must be per-tensor!");
+    }
+    int rows = 0;
+    std::vector<int32_t> acc = accumulate(x, rows);
+
+    // Requantize epilogue: q = round((sx * sw[j] * acc + b[j]) / so) + zo, clamped.
+    // ReLU is a clamp at the output zero point.
+    double inv_out = 1.0 / output_params.scale[0];
+    int32_t zo = output_params.zero_point[0];
+    std::vector<double> mult(out_features), offset(out_features);
+    for (int j = 0; j < out_features; ++j) {
+        mult[j] = x.params.scale[0] * weightScale(j) * inv_out;
+        offset[j] = bias[j] * inv_out;
+    }
+    long lo = act == Activation::ReLU ? std::max<long>(-128, zo) : -128;
+
+    QTensor out;
+    out.shape = {rows, out_features};
+    out.params = output_params;
+    out.data.resize(acc.size());
+    for (int i = 0; i < rows; ++i) {
+        const int32_t* arow = acc.data() + static_cast<size_t>(i) * out_features;
+        int8_t* orow = out.data.data() + static_cast<size_t>(i) * out_features;
+        for (int j = 0; j < out_features; ++j) {
+            long q = std::lround(mult[j] * arow[j] + offset[j]) + zo;
+            orow[j] = static_cast<int8_t>(std::min<long>(127, std::max<long>(lo, q)));
+        }
+    }
+    return out;
+}
+
+} // namespace quant
@@ -0,0 +1,120 @@
+#include "../../include/stream/Stream.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace stream {
+
+namespace {
+
+// pins: global synchronize() calls currently waiting on the stream, which keep it alive.
+struct Entry {
+    Stream* stream;
+    int pins;
+};
+
+std::mutex registry_mutex;
+std::condition_variable unpinned;
+std::vector<Entry> registry;
+
+std::vector<Entry>::iterator findEntry(const Stream* s) {
+    return std::find_if(registry.begin(), registry.end(), [s](const Entry& e) { return e.stream == s; });
+}
+
+} // namespace
+
+Stream::Stream() {
+    worker = std::thread(&Stream::workerLoop, this);
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    registry.push_back({this, 0});
+}
+
+Stream::~Stream() {
+    {
+        std::unique_lock<std::mutex> lock(registry_mutex);
+        unpinned.wait(lock, [&] { return findEntry(this)->pins == 0; });
+        registry.erase(findEntry(this));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        shutdown = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void Stream::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return shutdown || !queue.empty(); });
+            if (queue.empty()) return;   // shutdown with nothing left to run
+            task = std::move(queue.front());
+            queue.pop_front();
+            busy = true;
+        }
+        task();
+        task = nullptr;   // drop captured tensors before reporting idle
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy = false;
+            if (queue.empty()) idle.notify_all();
+        }
+    }
+}
+
+void Stream::push(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(task));
+    }
+    wake.notify_one();
+}
+
+Event Stream::record() {
+    auto signal = std::make_shared<detail::Signal>();
+    push([signal] { signal->set(); });
+    return Event(signal);
+}
+
+void Stream::waitEvent(const Event& e) {
+    if (e.ready()) return;
+    push([e] { e.wait(); });
+}
+
+void Stream::synchronize() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [&] { return queue.empty() && !busy; });
+}
+
+bool Stream::query() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.empty() && !busy;
+}
+
+// Waits on the streams alive at the call, one at a time and without the registry lock,
+// so tasks (and other threads) can create and destroy streams meanwhile. The stream being
+// waited on is pinned: its destructor blocks until the wait is over.
+void synchronize() {
+    std::vector<Stream*> streams;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (const Entry& e : registry) streams.push_back(e.stream);
+    }
+    for (Stream* s : streams) {
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            auto it = findEntry(s);
+            if (it == registry.end()) continue;   // destroyed since the snapshot
+            ++it->pins;
+        }
+        s->synchronize();
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            --findEntry(s)->pins;
+        }
+        unpinned.notify_all();
+    }
+}
+
+} // namespace stream
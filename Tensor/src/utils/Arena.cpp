@@ -0,0 +1,149 @@
+#include "../../include/utils/Arena.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace arena {
+
+namespace {
+
+constexpr size_t kChunkSize = 64 * 1024;
+
+std::atomic<bool> arena_enabled{true};
+
+// live counts the blocks handed out plus one reference held by the owning thread, so the
+// chunk is empty at 1 and is freed by whoever drops the count to 0.
+struct Chunk {
+    std::atomic<size_t> live{1};
+    size_t cap = 0;
+    size_t used = 0;
+
+    char* base() { return reinterpret_cast<char*>(this + 1); }
+};
+
+void releaseChunk(Chunk* c) {
+    c->~Chunk();
+    ::operator delete(c);
+}
+
+// Sits right before every block. chunk == nullptr: the block came from operator new.
+struct alignas(std::max_align_t) Header {
+    Chunk* chunk;
+    void* raw;
+};
+
+class ThreadArena {
+private:
+    std::vector<Chunk*> chunks;
+    Chunk* current = nullptr;
+    size_t next = 0;
+
+public:
+    Stats counters{0, 0, 0, 0, 0, 0};
+
+    // Drops the owner's reference: empty chunks go now, the rest with their last block.
+    ~ThreadArena() {
+        for (Chunk* c : chunks) {
+            if (c->live.fetch_sub(1, std::memory_order_acq_rel) == 1) releaseChunk(c);
+        }
+    }
+
+    void* allocate(size_t bytes, size_t align) {
+        ++counters.allocations;
+        size_t need = bytes + sizeof(Header) + std::max(align, alignof(Header));  // worst-case padding
+        if (!arena_enabled.load(std::memory_order_relaxed)) return fromHeap(need, align);
+
+        Chunk* c = current;
+        if (c && c->used && c->live.load(std::memory_order_acquire) == 1) rewind(c);
+        if (!c || c->used + need > c->cap) c = refill(need);
+
+        char* start = c->base() + c->used + sizeof(Header);
+        char* p = alignUp(start, std::max(align, alignof(Header)));
+        c->used = static_cast<size_t>(p - c->base()) + bytes;
+        c->live.fetch_add(1, std::memory_order_relaxed);
+        Header* h = reinterpret_cast<Header*>(p) - 1;
+        h->chunk = c;
+        h->raw = nullptr;
+        return p;
+    }
+
+    Stats stats() const {
+        Stats s = counters;
+        s.chunks = chunks.size();
+        s.reserved_bytes = 0;
+        s.live = 0;
+        for (Chunk* c : chunks) {
+            s.reserved_bytes += c->cap;
+            s.live += c->live.load(std::memory_order_relaxed) - 1;
+        }
+        return s;
+    }
+
+private:
+    static char* alignUp(char* p, size_t align) {
+        auto v = reinterpret_cast<uintptr_t>(p);
+        return reinterpret_cast<char*>((v + align - 1) & ~(static_cast<uintptr_t>(align) - 1));
+    }
+
+    void rewind(Chunk* c) {
+        c->used = 0;
+        ++counters.rewinds;
+    }
+
+    // An empty chunk that fits, scanning round-robin from the last refill, else a new one.
+    Chunk* refill(size_t need) {
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            Chunk* c = chunks[(next + i) % chunks.size()];
+            if (c != current && c->cap >= need && c->live.load(std::memory_order_acquire) == 1) {
+                next = (next + i + 1) % chunks.size();
+                if (c->used) rewind(c);
+                return current = c;
+            }
+        }
+        size_t cap = std::max(kChunkSize, need);
+        void* mem = ::operator new(sizeof(Chunk) + cap);
+        ++counters.heap_allocations;
+        Chunk* c = new (mem) Chunk();
+        c->cap = cap;
+        chunks.push_back(c);
+        return current = c;
+    }
+
+    void* fromHeap(size_t need, size_t align) {
+        ++counters.heap_allocations;
+        char* raw = static_cast<char*>(::operator new(need));
+        char* p = alignUp(raw + sizeof(Header), std::max(align, alignof(Header)));
+        Header* h = reinterpret_cast<Header*>(p) - 1;
+        h->chunk = nullptr;
+        h->raw = raw;
+        return p;
+    }
+};
+
+ThreadArena& threadArena() {
+    thread_local ThreadArena a;
+    return a;
+}
+
+} // namespace
+
+void* allocate(size_t bytes, size_t align) { return threadArena().allocate(bytes, align); }
+
+void deallocate(void* p) noexcept {
+    if (!p) return;
+    Header* h = static_cast<Header*>(p) - 1;
+    if (!h->chunk) {
+        ::operator delete(h->raw);
+        return;
+    }
+    Chunk* c = h->chunk;
+    if (c->live.fetch_sub(1, std::memory_order_acq_rel) == 1) releaseChunk(c);
+}
+
+void setEnabled(bool on) { arena_enabled.store(on); }
+
+bool enabled() { return arena_enabled.load(); }
+
+Stats stats() { return threadArena().stats(); }
+
+} // namespace arena
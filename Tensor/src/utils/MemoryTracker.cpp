@@ -0,0 +1,227 @@
+#include "../../include/utils/MemoryTracker.hpp"
+#include "../../include/utils/Profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <unordered_set>
+
+namespace memory {
+
+namespace {
+
+std::atomic<size_t> live_bytes[NumCategories];
+std::atomic<size_t> peak_bytes[NumCategories];
+std::atomic<size_t> live_total{0};
+std::atomic<size_t> peak_total{0};
+
+std::mutex registry_mutex;
+std::unordered_set<const TensorImpl*> registry;
+std::map<std::string, OpMemory> per_op;
+
+const char* const kUserOp = "(user)";
+
+void raisePeak(std::atomic<size_t>& peak, size_t value) {
+    size_t cur = peak.load(std::memory_order_relaxed);
+    while (value > cur && !peak.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+}
+
+void add(Category c, size_t bytes) {
+    if (bytes == 0) return;
+    raisePeak(peak_bytes[c], live_bytes[c].fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    raisePeak(peak_total, live_total.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+}
+
+void sub(Category c, size_t bytes) {
+    if (bytes == 0) return;
+    live_bytes[c].fetch_sub(bytes, std::memory_order_relaxed);
+    live_total.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+size_t dataBytes(const TensorImpl& impl) {
+    return static_cast<size_t>(impl.total_size) * dtypeSize(impl.dtype);
+}
+
+// Gradients are always float64; releaseGrad can drop the buffer.
+size_t gradBytes(const TensorImpl& impl) {
+    return impl.grad.size() * sizeof(double);
+}
+
+// Caller holds registry_mutex.
+void opAdd(const char* op, size_t bytes, bool new_tensor) {
+    auto& m = per_op[op];
+    if (m.op.empty()) m.op = op;
+    m.live_bytes += bytes;
+    m.allocated_bytes += bytes;
+    m.peak_bytes = std::max(m.peak_bytes, m.live_bytes);
+    if (new_tensor) m.tensors += 1;
+}
+
+void opSub(const char* op, size_t bytes) {
+    auto it = per_op.find(op);
+    if (it != per_op.end()) it->second.live_bytes -= std::min(bytes, it->second.live_bytes);
+}
+
+} // namespace
+
+// ==========================================
+// Counters
+// ==========================================
+
+Stats stats() {
+    Stats s{};
+    for (int c = 0; c < NumCategories; ++c) {
+        s.live[c] = live_bytes[c].load(std::memory_order_relaxed);
+        s.peak[c] = peak_bytes[c].load(std::memory_order_relaxed);
+    }
+    s.live_total = live_total.load(std::memory_order_relaxed);
+    s.peak_total = peak_total.load(std::memory_order_relaxed);
+    return s;
+}
+
+void resetPeak() {
+    for (int c = 0; c < NumCategories; ++c) {
+        peak_bytes[c].store(live_bytes[c].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    peak_total.store(live_total.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto& kv : per_op) kv.second.peak_bytes = kv.second.live_bytes;
+}
+
+// ==========================================
+// Tracking Control
+// ==========================================
+
+void enableTracking() { profiler::detail::setFlag(profiler::detail::MemoryTracking, true); }
+void disableTracking() { profiler::detail::setFlag(profiler::detail::MemoryTracking, false); }
+
+bool trackingEnabled() {
+    return (profiler::detail::active_flags.load(std::memory_order_relaxed) & profiler::detail::MemoryTracking) != 0;
+}
+
+// ==========================================
+// Hooks
+// ==========================================
+
+void onAllocate(TensorImpl& impl) {
+    size_t data = dataBytes(impl), grad = gradBytes(impl);
+    add(Data, data);
+    add(Grad, grad);
+    profiler::detail::allocated_bytes += static_cast<long long>(data + grad);
+
+    if (!trackingEnabled()) return;
+    profiler::OpScope* scope = profiler::OpScope::current();
+    impl.creator_op = scope ? scope->opName() : kUserOp;
+    impl.tracked = true;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    registry.insert(&impl);
+    opAdd(impl.creator_op, data + grad, true);
+}
+
+void onFree(TensorImpl& impl) {
+    size_t data = dataBytes(impl), grad = gradBytes(impl);
+    sub(Data, data);
+    sub(Grad, grad);
+    sub(Graph, impl.graph_bytes);
+
+    if (!impl.tracked) return;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    registry.erase(&impl);
+    opSub(impl.creator_op, data + grad + impl.graph_bytes);
+}
+
+void onGraphAttach(TensorImpl& impl, size_t bytes) {
+    impl.graph_bytes += bytes;
+    add(Graph, bytes);
+    if (!impl.tracked) return;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    opAdd(impl.creator_op, bytes, false);
+}
+
+void onGraphRelease(TensorImpl& impl) {
+    sub(Graph, impl.graph_bytes);
+    if (impl.tracked) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        opSub(impl.creator_op, impl.graph_bytes);
+    }
+    impl.graph_bytes = 0;
+}
+
+void onGradRelease(TensorImpl& impl) {
+    size_t grad = gradBytes(impl);
+    sub(Grad, grad);
+    if (impl.tracked) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        opSub(impl.creator_op, grad);
+    }
+}
+
+void onGradAllocate(TensorImpl& impl) {
+    size_t grad = gradBytes(impl);
+    add(Grad, grad);
+    profiler::detail::allocated_bytes += static_cast<long long>(grad);
+    if (!impl.tracked) return;
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    opAdd(impl.creator_op, grad, false);
+}
+
+// ==========================================
+// Reports
+// ==========================================
+
+std::vector<OpMemory> byOp() {
+    std::vector<OpMemory> out;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (const auto& kv : per_op) out.push_back(kv.second);
+    }
+    std::sort(out.begin(), out.end(), [](const OpMemory& a, const OpMemory& b) { return a.live_bytes > b.live_bytes; });
+    return out;
+}
+
+std::vector<LiveTensor> snapshot(size_t top) {
+    std::vector<LiveTensor> out;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        out.reserve(registry.size());
+        for (const TensorImpl* impl : registry) {
+            out.push_back({impl->creator_op, impl->shape, dataBytes(*impl), gradBytes(*impl), impl->graph_bytes,
+                           impl->requires_grad, static_cast<bool>(impl->backward_fn)});
+        }
+    }
+    std::sort(out.begin(), out.end(), [](const LiveTensor& a, const LiveTensor& b) { return a.totalBytes() > b.totalBytes(); });
+    if (top > 0 && out.size() > top) out.resize(top);
+    return out;
+}
+
+void printReport(std::ostream& os, size_t top) {
+    static const char* names[NumCategories] = {"data", "grad", "graph"};
+    Stats s = stats();
+    os << "Tensor memory (live / peak bytes)\n";
+    for (int c = 0; c < NumCategories; ++c) {
+        os << "  " << std::left << std::setw(8) << names[c] << std::right << std::setw(14) << s.live[c]
+           << std::setw(14) << s.peak[c] << "\n";
+    }
+    os << "  " << std::left << std::setw(8) << "total" << std::right << std::setw(14) << s.live_total
+       << std::setw(14) << s.peak_total << "\n";
+
+    auto ops_seen = byOp();
+    if (ops_seen.empty()) return;
+
+    os << "\nLive bytes by creating op\n";
+    for (const auto& m : ops_seen) {
+        os << "  " << std::left << std::setw(12) << m.op << std::right << std::setw(14) << m.live_bytes
+           << " live" << std::setw(14) << m.peak_bytes << " peak" << std::setw(8) << m.tensors << " tensors\n";
+    }
+
+    os << "\nLargest live tensors\n";
+    for (const auto& t : snapshot(top)) {
+        os << "  " << std::left << std::setw(12) << t.op << "[";
+        for (size_t i = 0; i < t.shape.size(); ++i) os << (i ? "x" : "") << t.shape[i];
+        os << "]" << std::right << std::setw(14) << t.totalBytes() << " bytes"
+           << (t.has_backward ? "  (graph node)" : "") << "\n";
+    }
+}
+
+} // namespace memory
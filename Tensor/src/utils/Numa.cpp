@@ -0,0 +1,159 @@
+#include "../../include/utils/Numa.hpp"
+#include "../../include/utils/Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace numa {
+
+namespace {
+
+// "0-3,8-11" -> {0, 1, 2, 3, 8, 9, 10, 11}
+std::vector<int> parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ss(text);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        if (range.find_first_of("0123456789") == std::string::npos) continue;
+        size_t dash = range.find('-');
+        int lo = std::stoi(range.substr(0, dash));
+        int hi = dash == std::string::npos ? lo : std::stoi(range.substr(dash + 1));
+        for (int c = lo; c <= hi; ++c) cpus.push_back(c);
+    }
+    return cpus;
+}
+
+Topology detect() {
+    Topology t;
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    std::vector<int> node_ids;
+    if (DIR* dir = opendir("/sys/devices/system/node")) {
+        while (dirent* entry = readdir(dir)) {
+            const char* name = entry->d_name;
+            if (std::strncmp(name, "node", 4) == 0 && name[4] >= '0' && name[4] <= '9') node_ids.push_back(std::atoi(name + 4));
+        }
+        closedir(dir);
+    }
+    std::sort(node_ids.begin(), node_ids.end());
+    for (int id : node_ids) {
+        std::ifstream in("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist");
+        std::string line;
+        if (!std::getline(in, line)) continue;
+        std::vector<int> cpus;
+        for (int c : parseCpuList(line)) {
+            if (!have_mask || (c < CPU_SETSIZE && CPU_ISSET(c, &allowed))) cpus.push_back(c);
+        }
+        if (!cpus.empty()) t.node_cpus.push_back(std::move(cpus));
+    }
+#endif
+    if (t.node_cpus.empty()) {
+        unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+        t.node_cpus.emplace_back();
+        for (unsigned c = 0; c < hw; ++c) t.node_cpus[0].push_back(static_cast<int>(c));
+    }
+    for (const auto& cpus : t.node_cpus) t.cpu_order.insert(t.cpu_order.end(), cpus.begin(), cpus.end());
+    return t;
+}
+
+bool defaultEnabled() {
+    if (const char* env = std::getenv("TENSOR_NUMA")) return std::atoi(env) != 0;
+    return numNodes() > 1;
+}
+
+std::atomic<bool>& enabledFlag() {
+    static std::atomic<bool> flag{defaultEnabled()};
+    return flag;
+}
+
+#ifdef __linux__
+// Pins the calling thread to cpu (if cpu >= 0) and restores its previous CPU mask on exit.
+class ScopedPin {
+private:
+    cpu_set_t saved;
+    bool active = false;
+
+public:
+    explicit ScopedPin(int cpu) {
+        active = cpu >= 0 && pthread_getaffinity_np(pthread_self(), sizeof(saved), &saved) == 0 &&
+                 pinCurrentThread(cpu);
+    }
+    ~ScopedPin() {
+        if (active) pthread_setaffinity_np(pthread_self(), sizeof(saved), &saved);
+    }
+
+    ScopedPin(const ScopedPin&) = delete;
+    ScopedPin& operator=(const ScopedPin&) = delete;
+};
+#endif
+
+} // namespace
+
+const Topology& topology() {
+    static const Topology t = detect();
+    return t;
+}
+
+int numNodes() { return static_cast<int>(topology().node_cpus.size()); }
+
+void setEnabled(bool on) { enabledFlag().store(on); }
+
+bool enabled() { return enabledFlag().load(); }
+
+// Chunks fill the CPUs node by node, so a node's chunks are contiguous in the range.
+int cpuForChunk(int chunk) {
+    const auto& order = topology().cpu_order;
+    return order[static_cast<size_t>(chunk) % order.size()];
+}
+
+bool pinCurrentThread(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+bool shouldPlace(size_t elements) { return enabled() && elements * sizeof(double) >= kFirstTouchBytes; }
+
+void firstTouch(double* p, size_t n, const double* src) {
+#ifdef __linux__
+    // Private anonymous pages read back as zero after MADV_DONTNEED and are allocated
+    // again on the next write, by whichever thread makes it.
+    auto page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t lo = (reinterpret_cast<uintptr_t>(p) + page - 1) & ~(page - 1);
+    uintptr_t hi = reinterpret_cast<uintptr_t>(p + n) & ~(page - 1);
+    if (hi > lo) madvise(reinterpret_cast<void*>(lo), hi - lo, MADV_DONTNEED);
+    // parallel_for runs chunk 0 on the caller, so the caller touches from cpuForChunk(0).
+    // Inside a parallel region the whole range runs here and the current placement stands.
+    ScopedPin pin(parallel::in_parallel_region() ? -1 : cpuForChunk(0));
+#endif
+    // One page of doubles per grain, so a large buffer splits over every thread.
+    parallel::parallel_for(0, static_cast<int64_t>(n), 512, [&](int64_t b, int64_t e) {
+        if (src) std::memcpy(p + b, src + b, static_cast<size_t>(e - b) * sizeof(double));
+        else std::memset(p + b, 0, static_cast<size_t>(e - b) * sizeof(double));
+    });
+}
+
+} // namespace numa
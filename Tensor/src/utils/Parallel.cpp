@@ -0,0 +1,157 @@
+#include "../../include/utils/Parallel.hpp"
+#include "../../include/utils/Numa.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallel {
+
+namespace {
+
+thread_local bool in_region = false;
+
+int defaultThreads() {
+    if (const char* env = std::getenv("TENSOR_NUM_THREADS")) {
+        int n = std::atoi(env);
+        if (n > 0) return n;
+    }
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw ? static_cast<int>(hw) : 1;
+}
+
+class Pool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    uint64_t generation = 0;
+    bool shutdown = false;
+
+    // Current job
+    const std::function<void(int64_t, int64_t)>* fn = nullptr;
+    int64_t begin = 0, end = 0;
+    int chunks = 0;
+    int pending = 0;
+    std::exception_ptr error;
+
+    void runChunk(int c) {
+        int64_t len = end - begin;
+        int64_t lo = begin + len * c / chunks;
+        int64_t hi = begin + len * (c + 1) / chunks;
+        try {
+            if (lo < hi) (*fn)(lo, hi);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+        }
+    }
+
+    void workerLoop(int id, bool pin) {
+        if (pin) numa::pinCurrentThread(numa::cpuForChunk(id + 1));
+        in_region = true;
+        uint64_t seen = 0;
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return shutdown || generation != seen; });
+            if (shutdown) return;
+            seen = generation;
+            // Worker `id` owns chunk id + 1; the caller runs chunk 0.
+            if (id + 1 >= chunks) continue;
+            lock.unlock();
+            runChunk(id + 1);
+            lock.lock();
+            if (--pending == 0) done.notify_one();
+        }
+    }
+
+public:
+    std::mutex run_mutex;
+
+    explicit Pool(int threads) {
+        bool pin = numa::enabled();
+        for (int i = 0; i + 1 < threads; ++i) workers.emplace_back(&Pool::workerLoop, this, i, pin);
+    }
+
+    ~Pool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            shutdown = true;
+        }
+        wake.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    void run(int64_t b, int64_t e, int n_chunks, const std::function<void(int64_t, int64_t)>& f) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            fn = &f;
+            begin = b;
+            end = e;
+            chunks = n_chunks;
+            pending = n_chunks - 1;
+            error = nullptr;
+            ++generation;
+        }
+        wake.notify_all();
+
+        in_region = true;
+        runChunk(0);
+        in_region = false;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return pending == 0; });
+        fn = nullptr;
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+std::mutex config_mutex;
+int num_threads = defaultThreads();
+std::shared_ptr<Pool> pool;
+
+std::shared_ptr<Pool> getPool() {
+    std::lock_guard<std::mutex> lock(config_mutex);
+    if (!pool || pool->size() != num_threads) pool = std::make_shared<Pool>(num_threads);
+    return pool;
+}
+
+} // namespace
+
+void set_num_threads(int n) {
+    std::lock_guard<std::mutex> lock(config_mutex);
+    num_threads = std::max(1, n);
+}
+
+int get_num_threads() {
+    std::lock_guard<std::mutex> lock(config_mutex);
+    return num_threads;
+}
+
+bool in_parallel_region() { return in_region; }
+
+void parallel_for(int64_t begin, int64_t end, int64_t grain,
+                  const std::function<void(int64_t, int64_t)>& fn) {
+    if (begin >= end) return;
+    int64_t len = end - begin;
+    grain = std::max<int64_t>(grain, 1);
+    int threads = in_region ? 1 : get_num_threads();
+    int chunks = static_cast<int>(std::min<int64_t>(threads, (len + grain - 1) / grain));
+    if (chunks <= 1) {
+        fn(begin, end);
+        return;
+    }
+    auto p = getPool();
+    // One job at a time per pool; concurrent callers from different threads queue here.
+    std::lock_guard<std::mutex> lock(p->run_mutex);
+    p->run(begin, end, std::min(chunks, p->size()), fn);
+}
+
+} // namespace parallel
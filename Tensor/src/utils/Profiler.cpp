@@ -0,0 +1,205 @@
+#include "../../include/utils/Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace profiler {
+
+namespace {
+
+struct Event {
+    const char* name;
+    Pass pass;
+    std::string shapes;
+    int64_t start_ns;
+    int64_t dur_ns;
+    int tid;
+    long long bytes;
+};
+
+std::mutex events_mutex;
+std::vector<Event> events;
+std::atomic<int> next_tid{0};
+thread_local int tid = -1;
+thread_local OpScope* current_scope = nullptr;
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+int threadId() {
+    if (tid < 0) tid = next_tid.fetch_add(1);
+    return tid;
+}
+
+const char* passName(Pass p) { return p == Pass::Forward ? "forward" : "backward"; }
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        out.push_back(c);
+    }
+    return out;
+}
+
+} // namespace
+
+namespace detail {
+
+std::atomic<unsigned> active_flags{0};
+
+void setFlag(unsigned flag, bool on) {
+    if (on) active_flags.fetch_or(flag, std::memory_order_relaxed);
+    else active_flags.fetch_and(~flag, std::memory_order_relaxed);
+}
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+std::string describeShapes(std::initializer_list<const Tensor*> inputs) {
+    std::string s;
+    for (const Tensor* t : inputs) {
+        if (!s.empty()) s += ",";
+        s += "[";
+        auto shape = t->getShape();
+        for (size_t i = 0; i < shape.size(); ++i) {
+            if (i) s += "x";
+            s += std::to_string(shape[i]);
+        }
+        s += "]";
+    }
+    return s;
+}
+
+void record(const char* name, Pass pass, const std::string& shapes, int64_t start_ns, int64_t end_ns, long long bytes) {
+    Event e{name, pass, shapes, start_ns, end_ns - start_ns, threadId(), bytes};
+    std::lock_guard<std::mutex> lock(events_mutex);
+    events.push_back(std::move(e));
+}
+
+} // namespace detail
+
+// ==========================================
+// Control
+// ==========================================
+
+void enable() { detail::setFlag(detail::Timing, true); }
+void disable() { detail::setFlag(detail::Timing, false); }
+
+void reset() {
+    std::lock_guard<std::mutex> lock(events_mutex);
+    events.clear();
+}
+
+// ==========================================
+// Scopes
+// ==========================================
+
+void OpScope::begin(const char* op, Pass p, std::initializer_list<const Tensor*> inputs) {
+    // Shape strings are only needed for timed events.
+    begin(op, p, enabled() ? detail::describeShapes(inputs) : std::string());
+}
+
+void OpScope::begin(const char* op, Pass p, const std::string& input_shapes) {
+    name = op;
+    pass = p;
+    prev = current_scope;
+    current_scope = this;
+    active = true;
+    timed = enabled();
+    if (timed) {
+        shapes = input_shapes;
+        start_bytes = detail::allocated_bytes;
+        start_ns = detail::nowNs();
+    }
+}
+
+void OpScope::end() {
+    current_scope = prev;
+    if (timed) {
+        int64_t end_ns = detail::nowNs();
+        detail::record(name, pass, shapes, start_ns, end_ns, detail::allocated_bytes - start_bytes);
+    }
+}
+
+OpScope* OpScope::current() { return current_scope; }
+
+std::function<void()> instrumentBackward(std::function<void()> bwd) {
+    OpScope* scope = OpScope::current();
+    if (!scope) return bwd;
+    const char* name = scope->opName();
+    std::string shapes = scope->inputShapes();
+    return [name, shapes, bwd]() {
+        OpScope timer(name, Pass::Backward, shapes);
+        bwd();
+    };
+}
+
+// ==========================================
+// Reporting
+// ==========================================
+
+std::vector<OpStats> summary() {
+    std::map<std::tuple<std::string, int, std::string>, OpStats> agg;
+    {
+        std::lock_guard<std::mutex> lock(events_mutex);
+        for (const auto& e : events) {
+            auto key = std::make_tuple(std::string(e.name), static_cast<int>(e.pass), e.shapes);
+            double us = e.dur_ns * 1e-3;
+            auto it = agg.find(key);
+            if (it == agg.end()) {
+                agg.emplace(key, OpStats{e.name, e.pass, e.shapes, 1, us, us, us, e.bytes});
+            } else {
+                auto& s = it->second;
+                s.calls += 1;
+                s.total_us += us;
+                s.min_us = std::min(s.min_us, us);
+                s.max_us = std::max(s.max_us, us);
+                s.bytes += e.bytes;
+            }
+        }
+    }
+    std::vector<OpStats> out;
+    for (auto& kv : agg) out.push_back(kv.second);
+    std::sort(out.begin(), out.end(), [](const OpStats& a, const OpStats& b) { return a.total_us > b.total_us; });
+    return out;
+}
+
+void printSummary(std::ostream& os, size_t top) {
+    auto stats = summary();
+    os << std::left << std::setw(14) << "op" << std::setw(10) << "pass" << std::setw(24) << "input shapes"
+       << std::right << std::setw(8) << "calls" << std::setw(14) << "total (us)" << std::setw(12) << "mean (us)"
+       << std::setw(14) << "bytes alloc" << "\n";
+    for (size_t i = 0; i < stats.size() && i < top; ++i) {
+        const auto& s = stats[i];
+        os << std::left << std::setw(14) << s.name << std::setw(10) << passName(s.pass) << std::setw(24) << s.shapes
+           << std::right << std::setw(8) << s.calls << std::fixed << std::setprecision(1) << std::setw(14)
+           << s.total_us << std::setw(12) << s.total_us / s.calls << std::setw(14) << s.bytes << "\n";
+    }
+    os.unsetf(std::ios::fixed);
+}
+
+void exportChromeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) throw std::runtime_error("Cannot open trace file: " + path);
+
+    std::lock_guard<std::mutex> lock(events_mutex);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    out << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < events.size(); ++i) {
+        const auto& e = events[i];
+        out << "  {\"name\": \"" << jsonEscape(e.name) << "\", \"cat\": \"" << passName(e.pass)
+            << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << e.tid << ", \"ts\": " << e.start_ns * 1e-3
+            << ", \"dur\": " << e.dur_ns * 1e-3 << ", \"args\": {\"shapes\": \"" << jsonEscape(e.shapes)
+            << "\", \"bytes\": " << e.bytes << "}}" << (i + 1 < events.size() ? "," : "") << "\n";
+    }
+    out << "]}\n";
+}
+
+} // namespace profiler
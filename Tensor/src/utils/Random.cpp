@@ -0,0 +1,129 @@
+#include "../../include/utils/Random.hpp"
+#include "../../include/utils/Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace rng {
+
+namespace {
+
+constexpr uint32_t kM0 = 0xD2511F53u, kM1 = 0xCD9E8D57u;
+constexpr uint32_t kW0 = 0x9E3779B9u, kW1 = 0xBB67AE85u;
+constexpr int64_t kGrainBatches = 512;
+
+// Runs emit(first_value, r) for every batch of kLanes blocks covering n values at
+// `per_block` values per block. Batches are independent, so any split works.
+template <typename Emit>
+void forEachBatch(PhiloxState at, int64_t n, int per_block, Emit emit) {
+    int64_t per_batch = static_cast<int64_t>(per_block) * kLanes;
+    int64_t batches = (n + per_batch - 1) / per_batch;
+    parallel::parallel_for(0, batches, kGrainBatches, [&](int64_t lo, int64_t hi) {
+        uint32_t r[4][kLanes];
+        for (int64_t b = lo; b < hi; ++b) {
+            philoxBatch(at.seed, at.offset + static_cast<uint64_t>(b) * kLanes, r);
+            emit(b * per_batch, r);
+        }
+    });
+}
+
+uint64_t blocksFor(int64_t n, int per_block) {
+    int64_t per_batch = static_cast<int64_t>(per_block) * kLanes;
+    return static_cast<uint64_t>((n + per_batch - 1) / per_batch) * kLanes;
+}
+
+} // namespace
+
+void Generator::manualSeed(uint64_t seed) {
+    seed_.store(seed);
+    offset_.store(0);
+}
+
+void Generator::setState(PhiloxState s) {
+    seed_.store(s.seed);
+    offset_.store(s.offset);
+}
+
+PhiloxState Generator::reserve(uint64_t blocks) {
+    return {seed_.load(), offset_.fetch_add(blocks)};
+}
+
+Generator& defaultGenerator() {
+    static Generator gen;
+    return gen;
+}
+
+void manualSeed(uint64_t seed) { defaultGenerator().manualSeed(seed); }
+
+void philoxBatch(uint64_t seed, uint64_t counter, uint32_t out[4][kLanes]) {
+    uint32_t c0[kLanes], c1[kLanes], c2[kLanes], c3[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+        uint64_t c = counter + static_cast<uint64_t>(l);
+        c0[l] = static_cast<uint32_t>(c);
+        c1[l] = static_cast<uint32_t>(c >> 32);
+        c2[l] = 0;
+        c3[l] = 0;
+    }
+    uint32_t k0 = static_cast<uint32_t>(seed), k1 = static_cast<uint32_t>(seed >> 32);
+    for (int round = 0; round < 10; ++round) {
+        for (int l = 0; l < kLanes; ++l) {
+            uint64_t p0 = static_cast<uint64_t>(kM0) * c0[l];
+            uint64_t p1 = static_cast<uint64_t>(kM1) * c2[l];
+            uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+            uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+            c1[l] = static_cast<uint32_t>(p1);
+            c3[l] = static_cast<uint32_t>(p0);
+            c0[l] = n0;
+            c2[l] = n2;
+        }
+        k0 += kW0;
+        k1 += kW1;
+    }
+    for (int l = 0; l < kLanes; ++l) {
+        out[0][l] = c0[l];
+        out[1][l] = c1[l];
+        out[2][l] = c2[l];
+        out[3][l] = c3[l];
+    }
+}
+
+void uniform(double* out, int64_t n, double low, double high, Generator& gen) {
+    PhiloxState at = gen.reserve(blocksFor(n, 2));
+    double span = high - low;
+    forEachBatch(at, n, 2, [&](int64_t first, const uint32_t (*r)[kLanes]) {
+        double u[2 * kLanes];
+        for (int l = 0; l < kLanes; ++l) {
+            u[2 * l] = toUnitDouble(r[0][l], r[1][l]);
+            u[2 * l + 1] = toUnitDouble(r[2][l], r[3][l]);
+        }
+        int64_t count = std::min<int64_t>(2 * kLanes, n - first);
+        for (int64_t i = 0; i < count; ++i) out[first + i] = low + span * u[i];
+    });
+}
+
+// Box-Muller: each block's two uniforms give two normals.
+void normal(double* out, int64_t n, double mean, double stddev, Generator& gen) {
+    PhiloxState at = gen.reserve(blocksFor(n, 2));
+    const double two_pi = 6.283185307179586;
+    forEachBatch(at, n, 2, [&](int64_t first, const uint32_t (*r)[kLanes]) {
+        double z[2 * kLanes];
+        for (int l = 0; l < kLanes; ++l) {
+            double u1 = 1.0 - toUnitDouble(r[0][l], r[1][l]);   // (0, 1]: log stays finite
+            double u2 = toUnitDouble(r[2][l], r[3][l]);
+            double radius = std::sqrt(-2.0 * std::log(u1));
+            z[2 * l] = radius * std::cos(two_pi * u2);
+            z[2 * l + 1] = radius * std::sin(two_pi * u2);
+        }
+        int64_t count = std::min<int64_t>(2 * kLanes, n - first);
+        for (int64_t i = 0; i < count; ++i) out[first + i] = mean + stddev * z[i];
+    });
+}
+
+void bernoulli(double* out, int64_t n, double p, Generator& gen) {
+    PhiloxState at = gen.reserve(blocksFor(n, 4));
+    forEachBatch(at, n, 4, [&](int64_t first, const uint32_t (*r)[kLanes]) {
+        int64_t count = std::min<int64_t>(4 * kLanes, n - first);
+        for (int64_t i = 0; i < count; ++i) out[first + i] = toUnitFloat(r[i % 4][i / 4]) < p ? 1.0 : 0.0;
+    });
+}
+
+} // namespace rng
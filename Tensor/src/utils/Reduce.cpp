@@ -0,0 +1,73 @@
+#include "../../include/utils/Reduce.hpp"
+#include "../../include/utils/Parallel.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace reduce {
+
+namespace {
+
+constexpr int64_t kGrainBlocks = 4;
+
+// Sum of load(i) for i in [lo, hi): kLanes strided accumulators, then a fixed tree.
+template <typename Load>
+double blockSum(const Load& load, int64_t lo, int64_t hi) {
+    double acc[kLanes] = {};
+    int64_t i = lo;
+    for (; i + kLanes <= hi; i += kLanes) {
+        for (int l = 0; l < kLanes; ++l) acc[l] += load(i + l);
+    }
+    for (int l = 0; i < hi; ++i, ++l) acc[l] += load(i);
+    return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+}
+
+// Pairwise tree over the partials, always paired the same way.
+double treeSum(std::vector<double>& v) {
+    size_t n = v.size();
+    while (n > 1) {
+        size_t half = n / 2;
+        for (size_t i = 0; i < half; ++i) v[i] = v[2 * i] + v[2 * i + 1];
+        if (n % 2) v[half] = v[n - 1];
+        n = half + n % 2;
+    }
+    return n ? v[0] : 0.0;
+}
+
+// One partial per block of kBlock elements (block(lo, hi) sums [lo, hi)), then treeSum.
+template <typename Block>
+double reduceBlocks(int64_t n, const Block& blockRange) {
+    if (n <= kBlock) return blockRange(0, n);
+    int64_t blocks = (n + kBlock - 1) / kBlock;
+    auto block = [&](int64_t b) { return blockRange(b * kBlock, std::min(n, (b + 1) * kBlock)); };
+
+    std::vector<double> partial(blocks);
+    parallel::parallel_for(0, blocks, kGrainBlocks, [&](int64_t lo, int64_t hi) {
+        for (int64_t b = lo; b < hi; ++b) partial[b] = block(b);
+    });
+    return treeSum(partial);
+}
+
+template <typename Load>
+double reduceSum(int64_t n, const Load& load) {
+    return reduceBlocks(n, [&](int64_t lo, int64_t hi) { return blockSum(load, lo, hi); });
+}
+
+} // namespace
+
+double sum(const double* x, int64_t n) {
+    return reduceSum(n, [x](int64_t i) { return x[i]; });
+}
+
+double dot(const double* x, const double* y, int64_t n) {
+    return reduceSum(n, [x, y](int64_t i) { return x[i] * y[i]; });
+}
+
+double sum(DType dtype, const uint16_t* x, int64_t n) {
+    return reduceBlocks(n, [dtype, x](int64_t lo, int64_t hi) {
+        float wide[kBlock];
+        half::decodeRow(dtype, x + lo, wide, static_cast<size_t>(hi - lo));
+        return blockSum([&wide, lo](int64_t i) { return static_cast<double>(wide[i - lo]); }, lo, hi);
+    });
+}
+
+} // namespace reduce